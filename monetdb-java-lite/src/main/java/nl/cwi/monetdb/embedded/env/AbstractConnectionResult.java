@@ -61,6 +61,13 @@ public abstract class AbstractConnectionResult implements Closeable {
 	 */
 	protected long getRandomIdentifier() { return randomIdentifier; }
 
+	/**
+	 * Registers a result created from this one in the connection, so it gets closed with the connection.
+	 *
+	 * @param result The result to register
+	 */
+	protected void registerResult(AbstractConnectionResult result) { this.connection.addQueryResult(result); }
+
 	/**
 	 * Checks the length of an input array for metadata retrieval
 	 *
@@ -0,0 +1,224 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.env;
+
+/**
+ * The options of a {@link MonetDBEmbeddedConnection#copyInto(String, java.io.InputStream, CopyOptions)} bulk load,
+ * the same as in the SQL {@code COPY INTO} statement. The defaults are the same as well.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public final class CopyOptions {
+
+	/** The column separator */
+	private String columnSeparator = "|";
+
+	/** The record separator */
+	private String recordSeparator = "\n";
+
+	/** The quote character of strings */
+	private String quote = "\"";
+
+	/** The representation of a null value */
+	private String nullString = "null";
+
+	/** The number of records to load, -1 for all */
+	private long numberOfRecords = -1;
+
+	/** The number of records to skip at the beginning */
+	private long skipRecords = 0;
+
+	/** If the table is locked during the load */
+	private boolean locked = false;
+
+	/** If the rejected records are skipped instead of aborting the load */
+	private boolean bestEffort = false;
+
+	/** The size of the buffer to read the InputStream */
+	private int bufferSize = 65536;
+
+	/**
+	 * Gets the column separator.
+	 *
+	 * @return The column separator
+	 */
+	public String getColumnSeparator() { return this.columnSeparator; }
+
+	/**
+	 * Sets the column separator (default "|").
+	 *
+	 * @param columnSeparator The column separator
+	 * @return This instance
+	 */
+	public CopyOptions setColumnSeparator(String columnSeparator) {
+		this.columnSeparator = checkNotEmpty(columnSeparator, "column separator");
+		return this;
+	}
+
+	/**
+	 * Gets the record separator.
+	 *
+	 * @return The record separator
+	 */
+	public String getRecordSeparator() { return this.recordSeparator; }
+
+	/**
+	 * Sets the record separator (default "\n").
+	 *
+	 * @param recordSeparator The record separator
+	 * @return This instance
+	 */
+	public CopyOptions setRecordSeparator(String recordSeparator) {
+		this.recordSeparator = checkNotEmpty(recordSeparator, "record separator");
+		return this;
+	}
+
+	/**
+	 * Gets the quote character of strings.
+	 *
+	 * @return The quote character of strings
+	 */
+	public String getQuote() { return this.quote; }
+
+	/**
+	 * Sets the quote character of strings (default '"').
+	 *
+	 * @param quote The quote character
+	 * @return This instance
+	 */
+	public CopyOptions setQuote(String quote) {
+		this.quote = checkNotEmpty(quote, "quote");
+		return this;
+	}
+
+	/**
+	 * Gets the representation of a null value.
+	 *
+	 * @return The representation of a null value
+	 */
+	public String getNullString() { return this.nullString; }
+
+	/**
+	 * Sets the representation of a null value (default "null").
+	 *
+	 * @param nullString The null representation
+	 * @return This instance
+	 */
+	public CopyOptions setNullString(String nullString) {
+		if (nullString == null) {
+			throw new IllegalArgumentException("The null string cannot be null");
+		}
+		this.nullString = nullString;
+		return this;
+	}
+
+	/**
+	 * Gets the number of records to load, -1 for all.
+	 *
+	 * @return The number of records to load, -1 for all
+	 */
+	public long getNumberOfRecords() { return this.numberOfRecords; }
+
+	/**
+	 * Sets the number of records to load, or -1 to load the whole stream (default).
+	 *
+	 * @param numberOfRecords The number of records to load
+	 * @return This instance
+	 */
+	public CopyOptions setNumberOfRecords(long numberOfRecords) {
+		this.numberOfRecords = numberOfRecords < 0 ? -1 : numberOfRecords;
+		return this;
+	}
+
+	/**
+	 * Gets the number of records to skip at the beginning.
+	 *
+	 * @return The number of records to skip at the beginning
+	 */
+	public long getSkipRecords() { return this.skipRecords; }
+
+	/**
+	 * Sets the number of records to skip at the beginning of the stream, such as headers (default 0).
+	 *
+	 * @param skipRecords The number of records to skip
+	 * @return This instance
+	 */
+	public CopyOptions setSkipRecords(long skipRecords) {
+		if (skipRecords < 0) {
+			throw new IllegalArgumentException("The number of records to skip cannot be negative");
+		}
+		this.skipRecords = skipRecords;
+		return this;
+	}
+
+	/**
+	 * Tells if the table is locked during the load.
+	 *
+	 * @return If the table is locked during the load
+	 */
+	public boolean isLocked() { return this.locked; }
+
+	/**
+	 * Sets if the table is locked during the load, as in {@code COPY INTO ... LOCKED} (default false).
+	 *
+	 * @param locked If the table is locked
+	 * @return This instance
+	 */
+	public CopyOptions setLocked(boolean locked) {
+		this.locked = locked;
+		return this;
+	}
+
+	/**
+	 * Tells if the rejected records are skipped.
+	 *
+	 * @return If the rejected records are skipped
+	 */
+	public boolean isBestEffort() { return this.bestEffort; }
+
+	/**
+	 * Sets if the rejected records are skipped instead of aborting the load, as in {@code COPY INTO ... BEST EFFORT}
+	 * (default false).
+	 *
+	 * @param bestEffort If best effort is used
+	 * @return This instance
+	 */
+	public CopyOptions setBestEffort(boolean bestEffort) {
+		this.bestEffort = bestEffort;
+		return this;
+	}
+
+	/**
+	 * Gets the size of the buffer to read the InputStream.
+	 *
+	 * @return The size of the buffer to read the InputStream
+	 */
+	public int getBufferSize() { return this.bufferSize; }
+
+	/**
+	 * Sets the size of the buffer used to read the InputStream (default 64 KB).
+	 *
+	 * @param bufferSize The size of the buffer in bytes
+	 * @return This instance
+	 */
+	public CopyOptions setBufferSize(int bufferSize) {
+		if (bufferSize < 1) {
+			throw new IllegalArgumentException("The buffer size must be at least 1");
+		}
+		this.bufferSize = bufferSize;
+		return this;
+	}
+
+	private static String checkNotEmpty(String value, String what) {
+		if (value == null || value.isEmpty()) {
+			throw new IllegalArgumentException("The " + what + " cannot be empty");
+		}
+		return value;
+	}
+}
@@ -0,0 +1,20 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.env;
+
+/**
+ * The exception fired when a query is aborted, either because it exceeded the connection's query timeout or it was
+ * cancelled with {@link MonetDBEmbeddedConnection#cancel()}.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public class MonetDBEmbeddedCancelledException extends MonetDBEmbeddedException {
+
+	public MonetDBEmbeddedCancelledException(String message) { super(message); }
+}
@@ -14,9 +14,26 @@ import nl.cwi.monetdb.embedded.utils.Randomizer;
 import nl.cwi.monetdb.embedded.utils.StringEscaper;
 
 import java.io.Closeable;
+import java.io.InputStream;
+import java.lang.reflect.Array;
+import java.nio.Buffer;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.LongBuffer;
+import java.nio.ShortBuffer;
 import java.sql.SQLException;
 import java.sql.Savepoint;
+import java.util.ArrayList;
+import java.util.HashSet;
 import java.util.Hashtable;
+import java.util.List;
+import java.util.Locale;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
 
 /**
  * A single connection to a MonetDB database instance. Communication between Java and native C is done via JNI.
@@ -36,6 +53,38 @@ public class MonetDBEmbeddedConnection implements Closeable {
 	/** Hash table of query result sets. */
 	private final Hashtable<Long, AbstractConnectionResult> results = new Hashtable<>();
 
+	/** The query timeout in milliseconds, 0 if disabled. */
+	private volatile long queryTimeout;
+
+	/** If a cancel was requested, so the query timeout must be restored before the next query. */
+	private volatile boolean cancelRequested;
+
+	/** The default schema of a connection from the database's pool, restored when it returns, or null if not pooled. */
+	private String pooledSchema;
+
+	/** The cache of query plans, or null if disabled. */
+	private PlanCache planCache;
+
+	/** The columns of the registered views. */
+	private final Hashtable<String, Object[]> views = new Hashtable<>();
+
+	/** The direct buffers scanned in place by each temporary table, kept reachable until the table is dropped. */
+	private final Hashtable<String, List<Buffer>> pinnedBuffers = new Hashtable<>();
+
+	/** The temporary tables dropped inside a transaction, whose buffers stay pinned as a rollback restores them. */
+	private final Set<String> droppedTables = new HashSet<>();
+
+	/** The last asynchronous query submitted, as they run one at a time on the connection. */
+	private volatile CompletableFuture<?> lastAsyncQuery = CompletableFuture.completedFuture(null);
+
+	/** The worker thread running an asynchronous query of this connection, or null. */
+	private volatile Thread asyncRunner;
+
+	/** An asynchronous query task. */
+	private interface AsyncQuery<T> {
+		T run() throws MonetDBEmbeddedException;
+	}
+
 	protected MonetDBEmbeddedConnection(long connectionPointer) {
 		this.connectionPointer = connectionPointer;
 		this.randomIdentifier = Randomizer.generateNextResultSetId();
@@ -59,6 +108,108 @@ public class MonetDBEmbeddedConnection implements Closeable {
 		if(this.isClosed()) {
 			throw new MonetDBEmbeddedException("This connection is already closed");
 		}
+		if(Thread.currentThread() != this.asyncRunner && !this.lastAsyncQuery.isDone()) {
+			throw new MonetDBEmbeddedException("An asynchronous query is pending on this connection");
+		}
+		this.restoreQueryTimeout();
+	}
+
+	/**
+	 * Waits for the pending asynchronous queries, so the native context is not released under them.
+	 */
+	private void awaitAsyncQueries() {
+		if(Thread.currentThread() != this.asyncRunner) {
+			try {
+				this.lastAsyncQuery.handle((r, ex) -> null).join();
+			} catch (RuntimeException ignored) {}
+		}
+	}
+
+	/**
+	 * Restores the query timeout after a cancel, before a new query starts.
+	 */
+	protected void restoreQueryTimeout() {
+		if(this.cancelRequested) {
+			this.cancelRequested = false;
+			this.setQueryTimeoutInternal(this.connectionPointer, this.queryTimeout * 1000);
+		}
+	}
+
+	/**
+	 * Gets the query timeout of the connection.
+	 *
+	 * @return The query timeout in milliseconds, 0 if disabled
+	 */
+	public long getQueryTimeout() { return this.queryTimeout; }
+
+	/**
+	 * Sets the maximum time a query may run on this connection. The MAL interpreter checks it between instructions,
+	 * so an expired query aborts cooperatively, releasing its intermediates, and a
+	 * {@link MonetDBEmbeddedCancelledException} is thrown.
+	 *
+	 * @param milliseconds The query timeout in milliseconds, 0 to disable it
+	 * @throws MonetDBEmbeddedException If the connection is closed
+	 */
+	public void setQueryTimeout(long milliseconds) throws MonetDBEmbeddedException {
+		if(milliseconds < 0) {
+			throw new IllegalArgumentException("The query timeout cannot be negative");
+		}
+		this.checkConnectionIsNotClosed();
+		this.queryTimeout = milliseconds;
+		this.setQueryTimeoutInternal(this.connectionPointer, milliseconds * 1000);
+	}
+
+	/**
+	 * Cancels the query running on this connection, if any, from another thread. The query aborts at the next MAL
+	 * instruction, releasing its intermediates, and it throws a {@link MonetDBEmbeddedCancelledException}. The next
+	 * query on the connection runs normally.
+	 */
+	public void cancel() {
+		long pointer = this.connectionPointer;
+		if(pointer != 0) {
+			this.cancelRequested = true;
+			this.cancelInternal(pointer);
+		}
+	}
+
+	/**
+	 * Gets the maximum number of query plans cached by this connection.
+	 *
+	 * @return The plan cache size, 0 if disabled
+	 */
+	public int getPlanCacheSize() { return this.planCache == null ? 0 : this.planCache.getCapacity(); }
+
+	/**
+	 * Sets the maximum number of query plans cached by this connection (disabled by default). While enabled, the
+	 * queries run with {@link #executeQuery(String)} and the INSERT, UPDATE and DELETE statements run with
+	 * {@link #executeUpdate(String)} are prepared once per query text, with their comparison and VALUES/IN list
+	 * literals extracted as parameters, so repeated queries differing only in those constants reuse the same plan.
+	 * The least recently used plans are released when the cache is full, and all of them after a statement that may
+	 * change the schema.
+	 *
+	 * @param size The maximum number of cached plans, 0 to disable the cache
+	 * @throws MonetDBEmbeddedException If the connection is closed
+	 */
+	public void setPlanCacheSize(int size) throws MonetDBEmbeddedException {
+		if(size < 0) {
+			throw new IllegalArgumentException("The plan cache size cannot be negative");
+		}
+		this.checkConnectionIsNotClosed();
+		this.invalidatePlanCache();
+		this.planCache = size == 0 ? null : new PlanCache(this, size);
+	}
+
+	/**
+	 * Gets the number of query plans currently cached by this connection.
+	 *
+	 * @return The number of cached plans
+	 */
+	public int getNumberOfCachedPlans() { return this.planCache == null ? 0 : this.planCache.size(); }
+
+	private void invalidatePlanCache() {
+		if(this.planCache != null) {
+			this.planCache.invalidate();
+		}
 	}
 
 	/**
@@ -213,6 +364,16 @@ public class MonetDBEmbeddedConnection implements Closeable {
 		if (!query.endsWith(";")) {
 			query += ";";
 		}
+		if (this.planCache != null) {
+			if (PlanCache.invalidatesPlans(query)) {
+				this.planCache.invalidate();
+			} else {
+				Integer res = this.planCache.executeUpdate(query);
+				if (res != null) {
+					return res;
+				}
+			}
+		}
 		return this.sendUpdateInternal(this.connectionPointer, query, true);
 	}
 
@@ -228,13 +389,230 @@ public class MonetDBEmbeddedConnection implements Closeable {
 		if (!query.endsWith(";")) {
 			query += ";";
 		}
-		QueryResultSet res = this.sendQueryInternal(this.connectionPointer, query, true);
+		QueryResultSet res = null;
+		if (this.planCache != null) {
+			res = this.planCache.executeQuery(query);
+		}
+		if (res == null) {
+			res = this.sendQueryInternal(this.connectionPointer, query, true);
+		}
 		results.put(res.getRandomIdentifier(), res);
 		return res;
 	}
 
+	/**
+	 * Executes a SQL query and returns the first column of its first row as a long, in a single native call without
+	 * creating a result set. Decimals are truncated to their integral part.
+	 *
+	 * @param query The SQL query string
+	 * @return The value, or {@link nl.cwi.monetdb.embedded.mapping.NullMappings#getLongNullConstant()} if null
+	 * @throws MonetDBEmbeddedException If an error in the database occurred, the query returned no rows or the value
+	 * is not numeric
+	 */
+	public long queryForLong(String query) throws MonetDBEmbeddedException {
+		return this.queryForLongInternal(this.connectionPointer, this.prepareScalarQuery(query));
+	}
+
+	/**
+	 * Executes a SQL query and returns the first column of its first row as a double, in a single native call
+	 * without creating a result set.
+	 *
+	 * @param query The SQL query string
+	 * @return The value, or {@link nl.cwi.monetdb.embedded.mapping.NullMappings#getDoubleNullConstant()} if null
+	 * @throws MonetDBEmbeddedException If an error in the database occurred, the query returned no rows or the value
+	 * is not numeric
+	 */
+	public double queryForDouble(String query) throws MonetDBEmbeddedException {
+		return this.queryForDoubleInternal(this.connectionPointer, this.prepareScalarQuery(query));
+	}
+
+	/**
+	 * Executes a SQL query and returns the first column of its first row as a String, in a single native call
+	 * without creating a result set. Values of other types are formatted as MonetDB does.
+	 *
+	 * @param query The SQL query string
+	 * @return The value, or null if null
+	 * @throws MonetDBEmbeddedException If an error in the database occurred or the query returned no rows
+	 */
+	public String queryForString(String query) throws MonetDBEmbeddedException {
+		return this.queryForStringInternal(this.connectionPointer, this.prepareScalarQuery(query));
+	}
+
+	private String prepareScalarQuery(String query) throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		return query.endsWith(";") ? query : query + ";";
+	}
+
+	/**
+	 * Executes a SQL query without a result set asynchronously, on the database's worker pool. The asynchronous
+	 * queries of a connection run one after the other in submission order. While they are pending, the synchronous
+	 * queries of the connection throw a MonetDBEmbeddedException, and closing it waits for them.
+	 *
+	 * @param query The SQL query string
+	 * @return A future completed with the number of rows affected, or exceptionally with a MonetDBEmbeddedException
+	 * @throws MonetDBEmbeddedException If the connection is closed or the database is not running
+	 */
+	public CompletableFuture<Integer> executeUpdateAsync(String query) throws MonetDBEmbeddedException {
+		return this.submitAsync(() -> this.executeUpdate(query));
+	}
+
+	/**
+	 * Executes a SQL query with a result set asynchronously, on the database's worker pool. The asynchronous
+	 * queries of a connection run one after the other in submission order. While they are pending, the synchronous
+	 * queries of the connection throw a MonetDBEmbeddedException, and closing it waits for them.
+	 *
+	 * @param query The SQL query string
+	 * @return A future completed with the query result object, or exceptionally with a MonetDBEmbeddedException
+	 * @throws MonetDBEmbeddedException If the connection is closed or the database is not running
+	 */
+	public CompletableFuture<QueryResultSet> executeQueryAsync(String query) throws MonetDBEmbeddedException {
+		return this.submitAsync(() -> this.executeQuery(query));
+	}
+
+	private synchronized <T> CompletableFuture<T> submitAsync(AsyncQuery<T> task) throws MonetDBEmbeddedException {
+		if(this.isClosed()) {
+			throw new MonetDBEmbeddedException("This connection is already closed");
+		}
+		CompletableFuture<T> res = this.lastAsyncQuery.handle((r, ex) -> null).thenApplyAsync((ignored) -> {
+			this.asyncRunner = Thread.currentThread();
+			try {
+				return task.run();
+			} catch (MonetDBEmbeddedException ex) {
+				throw new CompletionException(ex);
+			} finally {
+				this.asyncRunner = null;
+			}
+		}, MonetDBEmbeddedDatabase.getAsyncPool());
+		this.lastAsyncQuery = res;
+		return res;
+	}
+
+	/**
+	 * Executes several SQL statements in a single native call, returning the update count of each one. Queries with a
+	 * result set are run as well, but their results are discarded. The statements stop at the first error, whose
+	 * exception message starts with the one-based index of the failing statement.
+	 * <br>
+	 * If transactional, the statements run in a single transaction rolled back on error, unless the connection is
+	 * already in a transaction, in which case they join it. Otherwise each statement follows the autocommit mode of
+	 * the connection, so the ones before the failing statement remain.
+	 *
+	 * @param statements The SQL statements
+	 * @param transactional If the statements run in a single transaction
+	 * @return The update count of each statement, -2 for statements without results and -1 for queries
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public int[] executeBatch(String[] statements, boolean transactional) throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		String[] queries = new String[statements.length];
+		for (int i = 0; i < statements.length; i++) {
+			String next = statements[i].trim();
+			queries[i] = next.endsWith(";") ? next : next + ";";
+		}
+		this.invalidatePlanCache();
+		return this.executeScriptInternal(this.connectionPointer, queries, transactional);
+	}
+
+	/**
+	 * Executes several SQL statements in a single native call, each following the autocommit mode of the connection.
+	 *
+	 * @param statements The SQL statements
+	 * @return The update count of each statement, -2 for statements without results and -1 for queries
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 * @see #executeBatch(String[], boolean)
+	 */
+	public int[] executeBatch(String[] statements) throws MonetDBEmbeddedException {
+		return this.executeBatch(statements, false);
+	}
+
+	/**
+	 * Executes a SQL script, such as a schema migration, in a single native call. The script is split into
+	 * statements at the semicolons outside string literals, quoted identifiers, comments and BEGIN ... END blocks.
+	 *
+	 * @param sql The SQL script
+	 * @param transactional If the statements run in a single transaction
+	 * @return The update count of each statement, -2 for statements without results and -1 for queries
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 * @see #executeBatch(String[], boolean)
+	 */
+	public int[] executeScript(String sql, boolean transactional) throws MonetDBEmbeddedException {
+		return this.executeBatch(splitScript(sql), transactional);
+	}
+
+	/**
+	 * Executes a SQL script in a single native call, each statement following the autocommit mode of the connection.
+	 *
+	 * @param sql The SQL script
+	 * @return The update count of each statement, -2 for statements without results and -1 for queries
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 * @see #executeScript(String, boolean)
+	 */
+	public int[] executeScript(String sql) throws MonetDBEmbeddedException {
+		return this.executeScript(sql, false);
+	}
+
+	/**
+	 * Splits a SQL script into statements.
+	 */
+	private static String[] splitScript(String sql) {
+		List<String> statements = new ArrayList<>();
+		int i = 0, start = 0, blocks = 0, length = sql.length();
+		String previousWord = "";
+
+		while (i < length) {
+			char c = sql.charAt(i);
+			if (c == '\'' || c == '"') {
+				i++;
+				while (i < length && sql.charAt(i) != c) {
+					if (c == '\'' && sql.charAt(i) == '\\') {
+						i++;
+					}
+					i++;
+				}
+				i++;
+			} else if (c == '-' && i + 1 < length && sql.charAt(i + 1) == '-') {
+				while (i < length && sql.charAt(i) != '\n') i++;
+			} else if (c == '/' && i + 1 < length && sql.charAt(i + 1) == '*') {
+				int end = sql.indexOf("*/", i + 2);
+				i = end < 0 ? length : end + 2;
+			} else if (Character.isLetter(c)) {
+				int wordStart = i;
+				while (i < length && (Character.isLetterOrDigit(sql.charAt(i)) || sql.charAt(i) == '_')) i++;
+				String word = sql.substring(wordStart, i).toUpperCase(Locale.ENGLISH);
+				if (word.equals("BEGIN") || word.equals("CASE")) {
+					blocks++;
+				} else if ((word.equals("IF") || word.equals("WHILE")) && previousWord.equals("END")) {
+					blocks++; //END IF and END WHILE close their own statements, not a block
+				} else if (word.equals("END") && blocks > 0) {
+					blocks--;
+				}
+				previousWord = word;
+			} else {
+				if (c == ';' && blocks == 0) {
+					addScriptStatement(statements, sql.substring(start, i));
+					start = i + 1;
+				}
+				i++;
+			}
+		}
+		addScriptStatement(statements, sql.substring(start));
+		return statements.toArray(new String[0]);
+	}
+
+	private static void addScriptStatement(List<String> statements, String statement) {
+		String stripped = statement.replaceAll("(?s)/\\*.*?\\*/", "").replaceAll("--[^\\n]*", "");
+		if (!stripped.trim().isEmpty()) { //skip empty statements and trailing comments
+			statements.add(statement.trim());
+		}
+	}
+
 	/**
 	 * Starts a prepared statement.
+	 * <br>
+	 * Besides the {@code ?} parameters, the query may have array parameters written as {@code ?[type]}, where the
+	 * type is one of TINYINT, SMALLINT, INT, BIGINT, REAL or DOUBLE, such as in
+	 * {@code SELECT * FROM t WHERE id IN (?[BIGINT])}. Each one is replaced by a subquery on a temporary table of the
+	 * statement, so a large membership filter becomes a semi-join instead of a huge IN list to parse. The arrays are
+	 * set with {@link MonetDBEmbeddedPreparedStatement#setArray(int, Object)}.
 	 *
 	 * @param query The SQL query string
 	 * @return A prepared statement object where the user will set the parameters
@@ -246,10 +624,74 @@ public class MonetDBEmbeddedConnection implements Closeable {
 		if (!query.endsWith(";")) {
 			query += ";";
 		}
-		PreparedQueryResultSet res = this.prepareStatementInternal(this.connectionPointer, "PREPARE " + query,
-				true);
+		List<String> arrayTypes = new ArrayList<>();
+		String prefix = "prepared_" + Long.toHexString(Randomizer.generateNextResultSetId()) + "_";
+		query = replaceArrayParameters(query, prefix, arrayTypes);
+		String[] arrayTables = new String[arrayTypes.size()];
+		int created = 0;
+		PreparedQueryResultSet res;
+		try {
+			for (; created < arrayTables.length; created++) {
+				arrayTables[created] = prefix + (created + 1);
+				this.createTemporaryTable(arrayTables[created], new String[]{"v"},
+						new String[]{arrayTypes.get(created)});
+			}
+			res = this.prepareStatementInternal(this.connectionPointer, "PREPARE " + query, true);
+		} catch (MonetDBEmbeddedException ex) {
+			for (int i = 0; i < created; i++) {
+				try {
+					this.dropTemporaryTable(arrayTables[i]);
+				} catch (MonetDBEmbeddedException e) { }
+			}
+			throw ex;
+		}
 		results.put(res.getRandomIdentifier(), res);
-		return new MonetDBEmbeddedPreparedStatement(this, res);
+		return new MonetDBEmbeddedPreparedStatement(this, res, arrayTables, arrayTypes.toArray(new String[0]));
+	}
+
+	/** The element types of the array parameters */
+	private static final String[] ARRAY_PARAMETER_TYPES = {"TINYINT", "SMALLINT", "INT", "BIGINT", "REAL", "DOUBLE"};
+
+	/**
+	 * Replaces the {@code ?[type]} array parameters outside string literals with subqueries on the tables named after
+	 * the prefix, collecting their element types.
+	 */
+	private static String replaceArrayParameters(String query, String prefix, List<String> types)
+			throws MonetDBEmbeddedException {
+		StringBuilder res = new StringBuilder(query.length());
+		int i = 0;
+		while (i < query.length()) {
+			char next = query.charAt(i);
+			int skipped = next == '\'' || next == '"' ? PlanCache.skipQuoted(query, i) :
+					PlanCache.skipComment(query, i);
+			if (skipped != i) { //the strings, quoted identifiers and comments are copied as they are
+				skipped = skipped < 0 ? query.length() : skipped;
+				res.append(query, i, skipped);
+				i = skipped;
+				continue;
+			}
+			if (next == '?' && i + 1 < query.length() && query.charAt(i + 1) == '[') {
+				int end = query.indexOf(']', i);
+				if (end < 0) {
+					throw new MonetDBEmbeddedException("Unterminated array parameter at position " + i);
+				}
+				String type = query.substring(i + 2, end).trim().toUpperCase(Locale.ROOT);
+				boolean known = false;
+				for (String allowed : ARRAY_PARAMETER_TYPES) {
+					known |= allowed.equals(type);
+				}
+				if (!known) {
+					throw new MonetDBEmbeddedException("The array parameter type " + type + " is not supported");
+				}
+				types.add(type);
+				res.append("SELECT \"v\" FROM tmp.").append(StringEscaper.sqlIdentifierEscape(prefix + types.size()));
+				i = end + 1;
+				continue;
+			}
+			res.append(next);
+			i++;
+		}
+		return res.toString();
 	}
 
 	/**
@@ -277,6 +719,41 @@ public class MonetDBEmbeddedConnection implements Closeable {
 		this.executePrepareStatementAndIgnoreInternal(this.connectionPointer, query, true);
 	}
 
+	/**
+	 * Executes a prepared statement by its ID with typed parameter values, bound natively to its cached plan.
+	 *
+	 * @param prepareID The prepared statement ID
+	 * @param kinds The kind of each parameter value
+	 * @param longValues The integral, boolean, decimal and temporal parameter values
+	 * @param doubleValues The floating-point parameter values
+	 * @param objectValues The string and blob parameter values
+	 * @param ignoreResult If the result is discarded, in which case null is returned
+	 * @return The execution result set
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	ExecResultSet executePrepared(int prepareID, byte[] kinds, long[] longValues, double[] doubleValues,
+								  Object[] objectValues, boolean ignoreResult) throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		return this.executePreparedInternal(this.connectionPointer, prepareID, kinds, longValues, doubleValues,
+				objectValues, ignoreResult);
+	}
+
+	/**
+	 * Executes a prepared statement by its ID for every row of the parameter columns in a single transaction, binding
+	 * each row natively to its cached plan.
+	 *
+	 * @param prepareID The prepared statement ID
+	 * @param columns The parameter columns
+	 * @param types The Java array type of each column
+	 * @param rows The number of rows
+	 * @return The update count of each row
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	int[] executeBatch(int prepareID, Object[] columns, byte[] types, int rows) throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		return this.executeBatchInternal(this.connectionPointer, prepareID, columns, types, rows);
+	}
+
 	/**
 	 * Retrieves a database table for further operations on it such as appending data.
 	 *
@@ -307,6 +784,291 @@ public class MonetDBEmbeddedConnection implements Closeable {
 		return res;
 	}
 
+	/**
+	 * Bulk loads CSV data from an InputStream into a table in the current schema, as a
+	 * {@code COPY INTO table FROM STDIN} would do. The stream is read natively by MonetDB's CSV loader, without any
+	 * intermediate file or Java-side parsing. The stream is not closed.
+	 *
+	 * @param tableName The name of the table
+	 * @param in The stream with the CSV data
+	 * @param options The load options, or null for the defaults
+	 * @return The number of rows loaded
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public long copyInto(String tableName, InputStream in, CopyOptions options) throws MonetDBEmbeddedException {
+		return this.copyInto(this.getSchema(), tableName, in, options);
+	}
+
+	/**
+	 * Bulk loads CSV data from an InputStream into a table, as a {@code COPY INTO table FROM STDIN} would do. The
+	 * stream is read natively by MonetDB's CSV loader, without any intermediate file or Java-side parsing. The stream
+	 * is not closed.
+	 *
+	 * @param schemaName The schema of the table
+	 * @param tableName The name of the table
+	 * @param in The stream with the CSV data
+	 * @param options The load options, or null for the defaults
+	 * @return The number of rows loaded
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public long copyInto(String schemaName, String tableName, InputStream in, CopyOptions options)
+			throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		if (options == null) {
+			options = new CopyOptions();
+		}
+		long skip = options.getSkipRecords();
+		return this.copyIntoInternal(this.connectionPointer, schemaName, tableName, in,
+				new byte[options.getBufferSize()], options.getColumnSeparator(), options.getRecordSeparator(),
+				options.getQuote(), options.getNullString(), options.getNumberOfRecords(), skip > 0 ? skip + 1 : 0,
+				options.isLocked(), options.isBestEffort());
+	}
+
+	/**
+	 * Bulk loads column images in the {@code COPY BINARY INTO} format into a table in the current schema. See
+	 * {@link #copyBinaryInto(String, String, ByteBuffer[])}.
+	 *
+	 * @param tableName The name of the table
+	 * @param columns The column images, one per table column
+	 * @return The number of rows loaded
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public long copyBinaryInto(String tableName, ByteBuffer[] columns) throws MonetDBEmbeddedException {
+		return this.copyBinaryInto(this.getSchema(), tableName, columns);
+	}
+
+	/**
+	 * Bulk loads column images in the {@code COPY BINARY INTO} format into a table. Each buffer holds the remaining
+	 * bytes of a column in the table's column order: the values of fixed-width types are laid out as in MonetDB's
+	 * storage (e.g. a date is an int, a decimal an integer of the decimal's storage width), while strings are UTF-8
+	 * and terminated by a newline. The images are copied straight into the new columns, swapping the bytes only if
+	 * the buffer's byte order is not the native one, so no per-value conversion takes place. Direct buffers are read
+	 * without any intermediate copy. The buffers' positions are not changed.
+	 *
+	 * @param schemaName The schema of the table
+	 * @param tableName The name of the table
+	 * @param columns The column images, one per table column
+	 * @return The number of rows loaded
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public long copyBinaryInto(String schemaName, String tableName, ByteBuffer[] columns)
+			throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		Object[] images = new Object[columns.length];
+		int[] offsets = new int[columns.length];
+		int[] lengths = new int[columns.length];
+		boolean[] swaps = new boolean[columns.length];
+		for (int i = 0; i < columns.length; i++) {
+			ByteBuffer next = columns[i];
+			if (next.isDirect()) {
+				images[i] = next;
+				offsets[i] = next.position();
+			} else if (next.hasArray()) {
+				images[i] = next.array();
+				offsets[i] = next.arrayOffset() + next.position();
+			} else {
+				throw new MonetDBEmbeddedException("The column " + (i + 1) + " is neither a direct nor an array buffer");
+			}
+			lengths[i] = next.remaining();
+			swaps[i] = next.order() != ByteOrder.nativeOrder();
+		}
+		return this.copyBinaryIntoInternal(this.connectionPointer, schemaName, tableName, images, offsets, lengths,
+				swaps);
+	}
+
+	/**
+	 * Registers Java columns as a temporary table of this connection, named {@code c1, c2, ...}. See
+	 * {@link #registerView(String, String[], Object[])}.
+	 *
+	 * @param name The name of the view
+	 * @param columns The columns of the view
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void registerView(String name, Object[] columns) throws MonetDBEmbeddedException {
+		String[] columnNames = new String[columns.length];
+		for (int i = 0; i < columns.length; i++) {
+			columnNames[i] = "c" + (i + 1);
+		}
+		this.registerView(name, columnNames, columns);
+	}
+
+	/**
+	 * Registers Java columns as a temporary table of this connection, so SQL queries can join them with the stored
+	 * tables until {@link #unregisterView(String)} is called. The view lives in the {@code tmp} schema and is only
+	 * visible in this connection.
+	 * <br>
+	 * Each column is either a primitive array or a direct NIO buffer in the native byte order, of bytes, shorts,
+	 * ints, longs, floats or doubles, mapped to tinyint, smallint, int, bigint, real and double respectively. The
+	 * remaining elements of a direct buffer are scanned in place by the queries without any copy, so the buffer must
+	 * not be changed while the view is registered. A primitive array cannot be pinned for so long, so it is copied
+	 * once natively, without any per-value conversion. The buffers stay referenced by the connection until the drop
+	 * of the view is committed. The null values are the ones of
+	 * {@link nl.cwi.monetdb.embedded.mapping.NullMappings}. The view is read-only, so DML statements on it fail.
+	 *
+	 * @param name The name of the view
+	 * @param columnNames The names of the columns
+	 * @param columns The columns of the view, all with the same number of rows
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void registerView(String name, String[] columnNames, Object[] columns) throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		if (columns.length == 0 || columnNames.length != columns.length) {
+			throw new IllegalArgumentException("There must be a name for each column, and at least one column");
+		}
+		if (this.views.containsKey(name)) {
+			throw new MonetDBEmbeddedException("The view " + name + " is already registered");
+		}
+		String[] types = new String[columns.length];
+		for (int i = 0; i < columns.length; i++) {
+			types[i] = getViewColumnType(columns[i]);
+		}
+		this.createTemporaryTable(name, columnNames, types);
+		try {
+			this.loadView(name, columns, false);
+		} catch (MonetDBEmbeddedException | RuntimeException ex) {
+			this.dropTemporaryTable(name);
+			throw ex;
+		}
+		this.views.put(name, columns.clone());
+	}
+
+	/**
+	 * Creates a temporary table for a view, kept across transactions.
+	 */
+	void createTemporaryTable(String name, String[] columnNames, String[] types) throws MonetDBEmbeddedException {
+		StringBuilder query = new StringBuilder("CREATE LOCAL TEMPORARY TABLE ")
+				.append(StringEscaper.sqlIdentifierEscape(name)).append(" (");
+		for (int i = 0; i < columnNames.length; i++) {
+			query.append(i > 0 ? ", " : "").append(StringEscaper.sqlIdentifierEscape(columnNames[i])).append(' ')
+					.append(types[i]);
+		}
+		this.executeUpdate(query.append(") ON COMMIT PRESERVE ROWS;").toString());
+	}
+
+	/**
+	 * Drops the temporary table of a view, without going through the plan cache. Its buffers are released once the
+	 * drop is known to be committed.
+	 */
+	void dropTemporaryTable(String name) throws MonetDBEmbeddedException {
+		this.sendUpdateInternal(this.connectionPointer, "DROP TABLE tmp." + StringEscaper.sqlIdentifierEscape(name) +
+				";", true);
+		if (this.getAutoCommit()) {
+			this.pinnedBuffers.remove(name);
+			this.releaseDroppedTables();
+		} else {
+			this.droppedTables.add(name);
+		}
+	}
+
+	/**
+	 * Releases the buffers of the temporary tables dropped in the past transactions, dropping again the ones restored
+	 * by a rollback. Nothing is released inside a transaction.
+	 */
+	private void releaseDroppedTables() throws MonetDBEmbeddedException {
+		if (this.droppedTables.isEmpty() || !this.getAutoCommit()) {
+			return;
+		}
+		for (String name : new ArrayList<>(this.droppedTables)) {
+			if (!this.views.containsKey(name)) {
+				this.sendUpdateInternal(this.connectionPointer, "DROP TABLE IF EXISTS tmp." +
+						StringEscaper.sqlIdentifierEscape(name) + ";", true);
+				this.pinnedBuffers.remove(name);
+			}
+			this.droppedTables.remove(name);
+		}
+	}
+
+	/**
+	 * Loads the columns of a view into its temporary table, replacing its rows if requested.
+	 */
+	void loadView(String name, Object[] columns, boolean replace) throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		int[] offsets = new int[columns.length];
+		int numberOfRows = -1;
+		for (int i = 0; i < columns.length; i++) {
+			Object next = columns[i];
+			int length;
+			if (next instanceof Buffer) {
+				Buffer buffer = (Buffer) next;
+				if (!buffer.isDirect() || getBufferOrder(buffer) != ByteOrder.nativeOrder()) {
+					throw new IllegalArgumentException("The column " + (i + 1) +
+							" must be a direct buffer in the native byte order");
+				}
+				offsets[i] = buffer.position();
+				length = buffer.remaining();
+			} else {
+				length = Array.getLength(next);
+			}
+			if (numberOfRows >= 0 && length != numberOfRows) {
+				throw new IllegalArgumentException("The number of rows between columns is not consistent");
+			}
+			numberOfRows = length;
+		}
+		List<Buffer> pinned = this.pinnedBuffers.computeIfAbsent(name, k -> new ArrayList<>());
+		for (Object next : columns) {
+			if (next instanceof Buffer) {
+				pinned.add((Buffer) next);
+			}
+		}
+		this.loadViewInternal(this.connectionPointer, name, columns, offsets, numberOfRows, replace);
+	}
+
+	/**
+	 * Drops a view registered with {@link #registerView(String, String[], Object[])}, after which its columns are
+	 * not referenced anymore once the drop is committed.
+	 *
+	 * @param name The name of the view
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void unregisterView(String name) throws MonetDBEmbeddedException {
+		this.checkConnectionIsNotClosed();
+		if (!this.views.containsKey(name)) {
+			throw new MonetDBEmbeddedException("The view " + name + " is not registered");
+		}
+		Object[] columns = this.views.remove(name);
+		try {
+			this.dropTemporaryTable(name);
+		} catch (MonetDBEmbeddedException ex) {
+			this.views.put(name, columns);
+			throw ex;
+		}
+	}
+
+	private static ByteOrder getBufferOrder(Buffer buffer) {
+		if (buffer instanceof ByteBuffer) {
+			return ((ByteBuffer) buffer).order();
+		} else if (buffer instanceof ShortBuffer) {
+			return ((ShortBuffer) buffer).order();
+		} else if (buffer instanceof IntBuffer) {
+			return ((IntBuffer) buffer).order();
+		} else if (buffer instanceof LongBuffer) {
+			return ((LongBuffer) buffer).order();
+		} else if (buffer instanceof FloatBuffer) {
+			return ((FloatBuffer) buffer).order();
+		} else if (buffer instanceof DoubleBuffer) {
+			return ((DoubleBuffer) buffer).order();
+		}
+		return null;
+	}
+
+	static String getViewColumnType(Object column) {
+		if (column instanceof byte[] || column instanceof ByteBuffer) {
+			return "TINYINT";
+		} else if (column instanceof short[] || column instanceof ShortBuffer) {
+			return "SMALLINT";
+		} else if (column instanceof int[] || column instanceof IntBuffer) {
+			return "INT";
+		} else if (column instanceof long[] || column instanceof LongBuffer) {
+			return "BIGINT";
+		} else if (column instanceof float[] || column instanceof FloatBuffer) {
+			return "REAL";
+		} else if (column instanceof double[] || column instanceof DoubleBuffer) {
+			return "DOUBLE";
+		}
+		throw new IllegalArgumentException("The column class " + (column == null ? "null" :
+				column.getClass().getSimpleName()) + " is not supported in views");
+	}
+
 	/**
 	 * Performs a listing of the existing tables with schemas.
 	 *
@@ -362,6 +1124,8 @@ public class MonetDBEmbeddedConnection implements Closeable {
 	 * When the database shuts down, this method is called instead
 	 */
 	protected void closeConnectionImplementation() {
+		this.awaitAsyncQueries();
+		this.planCache = null; //the prepared statements are freed with the native context
 		for(AbstractConnectionResult res : this.results.values()) {
 			res.closeResultImplementation();
 		}
@@ -372,6 +1136,54 @@ public class MonetDBEmbeddedConnection implements Closeable {
 			} catch (MonetDBEmbeddedException e) { }
 			this.connectionPointer = 0;
 		}
+		this.views.clear(); //the temporary tables are gone with the native context
+		this.pinnedBuffers.clear();
+		this.droppedTables.clear();
+	}
+
+	/**
+	 * Marks this connection as coming from the database's pool, so closing it returns its context to the pool.
+	 */
+	void setPooled(String defaultSchema) { this.pooledSchema = defaultSchema; }
+
+	/**
+	 * Gets the default schema of a pooled connection, or null if not pooled.
+	 */
+	String getPooledSchema() { return this.pooledSchema; }
+
+	/**
+	 * Resets the session state of a pooled connection and detaches its native context, so a new connection instance
+	 * can reuse it: the results and prepared statements are closed, a pending transaction is rolled back, and the
+	 * autocommit mode, schema and query timeout go back to their defaults. This instance becomes closed.
+	 *
+	 * @return The native connection pointer, or 0 if the session could not be reset
+	 */
+	long detachFromPool() {
+		this.awaitAsyncQueries();
+		this.invalidatePlanCache();
+		this.planCache = null;
+		for(AbstractConnectionResult res : this.results.values()) {
+			res.closeResultImplementation();
+		}
+		this.results.clear();
+		try {
+			if(!this.getAutoCommit()) {
+				this.rollback();
+			}
+			for(String view : new ArrayList<>(this.views.keySet())) {
+				this.unregisterView(view);
+			}
+			this.releaseDroppedTables();
+			this.setSchema(this.pooledSchema);
+			this.queryTimeout = 0;
+			this.setQueryTimeoutInternal(this.connectionPointer, 0);
+			this.cancelRequested = false;
+		} catch (MonetDBEmbeddedException ex) {
+			return 0;
+		}
+		long res = this.connectionPointer;
+		this.connectionPointer = 0;
+		return res;
 	}
 
 	/**
@@ -383,11 +1195,16 @@ public class MonetDBEmbeddedConnection implements Closeable {
 	}
 
 	/**
-	 * Shuts down this connection. Any pending queries connections will be immediately closed as well.
+	 * Shuts down this connection, after its pending asynchronous queries finish. Its results and prepared statements
+	 * are closed as well. A connection
+	 * from {@link MonetDBEmbeddedDatabase#getPooledConnection()} returns its context to the pool instead.
 	 */
 	@Override
 	public void close() {
 		if(!this.isClosed()) {
+			if(this.pooledSchema != null && MonetDBEmbeddedDatabase.returnPooledConnection(this)) {
+				return;
+			}
 			this.closeConnectionImplementation();
 			try {
 				MonetDBEmbeddedDatabase.removeConnection(this, false);
@@ -395,6 +1212,11 @@ public class MonetDBEmbeddedConnection implements Closeable {
 		}
 	}
 
+	/**
+	 * Adds a query result to this connection, to be closed with it.
+	 */
+	void addQueryResult(AbstractConnectionResult res) { this.results.put(res.getRandomIdentifier(), res); }
+
 	/**
 	 * Removes a query result from this connection.
 	 */
@@ -423,6 +1245,21 @@ public class MonetDBEmbeddedConnection implements Closeable {
 	private native QueryResultSet sendQueryInternal(long connectionPointer, String query, boolean execute)
 			throws MonetDBEmbeddedException;
 
+	/**
+	 * Internal implementation of queryForLong.
+	 */
+	private native long queryForLongInternal(long connectionPointer, String query) throws MonetDBEmbeddedException;
+
+	/**
+	 * Internal implementation of queryForDouble.
+	 */
+	private native double queryForDoubleInternal(long connectionPointer, String query) throws MonetDBEmbeddedException;
+
+	/**
+	 * Internal implementation of queryForString.
+	 */
+	private native String queryForStringInternal(long connectionPointer, String query) throws MonetDBEmbeddedException;
+
 	/**
 	 * Internal implementation of prepareStatement.
 	 */
@@ -441,12 +1278,63 @@ public class MonetDBEmbeddedConnection implements Closeable {
 	private native void executePrepareStatementAndIgnoreInternal(long connectionPointer, String query,
 																 boolean execute) throws MonetDBEmbeddedException;
 
+	/**
+	 * Internal implementation of a prepared statement execution with typed parameters.
+	 */
+	private native ExecResultSet executePreparedInternal(long connectionPointer, int prepareID, byte[] kinds,
+														 long[] longValues, double[] doubleValues,
+														 Object[] objectValues, boolean ignoreResult)
+			throws MonetDBEmbeddedException;
+
+	/**
+	 * Internal implementation of a prepared statement batch execution.
+	 */
+	private native int[] executeBatchInternal(long connectionPointer, int prepareID, Object[] columns, byte[] types,
+											  int rows) throws MonetDBEmbeddedException;
+
+	/**
+	 * Internal implementation of executeBatch with SQL statements.
+	 */
+	private native int[] executeScriptInternal(long connectionPointer, String[] statements, boolean transactional)
+			throws MonetDBEmbeddedException;
+
 	/**
 	 * Internal implementation of getMonetDBTable.
 	 */
 	private native MonetDBTable getMonetDBTableInternal(long connectionPointer, String schemaName, String tableName)
 			throws MonetDBEmbeddedException;
 
+	/**
+	 * Internal implementation of copyInto.
+	 */
+	private native long copyIntoInternal(long connectionPointer, String schemaName, String tableName, InputStream in,
+										 byte[] buffer, String columnSeparator, String recordSeparator, String quote,
+										 String nullString, long numberOfRecords, long offset, boolean locked,
+										 boolean bestEffort) throws MonetDBEmbeddedException;
+
+	/**
+	 * Internal implementation of copyBinaryInto.
+	 */
+	private native long copyBinaryIntoInternal(long connectionPointer, String schemaName, String tableName,
+											   Object[] columns, int[] offsets, int[] lengths, boolean[] swaps)
+			throws MonetDBEmbeddedException;
+
+	/**
+	 * Internal implementation of registerView.
+	 */
+	private native void loadViewInternal(long connectionPointer, String viewName, Object[] columns, int[] offsets,
+										 int numberOfRows, boolean replace) throws MonetDBEmbeddedException;
+
+	/**
+	 * Internal implementation of setQueryTimeout.
+	 */
+	private native void setQueryTimeoutInternal(long connectionPointer, long microseconds);
+
+	/**
+	 * Internal implementation of cancel.
+	 */
+	private native void cancelInternal(long connectionPointer);
+
 	/**
 	 * Internal implementation to close a connection.
 	 */
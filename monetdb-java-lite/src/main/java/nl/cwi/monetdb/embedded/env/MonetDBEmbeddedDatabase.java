@@ -10,7 +10,13 @@ package nl.cwi.monetdb.embedded.env;
 
 import nl.cwi.monetdb.embedded.jdbc.JDBCEmbeddedConnection;
 
+import java.util.ArrayDeque;
 import java.util.HashMap;
+import java.util.Iterator;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.locks.ReentrantReadWriteLock;
 
 /**
@@ -228,12 +234,15 @@ public final class MonetDBEmbeddedDatabase {
 			if(monetDBEmbeddedDatabase == null) {
 				throw new MonetDBEmbeddedException("The MonetDB Embedded database is not running");
 			} else {
+				//closing a connection waits for its pending asynchronous queries
 				for(MonetDBEmbeddedConnection mdbec : monetDBEmbeddedDatabase.connections.values()) {
 					if(!mdbec.isClosed()) {
 						mdbec.closeConnectionImplementation();
 					}
 				}
 				monetDBEmbeddedDatabase.connections.clear();
+				monetDBEmbeddedDatabase.closeIdleConnections();
+				monetDBEmbeddedDatabase.shutdownAsyncPool();
 				monetDBEmbeddedDatabase.stopDatabaseInternal();
 				monetDBEmbeddedDatabase = null;
 				isClosed = true;
@@ -272,6 +281,125 @@ public final class MonetDBEmbeddedDatabase {
 		}
 	}
 
+	/**
+	 * Sets the options of the connection pool used by {@link #getPooledConnection()}. The idle connections beyond
+	 * the new limits are closed.
+	 *
+	 * @param maximumIdleConnections The maximum number of idle connections kept warm, 0 to disable the pooling
+	 * @param idleTimeout The time in milliseconds after which an idle connection is closed, 0 to keep them forever
+	 * @throws MonetDBEmbeddedException If the database is not running
+	 */
+	public static void setConnectionPoolOptions(int maximumIdleConnections, long idleTimeout)
+			throws MonetDBEmbeddedException {
+		if(maximumIdleConnections < 0 || idleTimeout < 0) {
+			throw new IllegalArgumentException("The pool size and the idle timeout cannot be negative");
+		}
+		locker.writeLock().lock();
+		try {
+			if(monetDBEmbeddedDatabase == null) {
+				throw new MonetDBEmbeddedException("The MonetDB Embedded database is not running");
+			}
+			monetDBEmbeddedDatabase.maximumIdleConnections = maximumIdleConnections;
+			monetDBEmbeddedDatabase.idleTimeout = idleTimeout;
+			monetDBEmbeddedDatabase.evictIdleConnections();
+			locker.writeLock().unlock();
+		} catch (Exception ex) {
+			locker.writeLock().unlock();
+			throw ex;
+		}
+	}
+
+	/**
+	 * Gets a connection from the pool, set on the default schema. It reuses the client context of a previously closed
+	 * pooled connection when there is one, avoiding the allocation of a new SQL session. Closing the connection
+	 * resets its session state and returns its context to the pool.
+	 *
+	 * @return A MonetDBEmbeddedConnection instance
+	 * @throws MonetDBEmbeddedException If the database is not running or an error in the database occurred
+	 */
+	public static MonetDBEmbeddedConnection getPooledConnection() throws MonetDBEmbeddedException {
+		locker.writeLock().lock();
+		try {
+			if(monetDBEmbeddedDatabase == null) {
+				throw new MonetDBEmbeddedException("The MonetDB Embedded database is not running");
+			}
+			monetDBEmbeddedDatabase.evictIdleConnections();
+			IdleConnection idle = monetDBEmbeddedDatabase.idleConnections.pollLast();
+			MonetDBEmbeddedConnection con;
+			if(idle != null) {
+				con = new MonetDBEmbeddedConnection(idle.connectionPointer);
+				con.setPooled(idle.defaultSchema);
+			} else {
+				con = monetDBEmbeddedDatabase.createConnectionInternal();
+				try {
+					con.setPooled(con.getSchema());
+				} catch (MonetDBEmbeddedException ex) {
+					con.closeConnectionImplementation();
+					throw ex;
+				}
+			}
+			monetDBEmbeddedDatabase.connections.put(con.getRandomIdentifier(), con);
+			locker.writeLock().unlock();
+			return con;
+		} catch (Exception ex) {
+			locker.writeLock().unlock();
+			throw ex;
+		}
+	}
+
+	/**
+	 * Gets the number of idle connections in the pool.
+	 *
+	 * @return The number of idle connections
+	 * @throws MonetDBEmbeddedException If the database is not running
+	 */
+	public static int getNumberOfIdleConnections() throws MonetDBEmbeddedException {
+		locker.readLock().lock();
+		try {
+			if(monetDBEmbeddedDatabase == null) {
+				throw new MonetDBEmbeddedException("The MonetDB Embedded database is not running");
+			}
+			int res = monetDBEmbeddedDatabase.idleConnections.size();
+			locker.readLock().unlock();
+			return res;
+		} catch (Exception ex) {
+			locker.readLock().unlock();
+			throw ex;
+		}
+	}
+
+	/**
+	 * Returns a pooled connection's context to the pool, after resetting its session state.
+	 *
+	 * @param con The pooled connection being closed
+	 * @return False if the connection must be closed instead
+	 */
+	static boolean returnPooledConnection(MonetDBEmbeddedConnection con) {
+		long pointer = con.detachFromPool();
+		if(pointer == 0) {
+			return false;
+		}
+		String schema = con.getPooledSchema();
+		locker.writeLock().lock();
+		try {
+			boolean pooled = false;
+			if(monetDBEmbeddedDatabase != null) {
+				monetDBEmbeddedDatabase.connections.remove(con.getRandomIdentifier());
+				if(monetDBEmbeddedDatabase.idleConnections.size() < monetDBEmbeddedDatabase.maximumIdleConnections) {
+					monetDBEmbeddedDatabase.idleConnections.addLast(new IdleConnection(pointer, schema));
+					pooled = true;
+				}
+				monetDBEmbeddedDatabase.evictIdleConnections();
+			}
+			if(!pooled) {
+				new MonetDBEmbeddedConnection(pointer).closeConnectionImplementation();
+			}
+		} finally {
+			locker.writeLock().unlock();
+		}
+		return true;
+	}
+
 	/**
 	 * Creates a JDBC embedded connection in the directory.
 	 *
@@ -342,6 +470,8 @@ public final class MonetDBEmbeddedDatabase {
 		try {
 			monetDBEmbeddedDatabase.connections.remove(con.getRandomIdentifier());
 			if(toShutDown && monetDBEmbeddedDatabase.connections.isEmpty()) {
+				monetDBEmbeddedDatabase.closeIdleConnections();
+				monetDBEmbeddedDatabase.shutdownAsyncPool();
 				monetDBEmbeddedDatabase.stopDatabaseInternal();
 				monetDBEmbeddedDatabase = null;
 				isClosed = true;
@@ -353,6 +483,38 @@ public final class MonetDBEmbeddedDatabase {
 		}
 	}
 
+	/**
+	 * Retrieves the worker pool where the asynchronous queries of all connections run, creating it on the first use.
+	 * Its daemon threads are started from Java, so they are already attached to the JVM when they call the native
+	 * query functions.
+	 *
+	 * @return The worker pool of the asynchronous queries
+	 * @throws MonetDBEmbeddedException If the database is not running
+	 */
+	static ExecutorService getAsyncPool() throws MonetDBEmbeddedException {
+		locker.writeLock().lock();
+		try {
+			if(monetDBEmbeddedDatabase == null) {
+				throw new MonetDBEmbeddedException("The MonetDB Embedded database is not running");
+			}
+			if(monetDBEmbeddedDatabase.asyncPool == null) {
+				AtomicInteger counter = new AtomicInteger();
+				monetDBEmbeddedDatabase.asyncPool = Executors.newFixedThreadPool(
+						Runtime.getRuntime().availableProcessors(), (r) -> {
+							Thread worker = new Thread(r, "MonetDB async worker " + counter.incrementAndGet());
+							worker.setDaemon(true);
+							return worker;
+						});
+			}
+			ExecutorService res = monetDBEmbeddedDatabase.asyncPool;
+			locker.writeLock().unlock();
+			return res;
+		} catch (Exception ex) {
+			locker.writeLock().unlock();
+			throw ex;
+		}
+	}
+
 	/** The database's farm directory */
 	private final String databaseDirectory;
 
@@ -365,12 +527,89 @@ public final class MonetDBEmbeddedDatabase {
 	/** Hash table of embedded connections. */
 	private final HashMap<Long, MonetDBEmbeddedConnection> connections = new HashMap<>();
 
+	/** The worker pool of the asynchronous queries, created on demand. */
+	private ExecutorService asyncPool;
+
+	/** An idle client context in the connection pool. */
+	private static final class IdleConnection {
+
+		private final long connectionPointer;
+
+		private final String defaultSchema;
+
+		private final long idleSince = System.currentTimeMillis();
+
+		private IdleConnection(long connectionPointer, String defaultSchema) {
+			this.connectionPointer = connectionPointer;
+			this.defaultSchema = defaultSchema;
+		}
+	}
+
+	/** The idle connections of the pool, the most recently returned last. */
+	private final ArrayDeque<IdleConnection> idleConnections = new ArrayDeque<>();
+
+	/** The maximum number of idle connections in the pool. */
+	private int maximumIdleConnections = 8;
+
+	/** The time in milliseconds after which an idle connection is closed, 0 to keep them forever. */
+	private long idleTimeout = 60000;
+
 	private MonetDBEmbeddedDatabase(String dbDirectory, boolean silentFlag, boolean sequentialFlag) {
 		this.databaseDirectory = dbDirectory;
 		this.silentFlag = silentFlag;
 		this.sequentialFlag = sequentialFlag;
 	}
 
+	/**
+	 * Closes the idle connections that expired or exceed the maximum size of the pool, the oldest first.
+	 */
+	private void evictIdleConnections() {
+		long now = System.currentTimeMillis();
+		Iterator<IdleConnection> it = this.idleConnections.iterator();
+		while(it.hasNext()) {
+			IdleConnection next = it.next();
+			if(this.idleConnections.size() > this.maximumIdleConnections ||
+					(this.idleTimeout > 0 && now - next.idleSince >= this.idleTimeout)) {
+				it.remove();
+				new MonetDBEmbeddedConnection(next.connectionPointer).closeConnectionImplementation();
+			}
+		}
+	}
+
+	/**
+	 * Closes all the idle connections of the pool.
+	 */
+	private void closeIdleConnections() {
+		for(IdleConnection next : this.idleConnections) {
+			new MonetDBEmbeddedConnection(next.connectionPointer).closeConnectionImplementation();
+		}
+		this.idleConnections.clear();
+	}
+
+	/**
+	 * Stops accepting asynchronous queries and waits for the ones still running, so the database is not stopped
+	 * under them.
+	 */
+	private void shutdownAsyncPool() {
+		if(this.asyncPool != null) {
+			boolean interrupted = false;
+			this.asyncPool.shutdown();
+			while(true) {
+				try {
+					if(this.asyncPool.awaitTermination(Long.MAX_VALUE, TimeUnit.MILLISECONDS)) {
+						break;
+					}
+				} catch (InterruptedException ex) {
+					interrupted = true;
+				}
+			}
+			if(interrupted) {
+				Thread.currentThread().interrupt();
+			}
+			this.asyncPool = null;
+		}
+	}
+
 	/**
 	 * Internal implementation to start a database.
 	 */
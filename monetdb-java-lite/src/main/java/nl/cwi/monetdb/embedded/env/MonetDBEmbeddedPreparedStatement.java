@@ -19,7 +19,12 @@ import java.math.BigInteger;
 import java.math.RoundingMode;
 import java.net.URL;
 import java.sql.*;
-import java.text.SimpleDateFormat;
+import java.time.Instant;
+import java.time.LocalDate;
+import java.time.LocalDateTime;
+import java.time.LocalTime;
+import java.time.ZoneId;
+import java.time.ZoneOffset;
 import java.util.Calendar;
 
 /**
@@ -42,9 +47,38 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 */
 	private final int rscolcnt;
 	/**
-	 * The user input values to submit
+	 * The kinds of the parameter slots, the same as in the native execute
 	 */
-	private final String[] values;
+	private static final byte PARAM_UNSET = 0;
+	private static final byte PARAM_NULL = 1;
+	private static final byte PARAM_BOOLEAN = 2;
+	private static final byte PARAM_LONG = 3;
+	private static final byte PARAM_REAL = 4;
+	private static final byte PARAM_DOUBLE = 5;
+	private static final byte PARAM_STRING = 6;
+	private static final byte PARAM_BLOB = 7;
+	private static final byte PARAM_DECIMAL = 8;
+	private static final byte PARAM_DATE = 9;
+	private static final byte PARAM_TIME = 10;
+	private static final byte PARAM_TIMESTAMP = 11;
+
+	/**
+	 * The kind of each parameter value to submit
+	 */
+	private final byte[] kinds;
+	/**
+	 * The integral and boolean parameter values, the unscaled decimals, the days since the epoch of dates, the
+	 * microseconds of the day of times and the microseconds since the epoch of timestamps
+	 */
+	private final long[] longValues;
+	/**
+	 * The floating-point parameter values
+	 */
+	private final double[] doubleValues;
+	/**
+	 * The string and blob parameter values
+	 */
+	private final Object[] objectValues;
 
 	/**
 	 * The MonetDB internal types
@@ -72,23 +106,33 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	private final String[] column;
 
 	/**
-	 * Format dates, times and timestamps
+	 * The temporary tables of the array parameters
+	 */
+	private final String[] arrayTables;
+	/**
+	 * The element types of the array parameters
+	 */
+	private final String[] arrayTypes;
+	/**
+	 * The array parameter values
+	 */
+	private final Object[] arrayValues;
+	/**
+	 * If an array parameter was set after the last execution
 	 */
-	private final SimpleDateFormat mTimestampZ;
-	private final SimpleDateFormat mTimestamp;
-	private final SimpleDateFormat mTimeZ;
-	private final SimpleDateFormat mTime;
-	private final SimpleDateFormat mDate;
+	private final boolean[] arrayChanged;
 
-	MonetDBEmbeddedPreparedStatement(MonetDBEmbeddedConnection connection, PreparedQueryResultSet qrs)
-			throws MonetDBEmbeddedException {
+	MonetDBEmbeddedPreparedStatement(MonetDBEmbeddedConnection connection, PreparedQueryResultSet qrs,
+									 String[] arrayTables, String[] arrayTypes) throws MonetDBEmbeddedException {
 		super(connection);
+		this.arrayTables = arrayTables;
+		this.arrayTypes = arrayTypes;
+		this.arrayValues = new Object[arrayTables.length];
+		this.arrayChanged = new boolean[arrayTables.length];
 
 		this.id = qrs.getPreparedID();
 		this.size = qrs.getNumberOfRows();
 		this.rscolcnt = qrs.getNumberOfColumns();
-		this.values = new String[this.size];
-
 		this.monetdbType = new String[this.size];
 		this.digits = new int[this.size];
 		this.scale = new int[this.size];
@@ -104,11 +148,15 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 		qrs.getStringColumnByIndex(8, this.column);
 		qrs.close();
 
-		mTimestampZ = new SimpleDateFormat("yyyy-MM-dd HH:mm:ss.SSSZ");
-		mTimestamp = new SimpleDateFormat("yyyy-MM-dd HH:mm:ss.SSS");
-		mTimeZ = new SimpleDateFormat("HH:mm:ss.SSSZ");
-		mTime = new SimpleDateFormat("HH:mm:ss.SSS");
-		mDate = new SimpleDateFormat("yyyy-MM-dd");
+		int params = 0;
+		for (String col : this.column) {
+			if (col == null)
+				params++;
+		}
+		this.kinds = new byte[params];
+		this.longValues = new long[params];
+		this.doubleValues = new double[params];
+		this.objectValues = new Object[params];
 	}
 
 	@Override
@@ -163,38 +211,82 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * Clears the current parameter values immediately.
 	 */
 	public void clearParameters() {
-		for (int i = 0; i < values.length; i++) {
-			values[i] = null;
+		for (int i = 0; i < kinds.length; i++) {
+			kinds[i] = PARAM_UNSET;
+			objectValues[i] = null;
+		}
+		for (int i = 0; i < arrayValues.length; i++) {
+			arrayValues[i] = null;
+			arrayChanged[i] = false;
+		}
+	}
+
+	/**
+	 * Gets the number of array parameters, written as {@code ?[type]} in the query. See
+	 * {@link MonetDBEmbeddedConnection#prepareStatement(String)}.
+	 *
+	 * @return The number of array parameters
+	 */
+	public int getNumberOfArrayParameters() { return this.arrayTables.length; }
+
+	/**
+	 * Sets the values of an array parameter, a primitive array of the parameter's element type: byte[] for TINYINT,
+	 * short[] for SMALLINT, int[] for INT, long[] for BIGINT, float[] for REAL and double[] for DOUBLE. The values
+	 * are copied natively into the parameter's temporary table on the next execution, without any per-value
+	 * conversion, and reused by the following executions until set again.
+	 *
+	 * @param arrayIndex the first array parameter is 1, the second is 2, ...
+	 * @param values The values of the array parameter
+	 * @throws MonetDBEmbeddedException if the values do not match the array parameter
+	 */
+	public void setArray(int arrayIndex, Object values) throws MonetDBEmbeddedException {
+		if (arrayIndex < 1 || arrayIndex > this.arrayTables.length) {
+			throw new MonetDBEmbeddedException("No array parameter with index: " + arrayIndex);
 		}
+		if (values == null || !values.getClass().isArray() ||
+				!MonetDBEmbeddedConnection.getViewColumnType(values).equals(this.arrayTypes[arrayIndex - 1])) {
+			throw new MonetDBEmbeddedException("The array parameter " + arrayIndex + " must be a primitive array of "
+					+ this.arrayTypes[arrayIndex - 1] + " values");
+		}
+		this.arrayValues[arrayIndex - 1] = values;
+		this.arrayChanged[arrayIndex - 1] = true;
 	}
 
 	/**
-	 * Transforms the prepared query into a simple SQL query by replacing the ?'s with the given column contents.
+	 * Executes the prepared statement with the current parameter values. The typed values are handed to the native
+	 * side, which binds them as the arguments of the cached plan and runs it without parsing any SQL.
 	 * Mind that the JDBC specs allow `reuse' of a value for a column over multiple executes.
 	 *
-	 * @return the simple SQL string for the prepare query
+	 * @param ignoreResult If the result is discarded, in which case null is returned
+	 * @return The result of the execution
 	 * @throws MonetDBEmbeddedException if not all columns are set
 	 */
-	private String transform() throws MonetDBEmbeddedException {
-		StringBuilder buf = new StringBuilder(8 + 12 * size);
-		buf.append("execute ");
-		buf.append(id);
-		buf.append("(");
-		// check if all columns are set and do a replace
-		int col = 0;
-		for (int i = 0; i < size; i++) {
-			if (column[i] != null)
-				continue;
-			col++;
-			if (col > 1)
-				buf.append(',');
-			if (values[i] == null)
-				throw new MonetDBEmbeddedException("Cannot execute, parameter " + col + " is missing.");
+	private ExecResultSet executeInternal(boolean ignoreResult) throws MonetDBEmbeddedException {
+		for (int i = 0; i < kinds.length; i++) {
+			if (kinds[i] == PARAM_UNSET)
+				throw new MonetDBEmbeddedException("Cannot execute, parameter " + (i + 1) + " is missing.");
+		}
+		this.loadArrayParameters();
+		return this.getConnection().executePrepared(this.id, kinds, longValues, doubleValues, objectValues,
+				ignoreResult);
+	}
 
-			buf.append(values[i]);
+	/**
+	 * Copies the array parameters set after the last execution into their temporary tables.
+	 *
+	 * @throws MonetDBEmbeddedException if not all array parameters are set
+	 */
+	private void loadArrayParameters() throws MonetDBEmbeddedException {
+		for (int i = 0; i < arrayValues.length; i++) {
+			if (arrayValues[i] == null)
+				throw new MonetDBEmbeddedException("Cannot execute, array parameter " + (i + 1) + " is missing.");
+		}
+		for (int i = 0; i < arrayValues.length; i++) {
+			if (arrayChanged[i]) {
+				this.getConnection().loadView(arrayTables[i], new Object[]{arrayValues[i]}, true);
+				arrayChanged[i] = false;
+			}
 		}
-		buf.append(");");
-		return buf.toString();
 	}
 
 	/**
@@ -207,7 +299,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public boolean execute() throws MonetDBEmbeddedException {
-		ExecResultSet result = this.getConnection().executePrepareStatement(this.transform());
+		ExecResultSet result = this.executeInternal(false);
 		boolean res = result.getStatus();
 		if(res) { //Why JDBC???
 			result.getResultSet().close();
@@ -221,7 +313,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void executeAndIgnore() throws MonetDBEmbeddedException {
-		this.getConnection().executePreparedStatementAndIgnore(this.transform());
+		this.executeInternal(true);
 	}
 
 	/**
@@ -233,7 +325,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 *                                  QueryResultSet
 	 */
 	public QueryResultSet executeQuery() throws MonetDBEmbeddedException {
-		ExecResultSet result = this.getConnection().executePrepareStatement(this.transform());
+		ExecResultSet result = this.executeInternal(false);
 		if (!result.getStatus()) {
 			throw new MonetDBEmbeddedException("Query did not produce a result set");
 		}
@@ -249,13 +341,135 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs or the SQL statement returns a ResultSet
 	 */
 	public int executeUpdate() throws MonetDBEmbeddedException {
-		ExecResultSet result = this.getConnection().executePrepareStatement(this.transform());
+		ExecResultSet result = this.executeInternal(false);
 		if (result.getStatus()) {
 			throw new MonetDBEmbeddedException("Query produced a result set");
 		}
 		return result.getNumberOfRows();
 	}
 
+	/**
+	 * The Java array types of the batch parameter columns, the same as in the native batch execute
+	 */
+	private static final byte BATCH_BOOLEAN = 0;
+	private static final byte BATCH_BYTE = 1;
+	private static final byte BATCH_SHORT = 2;
+	private static final byte BATCH_INT = 3;
+	private static final byte BATCH_LONG = 4;
+	private static final byte BATCH_FLOAT = 5;
+	private static final byte BATCH_DOUBLE = 6;
+	private static final byte BATCH_STRING = 7;
+	private static final byte BATCH_BLOB = 8;
+	private static final byte BATCH_TYPED = 9;
+
+	/**
+	 * Executes the prepared statement once for every row of the given parameter columns, in a single native call and
+	 * a single transaction. Each column holds the values of a parameter, in parameter order, and all the columns must
+	 * have the same length.
+	 * <br>
+	 * Primitive arrays are bound directly, using the MonetDB null constants of
+	 * {@link nl.cwi.monetdb.embedded.mapping.NullMappings} for SQL NULL (booleans cannot be null). String[] and
+	 * byte[][] columns bind strings and blobs, while any other object array is converted with
+	 * {@link #setObject(int, Object)} row by row into typed values, without writing any SQL. All the rows are bound
+	 * natively to the arguments of the cached plan. If a row fails, the whole batch is rolled back and the exception
+	 * tells the failing row. If the connection is already in a transaction, the batch joins it instead, and a
+	 * failing row aborts that transaction, as any failing statement does.
+	 * The current parameter values are left untouched.
+	 *
+	 * @param parameterColumns The columns of parameter values
+	 * @return The update count of each row, -2 for statements without results and -1 for queries
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public int[] executeBatch(Object[] parameterColumns) throws MonetDBEmbeddedException {
+		if (parameterColumns.length != kinds.length) {
+			throw new MonetDBEmbeddedException("The prepared statement has " + kinds.length + " parameters, but "
+					+ parameterColumns.length + " columns were given");
+		}
+		Object[] columns = new Object[kinds.length];
+		byte[] types = new byte[kinds.length];
+		int rows = -1;
+		for (int i = 0; i < kinds.length; i++) {
+			Object next = parameterColumns[i];
+			if (next == null || !next.getClass().isArray()) {
+				throw new MonetDBEmbeddedException("The parameter column " + (i + 1) + " is not an array");
+			}
+			int length = java.lang.reflect.Array.getLength(next);
+			if (rows >= 0 && length != rows) {
+				throw new MonetDBEmbeddedException("The parameter columns have different lengths");
+			}
+			rows = length;
+			columns[i] = next;
+			if (next instanceof boolean[]) {
+				types[i] = BATCH_BOOLEAN;
+			} else if (next instanceof byte[]) {
+				types[i] = BATCH_BYTE;
+			} else if (next instanceof short[]) {
+				types[i] = BATCH_SHORT;
+			} else if (next instanceof int[]) {
+				types[i] = BATCH_INT;
+			} else if (next instanceof long[]) {
+				types[i] = BATCH_LONG;
+			} else if (next instanceof float[]) {
+				types[i] = BATCH_FLOAT;
+			} else if (next instanceof double[]) {
+				types[i] = BATCH_DOUBLE;
+			} else if (next instanceof String[] && isStringParameter(i + 1)) {
+				types[i] = BATCH_STRING;
+			} else if (next instanceof byte[][]) {
+				types[i] = BATCH_BLOB;
+			} else if (next instanceof Object[]) {
+				types[i] = BATCH_TYPED;
+				columns[i] = this.toTypedColumn(i + 1, (Object[]) next);
+			} else {
+				throw new MonetDBEmbeddedException("The parameter column " + (i + 1) + " has an unsupported type");
+			}
+		}
+		if (rows == 0) {
+			return new int[0];
+		}
+		this.loadArrayParameters();
+		return this.getConnection().executeBatch(this.id, columns, types, rows);
+	}
+
+	/**
+	 * Tells if a parameter is a character string, which needs no conversion.
+	 */
+	private boolean isStringParameter(int index) throws MonetDBEmbeddedException {
+		String type = monetdbType[getParamIdx(index)];
+		return "clob".equals(type) || "varchar".equals(type) || "char".equals(type);
+	}
+
+	/**
+	 * Converts a parameter column of objects into typed slots with setObject, restoring the parameter value. The
+	 * result is the {kinds, longValues, doubleValues, objectValues} arrays of the column, bound natively.
+	 */
+	private Object[] toTypedColumn(int index, Object[] column) throws MonetDBEmbeddedException {
+		int slot = getParamSlot(index);
+		byte kind = kinds[slot];
+		long lvalue = longValues[slot];
+		double dvalue = doubleValues[slot];
+		Object ovalue = objectValues[slot];
+		byte[] columnKinds = new byte[column.length];
+		long[] columnLongs = new long[column.length];
+		double[] columnDoubles = new double[column.length];
+		Object[] columnObjects = new Object[column.length];
+		try {
+			for (int i = 0; i < column.length; i++) {
+				setObject(index, column[i]);
+				columnKinds[i] = kinds[slot];
+				columnLongs[i] = longValues[slot];
+				columnDoubles[i] = doubleValues[slot];
+				columnObjects[i] = objectValues[slot];
+			}
+		} finally {
+			kinds[slot] = kind;
+			longValues[slot] = lvalue;
+			doubleValues[slot] = dvalue;
+			objectValues[slot] = ovalue;
+		}
+		return new Object[]{columnKinds, columnLongs, columnDoubles, columnObjects};
+	}
+
 	/**
 	 * Returns the index (0..size-1) in the backing arrays for the given resultset column number or a
 	 * MonetDBEmbeddedException when not found
@@ -289,15 +503,51 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	}
 
 	/**
-	 * Sets the given index with the supplied value. If the given index is out of bounds, and MonetDBEmbeddedException
-	 * is thrown. The given value should never be null.
-	 *
-	 * @param index the parameter index
-	 * @param val the exact String representation to set
-	 * @throws MonetDBEmbeddedException if the given index is out of bounds
+	 * Returns the slot (0..number of parameters-1) of the given parameter number or a MonetDBEmbeddedException when
+	 * not found
+	 */
+	private int getParamSlot(int paramnr) throws MonetDBEmbeddedException {
+		if (paramnr < 1 || paramnr > kinds.length)
+			throw new MonetDBEmbeddedException("No such parameter with index: " + paramnr);
+		return paramnr - 1;
+	}
+
+	private void setLongValue(int index, byte kind, long val) throws MonetDBEmbeddedException {
+		int slot = getParamSlot(index);
+		kinds[slot] = kind;
+		longValues[slot] = val;
+		objectValues[slot] = null;
+	}
+
+	private void setDoubleValue(int index, byte kind, double val) throws MonetDBEmbeddedException {
+		int slot = getParamSlot(index);
+		kinds[slot] = kind;
+		doubleValues[slot] = val;
+		objectValues[slot] = null;
+	}
+
+	private void setObjectValue(int index, byte kind, Object val) throws MonetDBEmbeddedException {
+		int slot = getParamSlot(index);
+		kinds[slot] = kind;
+		objectValues[slot] = val;
+	}
+
+	/**
+	 * Tells if a parameter is a temporal type with a time zone, whose values are bound in UTC.
+	 */
+	private boolean hasTimeZone(int index) throws MonetDBEmbeddedException {
+		String type = monetdbType[getParamIdx(index)];
+		return "timetz".equals(type) || "timestamptz".equals(type);
+	}
+
+	/**
+	 * The time zone to read a date, time or timestamp in, the one of the calendar or the default of the JVM.
 	 */
-	private void setValue(int index, String val) throws MonetDBEmbeddedException {
-		values[getParamIdx(index)] = val;
+	private ZoneId getZone(int index, Calendar cal) throws MonetDBEmbeddedException {
+		if (hasTimeZone(index)) {
+			return ZoneOffset.UTC;
+		}
+		return cal == null ? ZoneId.systemDefault() : cal.getTimeZone().toZoneId();
 	}
 
 	/**
@@ -312,7 +562,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	public void setNull(int parameterIndex, int sqlType) throws MonetDBEmbeddedException {
 		// we discard the given type here, the backend converts the
 		// value NULL to whatever it needs for the column
-		setValue(parameterIndex, "NULL");
+		setObjectValue(parameterIndex, PARAM_NULL, null);
 	}
 
 	/**
@@ -349,8 +599,25 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void setBigDecimal(int idx, BigDecimal x) throws MonetDBEmbeddedException {
+		if (x == null) {
+			setNull(idx, -1);
+			return;
+		}
 		// get array position
 		int i = getParamIdx(idx);
+		if (!"decimal".equals(monetdbType[i])) {
+			// the other numeric parameters take the value as such
+			if ("real".equals(monetdbType[i]) || "double".equals(monetdbType[i])) {
+				setDouble(idx, x.doubleValue());
+			} else {
+				try {
+					setLong(idx, x.setScale(0, RoundingMode.HALF_UP).longValueExact());
+				} catch (ArithmeticException ex) {
+					throw new MonetDBEmbeddedException("Value out of range: " + x.toPlainString());
+				}
+			}
+			return;
+		}
 		// round to the scale of the DB:
 		x = x.setScale(scale[i], RoundingMode.HALF_UP);
 		// if precision is now greater than that of the db, throw an error:
@@ -358,17 +625,13 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			throw new MonetDBEmbeddedException("DECIMAL value exceeds allowed digits/scale: " + x.toPlainString() +
 					" (" + digits[i] + "/" + scale[i] + ")");
 		}
-		// MonetDB doesn't like leading 0's, since it counts them as part of
-		// the precision, so let's strip them off. (But be careful not to do
-		// this to the exact number "0".)  Also strip off trailing
-		// numbers that are inherent to the double representation.
-		String xStr = x.toPlainString();
-		int dot = xStr.indexOf('.');
-		if (dot >= 0)
-			xStr = xStr.substring(0, Math.min(xStr.length(), dot + 1 + scale[i]));
-		while (xStr.startsWith("0") && xStr.length() > 1)
-			xStr = xStr.substring(1);
-		setValue(idx, xStr);
+		// bound as the unscaled value at the scale of the parameter
+		try {
+			setLongValue(idx, PARAM_DECIMAL, x.unscaledValue().longValueExact());
+		} catch (ArithmeticException ex) {
+			throw new MonetDBEmbeddedException("DECIMAL values of more than 18 digits are not supported: " +
+					x.toPlainString());
+		}
 	}
 
 	/**
@@ -403,7 +666,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void setBoolean(int parameterIndex, boolean x) throws MonetDBEmbeddedException {
-		setValue(parameterIndex, Boolean.toString(x));
+		setLongValue(parameterIndex, PARAM_BOOLEAN, x ? 1 : 0);
 	}
 
 	/**
@@ -415,11 +678,9 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void setByte(int parameterIndex, byte x) throws MonetDBEmbeddedException {
-		setValue(parameterIndex, Byte.toString(x));
+		setLongValue(parameterIndex, PARAM_LONG, x);
 	}
 
-	private static final String HEXES = "0123456789ABCDEF";
-
 	/**
 	 * Sets the designated parameter to the given Java array of bytes. The driver converts this to an SQL VARBINARY or
 	 * LONGVARBINARY (depending on the argument's size relative to the driver's limits on VARBINARY values) when it
@@ -434,11 +695,8 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			setNull(parameterIndex, -1);
 			return;
 		}
-		StringBuilder hex = new StringBuilder(x.length * 2);
-		for (byte aX : x) {
-			hex.append(HEXES.charAt((aX & 0xF0) >> 4)).append(HEXES.charAt((aX & 0x0F)));
-		}
-		setValue(parameterIndex, "blob '" + hex.toString() + "'");
+		// copied natively into the blob argument
+		setObjectValue(parameterIndex, PARAM_BLOB, x);
 	}
 
 	/**
@@ -497,12 +755,9 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			setNull(parameterIndex, -1);
 			return;
 		}
-		if (cal == null) {
-			setValue(parameterIndex, "date '" + x.toString() + "'");
-		} else {
-			mDate.setTimeZone(cal.getTimeZone());
-			setValue(parameterIndex, "date '" + mDate.format(x) + "'");
-		}
+		// bound as the days since the epoch of the date in the calendar's time zone
+		LocalDate date = Instant.ofEpochMilli(x.getTime()).atZone(getZone(parameterIndex, cal)).toLocalDate();
+		setLongValue(parameterIndex, PARAM_DATE, date.toEpochDay());
 	}
 
 	/**
@@ -514,7 +769,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void setDouble(int parameterIndex, double x) throws MonetDBEmbeddedException {
-		setValue(parameterIndex, Double.toString(x));
+		setDoubleValue(parameterIndex, PARAM_DOUBLE, x);
 	}
 
 	/**
@@ -526,7 +781,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void setFloat(int parameterIndex, float x) throws MonetDBEmbeddedException {
-		setValue(parameterIndex, Float.toString(x));
+		setDoubleValue(parameterIndex, PARAM_REAL, x);
 	}
 
 	/**
@@ -538,7 +793,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void setInt(int parameterIndex, int x) throws MonetDBEmbeddedException {
-		setValue(parameterIndex, Integer.toString(x));
+		setLongValue(parameterIndex, PARAM_LONG, x);
 	}
 
 	/**
@@ -550,7 +805,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void setLong(int parameterIndex, long x) throws MonetDBEmbeddedException {
-		setValue(parameterIndex, Long.toString(x));
+		setLongValue(parameterIndex, PARAM_LONG, x);
 	}
 
 	/**
@@ -804,7 +1059,7 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 	 * @throws MonetDBEmbeddedException if a database access error occurs
 	 */
 	public void setShort(int parameterIndex, short x) throws MonetDBEmbeddedException {
-		setValue(parameterIndex, Short.toString(x));
+		setLongValue(parameterIndex, PARAM_LONG, x);
 	}
 
 	/**
@@ -823,8 +1078,8 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 		}
 		int paramIdx = getParamIdx(parameterIndex);	// this will throw a SQLException if parameter can not be found
 
-		/* depending on the parameter data type (as expected by MonetDB) we
-		   may need to add the data type as cast prefix to the parameter value */
+		/* depending on the parameter data type (as expected by MonetDB) the
+		   string is parsed into a typed value */
 		int targetSqlType = MonetDBToJavaMapping
 				.getJavaMappingFromMonetDBStringOrdinalValue(monetdbType[getParamIdx(parameterIndex)]);
 		String paramMonetdbType = monetdbType[paramIdx];
@@ -834,23 +1089,16 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			case 2: //VARCHAR:
 			case 3: //CLOB:
 			{
-				String castprefix = "";
-				switch (paramMonetdbType) {
-					// some MonetDB specific data types require a cast prefix
-					case "url":
-						try {
-							// also check if x represents a valid url string to prevent
-							// failing exec #(..., ...) calls which destroy the prepared statement, see bug 6351
-							java.net.URL url_obj = new java.net.URL(x);
-						} catch (java.net.MalformedURLException mue) {
-							throw new MonetDBEmbeddedException("Conversion of string: " + x + " to parameter data type " + paramMonetdbType + " failed. " + mue.getMessage());
-						}
-						castprefix = "url ";
-						break;
+				if ("url".equals(paramMonetdbType)) {
+					try {
+						// also check if x represents a valid url string to prevent a failing execution
+						java.net.URL url_obj = new java.net.URL(x);
+					} catch (java.net.MalformedURLException mue) {
+						throw new MonetDBEmbeddedException("Conversion of string: " + x + " to parameter data type " + paramMonetdbType + " failed. " + mue.getMessage());
+					}
 				}
-				/* in specific cases prefix the string with: inet or json or url or uuid */
-				setValue(parameterIndex,
-						castprefix + "'" + x.replaceAll("\\\\", "\\\\\\\\").replaceAll("'", "\\\\'") + "'");
+				// bound as is, inet, json, url and uuid parameters convert it natively
+				setObjectValue(parameterIndex, PARAM_STRING, x);
 				break;
 			}
 			case 4: //TINYINT
@@ -863,29 +1111,31 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			case 10: //DOUBLE
 			case 8: //DECIMAL
 				try {
-					// check (by calling parse) if the string represents a valid number to prevent
-					// failing exec #(..., ...) calls which destroy the prepared statement, see bug 6351
+					// parse the string into the typed value of the parameter
 					if (targetSqlType == 4) {
-						int number = Byte.parseByte(x);
+						setByte(parameterIndex, Byte.parseByte(x));
 					} else if (targetSqlType == 5 ) {
-						int number = Short.parseShort(x);
+						setShort(parameterIndex, Short.parseShort(x));
 					} else if (targetSqlType == 6 || targetSqlType == 11) {
-						int number = Integer.parseInt(x);
+						setInt(parameterIndex, Integer.parseInt(x));
 					} else if (targetSqlType == 7 || targetSqlType == 12) {
-						long number = Long.parseLong(x);
-					} else if (targetSqlType == 9 || targetSqlType == 10) {
-						double number = Double.parseDouble(x);
+						setLong(parameterIndex, Long.parseLong(x));
+					} else if (targetSqlType == 9) {
+						setFloat(parameterIndex, Float.parseFloat(x));
+					} else if (targetSqlType == 10) {
+						setDouble(parameterIndex, Double.parseDouble(x));
 					} else {
-						BigDecimal number = new BigDecimal(x);
+						setBigDecimal(parameterIndex, new BigDecimal(x));
 					}
 				} catch (NumberFormatException nfe) {
 					throw new MonetDBEmbeddedException("Conversion of string: " + x + " to parameter data type " + paramMonetdbType + " failed. " + nfe.getMessage());
 				}
-				setValue(parameterIndex, x);
 				break;
 			case 0:
-				if  (x.equalsIgnoreCase("false") || x.equalsIgnoreCase("true") || x.equals("0") || x.equals("1")) {
-					setValue(parameterIndex, x);
+				if  (x.equalsIgnoreCase("false") || x.equals("0")) {
+					setBoolean(parameterIndex, false);
+				} else if (x.equalsIgnoreCase("true") || x.equals("1")) {
+					setBoolean(parameterIndex, true);
 				} else {
 					throw new MonetDBEmbeddedException("Conversion of string: " + x + " to parameter data type " + paramMonetdbType + " failed");
 				}
@@ -896,37 +1146,33 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			case 16: //Types.TIMESTAMP:
 			case 17: //TIMESTAMPTZ:
 				try {
-					// check if the string represents a valid calendar date or time or timestamp to prevent
-					// failing exec #(..., ...) calls which destroy the prepared statement, see bug 6351
+					// parse the string into a calendar date or time or timestamp
 					if (targetSqlType == 15) {
-						java.sql.Date datum = java.sql.Date.valueOf(x);
+						setDate(parameterIndex, java.sql.Date.valueOf(x));
 					} else if (targetSqlType == 13 || targetSqlType == 14) {
-						Time tijdstip = Time.valueOf(x);
+						setTime(parameterIndex, Time.valueOf(x));
 					} else {
-						Timestamp tijdstip = Timestamp.valueOf(x);
+						setTimestamp(parameterIndex, Timestamp.valueOf(x));
 					}
 				} catch (IllegalArgumentException iae) {
 					throw new MonetDBEmbeddedException("Conversion of string: " + x + " to parameter data type " + paramMonetdbType + " failed. " + iae.getMessage());
 				}
-				/* prefix the string with: date or time or timetz or timestamp or timestamptz */
-				setValue(parameterIndex, paramMonetdbType + " '" + x + "'");
 				break;
 			case 18: //Blob:
-				// check if the string x contains pairs of hex chars to prevent
-				// failing exec #(..., ...) calls which destroy the prepared statement, see bug 6351
+				// the string x must contain pairs of hex chars
 				int xlen = x.length();
-				for (int i = 0; i < xlen; i++) {
-					char c = x.charAt(i);
-					if (c < '0' || c > '9') {
-						if (c < 'A' || c > 'F') {
-							if (c < 'a' || c > 'f') {
-								throw new MonetDBEmbeddedException("Invalid string for parameter data type " + paramMonetdbType + ". The string may contain only hex chars");
-							}
-						}
+				if (xlen % 2 != 0) {
+					throw new MonetDBEmbeddedException("Invalid string for parameter data type " + paramMonetdbType + ". The string must contain pairs of hex chars");
+				}
+				byte[] bytes = new byte[xlen / 2];
+				for (int i = 0; i < xlen; i += 2) {
+					int high = Character.digit(x.charAt(i), 16), low = Character.digit(x.charAt(i + 1), 16);
+					if (high < 0 || low < 0) {
+						throw new MonetDBEmbeddedException("Invalid string for parameter data type " + paramMonetdbType + ". The string may contain only hex chars");
 					}
+					bytes[i / 2] = (byte) ((high << 4) | low);
 				}
-				/* prefix the string with: blob */
-				setValue(parameterIndex, "blob '" + x + "'");
+				setBytes(parameterIndex, bytes);
 				break;
 			default:
 				throw new MonetDBEmbeddedException("Conversion of string to parameter data type " + paramMonetdbType + " is not (yet) supported");
@@ -965,24 +1211,9 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			setNull(index, -1);
 			return;
 		}
-
-		String MonetDBType = monetdbType[getParamIdx(index)];
-		boolean hasTimeZone = ("timetz".equals(MonetDBType) || "timestamptz".equals(MonetDBType));
-		if (hasTimeZone) {
-			// timezone shouldn't matter, since the server is timezone
-			// aware in this case
-			String RFC822 = mTimeZ.format(x);
-			setValue(index, "timetz '" + RFC822.substring(0, 15) + ":" + RFC822.substring(15) + "'");
-		} else {
-			// server is not timezone aware for this field, and no calendar given, since we told the server our
-			// timezone at connection creation, we can just write a plain timestamp here
-			if (cal == null) {
-				setValue(index, "time '" + x.toString() + "'");
-			} else {
-				mTime.setTimeZone(cal.getTimeZone());
-				setValue(index, "time '" + mTime.format(x) + "'");
-			}
-		}
+		// bound as the microseconds of the day, in UTC if the server is time zone aware for this parameter
+		LocalTime time = Instant.ofEpochMilli(x.getTime()).atZone(getZone(index, cal)).toLocalTime();
+		setLongValue(index, PARAM_TIME, time.toNanoOfDay() / 1000L);
 	}
 
 	/**
@@ -1017,26 +1248,10 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			setNull(index, -1);
 			return;
 		}
-
-		String MonetDBType = monetdbType[getParamIdx(index)];
-		boolean hasTimeZone = ("timestamptz".equals(MonetDBType) || "timetz".equals(MonetDBType));
-		if (hasTimeZone) {
-			// timezone shouldn't matter, since the server is timezone
-			// aware in this case
-			String RFC822 = mTimestampZ.format(x);
-			setValue(index, "timestamptz '" + RFC822.substring(0, 26) + ":" + RFC822.substring(26) + "'");
-		} else {
-			// server is not timezone aware for this field, and no
-			// calendar given, since we told the server our timezone at
-			// connection creation, we can just write a plain timestamp
-			// here
-			if (cal == null) {
-				setValue(index, "timestamp '" + x.toString() + "'");
-			} else {
-				mTimestamp.setTimeZone(cal.getTimeZone());
-				setValue(index, "timestamp '" + mTimestamp.format(x) + "'");
-			}
-		}
+		// bound as the microseconds since the epoch, in UTC if the server is time zone aware for this parameter
+		LocalDateTime timestamp = LocalDateTime.ofInstant(x.toInstant(), getZone(index, cal));
+		setLongValue(index, PARAM_TIMESTAMP, timestamp.toEpochSecond(ZoneOffset.UTC) * 1000000L +
+				timestamp.getNano() / 1000L);
 	}
 
 	/**
@@ -1052,9 +1267,8 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 			setNull(parameterIndex, -1);
 			return;
 		}
-		String val = x.toString();
-		setValue(parameterIndex, "url '" + val.replaceAll("\\\\", "\\\\\\\\")
-				.replaceAll("'", "\\\\'") + "'");
+		// converted natively to the type of the parameter
+		setObjectValue(parameterIndex, PARAM_STRING, x.toString());
 	}
 
 	/* helper for the anonymous class inside getMetaData */
@@ -1590,6 +1804,11 @@ public final class MonetDBEmbeddedPreparedStatement extends AbstractConnectionRe
 				this.freePreparedStatement(this.getConnection().connectionPointer, this.id);
 			} catch (MonetDBEmbeddedException ex) { }
 			this.id = 0;
+			for (String table : this.arrayTables) { //dropped directly, as going through the cache would clear it
+				try {
+					this.getConnection().dropTemporaryTable(table);
+				} catch (MonetDBEmbeddedException ex) { }
+			}
 		}
 	}
 }
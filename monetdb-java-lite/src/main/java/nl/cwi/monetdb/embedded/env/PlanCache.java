@@ -0,0 +1,402 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.env;
+
+import nl.cwi.monetdb.embedded.resultset.QueryResultSet;
+
+import java.math.BigDecimal;
+import java.sql.ParameterMetaData;
+import java.sql.SQLException;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+
+/**
+ * A per-connection cache of query plans. The literals of a query are extracted into parameters, so queries that
+ * differ only in their constants share the same key. The first time a key is seen, the parameterized query is
+ * prepared, and the following executions run the prepared plan with the extracted values, skipping the parsing,
+ * optimization and MAL compilation. Queries that cannot be prepared are remembered and executed directly.
+ * <br>
+ * Only literals after a comparison operator or directly inside a VALUES or IN list are extracted, leaving constants
+ * with a structural meaning (LIMIT, ORDER BY positions, type lengths) in the query text. A literal that would not
+ * keep its exact value as a parameter of the prepared type, such as a decimal with a larger scale or a string longer
+ * than the parameter, makes the query run directly, as does any failure to bind or execute the plan. The least
+ * recently used plans are evicted, and the whole cache is invalidated when the schema may have changed.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+final class PlanCache {
+
+	/** A query split into its cache key and the extracted literals */
+	private static final class ParameterizedQuery {
+
+		private final String key;
+
+		private final List<String> literals;
+
+		private ParameterizedQuery(String key, List<String> literals) {
+			this.key = key;
+			this.literals = literals;
+		}
+	}
+
+	/** Marks the keys whose queries could not be prepared */
+	private static final MonetDBEmbeddedPreparedStatement NOT_PREPARABLE = null;
+
+	private final MonetDBEmbeddedConnection connection;
+
+	private final int capacity;
+
+	/** The cached plans by key, in access order */
+	private final LinkedHashMap<String, MonetDBEmbeddedPreparedStatement> plans;
+
+	PlanCache(MonetDBEmbeddedConnection connection, int capacity) {
+		this.connection = connection;
+		this.capacity = capacity;
+		this.plans = new LinkedHashMap<String, MonetDBEmbeddedPreparedStatement>(16, 0.75f, true) {
+			@Override
+			protected boolean removeEldestEntry(Map.Entry<String, MonetDBEmbeddedPreparedStatement> eldest) {
+				if (this.size() > PlanCache.this.capacity) {
+					if (eldest.getValue() != null) {
+						eldest.getValue().close();
+					}
+					return true;
+				}
+				return false;
+			}
+		};
+	}
+
+	/**
+	 * Gets the maximum number of cached plans.
+	 *
+	 * @return The maximum number of cached plans
+	 */
+	int getCapacity() { return this.capacity; }
+
+	/**
+	 * Gets the number of cached plans.
+	 *
+	 * @return The number of cached plans
+	 */
+	int size() { return this.plans.size(); }
+
+	/**
+	 * Closes all the cached plans.
+	 */
+	void invalidate() {
+		for (MonetDBEmbeddedPreparedStatement next : this.plans.values()) {
+			if (next != null) {
+				next.close();
+			}
+		}
+		this.plans.clear();
+	}
+
+	/**
+	 * Tells if a query may change the schema or the name resolution, in which case the cached plans are invalidated.
+	 *
+	 * @param query The query text
+	 * @return If the query invalidates the cache
+	 */
+	static boolean invalidatesPlans(String query) {
+		String first = firstKeyword(query);
+		return first.equals("CREATE") || first.equals("DROP") || first.equals("ALTER") || first.equals("SET") ||
+				first.equals("GRANT") || first.equals("REVOKE") || first.equals("COMMENT") ||
+				first.equals("TRUNCATE") || first.equals("ROLLBACK");
+	}
+
+	/**
+	 * Executes a query with a result set through the cache.
+	 *
+	 * @param query The query text
+	 * @return The query result object, or null if the query must be executed directly
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	QueryResultSet executeQuery(String query) throws MonetDBEmbeddedException {
+		String first = firstKeyword(query);
+		if (!first.equals("SELECT") && !first.equals("WITH")) {
+			return null;
+		}
+		ParameterizedQuery parameterized = parameterize(query);
+		MonetDBEmbeddedPreparedStatement statement = this.bind(parameterized);
+		if (statement == null) {
+			return null;
+		}
+		try {
+			return statement.executeQuery();
+		} catch (MonetDBEmbeddedException ex) {
+			return this.fallBack(ex);
+		}
+	}
+
+	/**
+	 * Executes a data manipulation query through the cache.
+	 *
+	 * @param query The query text
+	 * @return The number of rows affected, or null if the query must be executed directly
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	Integer executeUpdate(String query) throws MonetDBEmbeddedException {
+		String first = firstKeyword(query);
+		if (!first.equals("INSERT") && !first.equals("UPDATE") && !first.equals("DELETE")) {
+			return null;
+		}
+		ParameterizedQuery parameterized = parameterize(query);
+		MonetDBEmbeddedPreparedStatement statement = this.bind(parameterized);
+		if (statement == null) {
+			return null;
+		}
+		try {
+			return statement.executeUpdate();
+		} catch (MonetDBEmbeddedException ex) {
+			return this.fallBack(ex);
+		}
+	}
+
+	/**
+	 * Decides what to do after a failed execution of a cached plan, which stays usable. The query runs directly
+	 * instead (null is returned), so it reports its own error if it fails again. A cancelled query is not run again,
+	 * and neither is one in a transaction of the client, as the failure already aborted it.
+	 */
+	private <T> T fallBack(MonetDBEmbeddedException ex) throws MonetDBEmbeddedException {
+		if (ex instanceof MonetDBEmbeddedCancelledException || !this.connection.getAutoCommit()) {
+			throw ex;
+		}
+		return null;
+	}
+
+	/**
+	 * Gets the cached plan of a query with its literals bound, preparing it if needed.
+	 */
+	private MonetDBEmbeddedPreparedStatement bind(ParameterizedQuery parameterized) {
+		MonetDBEmbeddedPreparedStatement statement;
+		if (this.plans.containsKey(parameterized.key)) {
+			statement = this.plans.get(parameterized.key);
+			if (statement == NOT_PREPARABLE) {
+				return null;
+			}
+		} else {
+			try {
+				statement = this.connection.prepareStatement(parameterized.key);
+			} catch (MonetDBEmbeddedException ex) {
+				statement = NOT_PREPARABLE;
+			}
+			this.plans.put(parameterized.key, statement);
+			if (statement == NOT_PREPARABLE) {
+				return null;
+			}
+		}
+		try {
+			ParameterMetaData metaData = statement.getParameterMetaData();
+			statement.clearParameters();
+			int i = 1;
+			for (String next : parameterized.literals) {
+				if (!fitsParameter(next, metaData.getParameterTypeName(i), metaData.getPrecision(i),
+						metaData.getScale(i))) {
+					return null;
+				}
+				statement.setString(i++, next);
+			}
+		} catch (MonetDBEmbeddedException | SQLException ex) {
+			return null; //the literal does not fit the inferred parameter type, so run the query as it is
+		}
+		return statement;
+	}
+
+	/**
+	 * Tells if a literal keeps its exact value as a parameter of the prepared type, which a decimal with more
+	 * fractional or integer digits, or a string longer than a char or varchar, would not.
+	 */
+	private static boolean fitsParameter(String literal, String type, int digits, int scale) {
+		switch (type) {
+			case "decimal":
+				try {
+					BigDecimal value = new BigDecimal(literal).stripTrailingZeros();
+					return value.scale() <= scale && value.precision() - value.scale() <= digits - scale;
+				} catch (NumberFormatException ex) {
+					return false;
+				}
+			case "char":
+			case "varchar":
+				return digits <= 0 || literal.codePointCount(0, literal.length()) <= digits;
+			default:
+				return true;
+		}
+	}
+
+	private static String firstKeyword(String query) {
+		int i = 0, length = query.length();
+		while (i < length && (Character.isWhitespace(query.charAt(i)) || query.charAt(i) == '(')) {
+			i++;
+		}
+		int start = i;
+		while (i < length && Character.isLetter(query.charAt(i))) {
+			i++;
+		}
+		return query.substring(start, i).toUpperCase(Locale.ENGLISH);
+	}
+
+	/**
+	 * Skips a quoted string or identifier, where a doubled quote and, in a string, a backslash escape the next
+	 * character.
+	 *
+	 * @param query The query text
+	 * @param start The position of the opening quote
+	 * @return The position after the closing quote, or -1 if it is missing
+	 */
+	static int skipQuoted(String query, int start) {
+		char quote = query.charAt(start);
+		int i = start + 1, length = query.length();
+		while (i < length) {
+			char next = query.charAt(i);
+			if (next == '\\' && quote == '\'') {
+				i += 2;
+			} else if (next != quote) {
+				i++;
+			} else if (i + 1 < length && query.charAt(i + 1) == quote) {
+				i += 2;
+			} else {
+				return i + 1;
+			}
+		}
+		return -1;
+	}
+
+	/**
+	 * Skips a line or block comment.
+	 *
+	 * @param query The query text
+	 * @param start The position to check
+	 * @return The position after the comment, or start if there is no comment there
+	 */
+	static int skipComment(String query, int start) {
+		int length = query.length();
+		if (start + 1 >= length) {
+			return start;
+		}
+		char c = query.charAt(start), next = query.charAt(start + 1);
+		if (c == '-' && next == '-') {
+			int end = query.indexOf('\n', start + 2);
+			return end < 0 ? length : end;
+		} else if (c == '/' && next == '*') {
+			int end = query.indexOf("*/", start + 2);
+			return end < 0 ? length : end + 2;
+		}
+		return start;
+	}
+
+	private static boolean isComparison(String token) {
+		switch (token) {
+			case "=":
+			case "<>":
+			case "!=":
+			case "<":
+			case ">":
+			case "<=":
+			case ">=":
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/**
+	 * Splits a query into its cache key and the literals to bind.
+	 */
+	private static ParameterizedQuery parameterize(String query) {
+		StringBuilder key = new StringBuilder(query.length());
+		List<String> literals = new ArrayList<>();
+		List<Boolean> listContexts = new ArrayList<>(); //if each open parenthesis starts a VALUES or IN list
+		String previous = ""; //the previous significant token, upper case for keywords
+		boolean inValues = false;
+		int i = 0, length = query.length();
+
+		while (i < length) {
+			char c = query.charAt(i);
+			int start = i;
+			if (Character.isWhitespace(c)) {
+				while (i < length && Character.isWhitespace(query.charAt(i))) i++;
+				key.append(query, start, i);
+				continue;
+			}
+			if ((i = skipComment(query, start)) > start) {
+				key.append(query, start, i);
+				continue;
+			}
+			boolean inList = !listContexts.isEmpty() && listContexts.get(listContexts.size() - 1);
+			boolean extractable = isComparison(previous) || (inList && (previous.equals("(") || previous.equals(",")));
+
+			if (c == '\'') {
+				int end = skipQuoted(query, start);
+				i = end < 0 ? length : end;
+				String value = end < 0 ? null : query.substring(start + 1, end - 1);
+				//backslash escapes are left in the query text
+				if (extractable && value != null && value.indexOf('\\') < 0) {
+					key.append('?');
+					literals.add(value.replace("''", "'"));
+				} else {
+					key.append(query, start, i);
+				}
+				previous = "'";
+			} else if (c == '"') {
+				int end = skipQuoted(query, start);
+				i = end < 0 ? length : end;
+				key.append(query, start, i);
+				previous = "\"";
+			} else if (Character.isDigit(c) || (c == '-' && extractable && i + 1 < length &&
+					Character.isDigit(query.charAt(i + 1)))) {
+				i++;
+				while (i < length && (Character.isLetterOrDigit(query.charAt(i)) || query.charAt(i) == '.' ||
+						((query.charAt(i) == '+' || query.charAt(i) == '-') &&
+								Character.toUpperCase(query.charAt(i - 1)) == 'E'))) {
+					i++;
+				}
+				if (extractable) {
+					key.append('?');
+					literals.add(query.substring(start, i));
+				} else {
+					key.append(query, start, i);
+				}
+				previous = "0";
+			} else if (Character.isLetter(c) || c == '_') {
+				while (i < length && (Character.isLetterOrDigit(query.charAt(i)) || query.charAt(i) == '_')) i++;
+				key.append(query, start, i);
+				String word = query.substring(start, i).toUpperCase(Locale.ENGLISH);
+				if (word.equals("VALUES")) {
+					inValues = true;
+				} else if (listContexts.isEmpty()) {
+					inValues = false; //only the rows of the VALUES clause are lists
+				}
+				previous = word;
+			} else {
+				if (c == '(') {
+					listContexts.add(previous.equals("VALUES") || previous.equals("IN") ||
+							(inValues && previous.equals(",")));
+					i++;
+				} else if (c == ')') {
+					if (!listContexts.isEmpty()) {
+						listContexts.remove(listContexts.size() - 1);
+					}
+					i++;
+				} else if ((c == '<' || c == '>' || c == '!') && i + 1 < length &&
+						(query.charAt(i + 1) == '=' || (c == '<' && query.charAt(i + 1) == '>'))) {
+					i += 2;
+				} else {
+					i++;
+				}
+				key.append(query, start, i);
+				previous = query.substring(start, i);
+			}
+		}
+		return new ParameterizedQuery(key.toString(), literals);
+	}
+}
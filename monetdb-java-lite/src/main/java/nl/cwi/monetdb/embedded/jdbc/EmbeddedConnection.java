@@ -104,6 +104,15 @@ public final class EmbeddedConnection extends MonetConnection {
 		return ((EmbeddedProtocol)protocol).getEmbeddedConnection();
 	}
 
+	/**
+	 * Cancels the query running on this connection from another thread, making it throw a SQLException. The
+	 * JDBC Statement's query timeout is enforced by the same mechanism, as the driver sets it with
+	 * {@code sys.settimeout}.
+	 */
+	public void cancelRunningQuery() {
+		((EmbeddedProtocol)protocol).getEmbeddedConnection().cancel();
+	}
+
 	/**
 	 * Connects to the existing database on the JVM process. If the database is not running, then it will start.
 	 * However if the database is already running in a different directory, a {@link MCLException} will be thrown.
@@ -156,6 +156,7 @@ public final class JDBCEmbeddedConnection extends MonetDBEmbeddedConnection {
 			query += ";";
 		}
 		this.currentLineResponseState = 0; //Important reset the currentLineResponseState back to 0!!!!
+		this.restoreQueryTimeout();
 		this.sendQueryInternal(this.connectionPointer, query, true);
 	}
 
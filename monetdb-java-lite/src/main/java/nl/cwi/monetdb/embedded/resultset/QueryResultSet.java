@@ -14,6 +14,7 @@ import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedException;
 import nl.cwi.monetdb.embedded.mapping.MonetDBRow;
 import nl.cwi.monetdb.embedded.mapping.MonetDBToJavaMapping;
 import nl.cwi.monetdb.embedded.mapping.NullMappings;
+import nl.cwi.monetdb.embedded.utils.StringEscaper;
 
 import java.lang.reflect.Array;
 import java.math.BigDecimal;
@@ -2502,6 +2503,87 @@ public strictfp class QueryResultSet extends AbstractConnectionResult implements
 		}
 	}
 
+	/**
+	 * Gets the SQL type definition of a column, as written in a CREATE TABLE statement.
+	 */
+	private static String getColumnTypeDefinition(String type, int digits, int scale) {
+		switch (type) {
+			case "decimal":
+				return "DECIMAL(" + digits + "," + scale + ")";
+			case "char":
+			case "varchar":
+				return digits > 0 ? type.toUpperCase() + "(" + digits + ")" : "CLOB";
+			case "time":
+			case "timestamp":
+				return digits > 1 ? type.toUpperCase() + "(" + (digits - 1) + ")" : type.toUpperCase();
+			case "timetz":
+				return (digits > 1 ? "TIME(" + (digits - 1) + ")" : "TIME") + " WITH TIME ZONE";
+			case "timestamptz":
+				return (digits > 1 ? "TIMESTAMP(" + (digits - 1) + ")" : "TIMESTAMP") + " WITH TIME ZONE";
+			case "month_interval":
+				return "INTERVAL MONTH";
+			case "sec_interval":
+				return "INTERVAL SECOND";
+			default:
+				return type.toUpperCase();
+		}
+	}
+
+	private native void materializeAsInternal(long structPointer, String schemaName, String tableName)
+			throws MonetDBEmbeddedException;
+
+	/**
+	 * Persists this result set into a new table with the same column names and types. The result's columns are
+	 * copied in bulk by the storage layer, without converting their values to Java, so the result set stays valid and
+	 * unaffected by later changes on the table. A temporary table lives in the {@code tmp} schema, keeps its rows
+	 * across transactions and is dropped when the connection is closed. If the rows cannot be appended, the table is
+	 * dropped.
+	 *
+	 * @param schemaName The schema of the table, or null for the current schema (or {@code tmp} if temporary)
+	 * @param tableName The name of the table
+	 * @param temporary If the table is a local temporary table
+	 * @throws MonetDBEmbeddedException If an error in the database occurred, including if the table already exists
+	 */
+	public void materializeAs(String schemaName, String tableName, boolean temporary)
+			throws MonetDBEmbeddedException {
+		this.checkQueryResultSetIsNotClosed();
+		MonetDBEmbeddedConnection connection = this.getConnection();
+		if (schemaName == null) {
+			schemaName = temporary ? "tmp" : connection.getSchema();
+		} else if (temporary && !schemaName.equals("tmp")) {
+			throw new MonetDBEmbeddedException("Temporary tables can only be created in the tmp schema");
+		}
+		String[] names = new String[this.numberOfColumns];
+		String[] types = new String[this.numberOfColumns];
+		int[] digits = new int[this.numberOfColumns];
+		int[] scales = new int[this.numberOfColumns];
+		this.getColumnNames(names);
+		this.getColumnTypes(types);
+		this.getColumnDigits(digits);
+		this.getColumnScales(scales);
+
+		String qualifiedName = StringEscaper.sqlIdentifierEscape(schemaName) + "." +
+				StringEscaper.sqlIdentifierEscape(tableName);
+		StringBuilder query = new StringBuilder(temporary ? "CREATE LOCAL TEMPORARY TABLE " : "CREATE TABLE ")
+				.append(qualifiedName).append(" (");
+		for (int i = 0; i < this.numberOfColumns; i++) {
+			query.append(i > 0 ? ", " : "").append(StringEscaper.sqlIdentifierEscape(names[i])).append(' ')
+					.append(getColumnTypeDefinition(types[i], digits[i], scales[i]));
+		}
+		query.append(temporary ? ") ON COMMIT PRESERVE ROWS;" : ");");
+		connection.executeUpdate(query.toString());
+		try {
+			this.materializeAsInternal(this.structPointer, schemaName, tableName);
+		} catch (MonetDBEmbeddedException | RuntimeException ex) {
+			try { //inside a user transaction the failure has already aborted it, so the drop fails as well
+				connection.executeUpdate("DROP TABLE " + qualifiedName + ";");
+			} catch (MonetDBEmbeddedException | RuntimeException dropEx) {
+				ex.addSuppressed(dropEx);
+			}
+			throw ex;
+		}
+	}
+
 	/**
 	 * Release the result set and BATs probably... set the pointers to 0!!
 	 */
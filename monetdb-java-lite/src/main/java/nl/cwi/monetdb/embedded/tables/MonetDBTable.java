@@ -11,11 +11,12 @@ package nl.cwi.monetdb.embedded.tables;
 import nl.cwi.monetdb.embedded.env.AbstractConnectionResult;
 import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedException;
 import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedConnection;
-import nl.cwi.monetdb.embedded.mapping.MonetDBRow;
 import nl.cwi.monetdb.embedded.mapping.MonetDBToJavaMapping;
 import nl.cwi.monetdb.embedded.resultset.QueryResultSet;
+import nl.cwi.monetdb.embedded.utils.StringEscaper;
 
 import java.math.BigDecimal;
+import java.util.List;
 
 /**
  * Java representation of a MonetDB table. It's possible to perform several CRUD operations using the respective
@@ -31,9 +32,18 @@ public final class MonetDBTable extends AbstractConnectionResult {
 	/** The table's name */
 	private final String tableName;
 
+	/** The default number of rows fetched at once while iterating the table */
+	public static final int DEFAULT_ITERATION_BATCH_SIZE = 4096;
+
 	/** The table's rounding mode for big decimals */
 	private int roundingMode = BigDecimal.ROUND_HALF_EVEN;
 
+	/**
+	 * The native descriptor with the table's resolved column metadata. It is resolved again only after a schema change
+	 * in the catalog, so the metadata methods and small appends skip the catalog lookup.
+	 */
+	private long descriptorPointer;
+
 	private MonetDBTable(MonetDBEmbeddedConnection connection, String tableSchema, String tableName) {
 		super(connection);
 		this.tableSchema = tableSchema;
@@ -44,22 +54,39 @@ public final class MonetDBTable extends AbstractConnectionResult {
 	public native int getNumberOfColumns() throws MonetDBEmbeddedException;
 
 	/**
-	 * Gets the current number of rows in the table, or -1 if an error in the database has occurred.
+	 * Gets the current number of rows in the table, or -1 if an error in the database has occurred. The count is read
+	 * from the storage layer, without running a query. A count larger than {@link Integer#MAX_VALUE} is clamped to
+	 * it, as the result sets count their rows in an int, while {@link #getTableStatistics()} has the exact count.
 	 *
-	 * @return The number of rows in the table.
+	 * @return The number of rows in the table, at most {@link Integer#MAX_VALUE}
 	 */
 	@Override
 	public int getNumberOfRows() {
-		int res;
 		try {
-			String query = "SELECT COUNT(*) FROM \"" + this.getTableSchema() + "\".\"" + this.getTableName() + "\";";
-			QueryResultSet eqr = this.getConnection().executeQuery(query);
-			res = (int) eqr.getLongByColumnIndexAndRow(1, 1);
-			eqr.close();
+			return (int) Math.min(this.getNumberOfRowsInternal(), Integer.MAX_VALUE);
 		} catch (MonetDBEmbeddedException ex) {
-			res = -1;
+			return -1;
 		}
-		return res;
+	}
+
+	/**
+	 * Gets the statistics of the table straight from the storage layer: the row counts, and for each column the null
+	 * and distinct counts, sortedness and minimum and maximum values that GDK already tracks. No query is run, so it
+	 * takes constant time regardless of the table size.
+	 *
+	 * @return The table statistics
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public MonetDBTableStatistics getTableStatistics() throws MonetDBEmbeddedException {
+		int numberOfColumns = this.getNumberOfColumns();
+		long[] deletedRows = new long[1];
+		long[] nilCounts = new long[numberOfColumns];
+		long[] distinctCounts = new long[numberOfColumns];
+		byte[] flags = new byte[numberOfColumns];
+		String[] minimums = new String[numberOfColumns];
+		String[] maximums = new String[numberOfColumns];
+		long rows = this.getTableStatisticsInternal(deletedRows, nilCounts, distinctCounts, flags, minimums, maximums);
+		return new MonetDBTableStatistics(rows, deletedRows[0], nilCounts, distinctCounts, flags, minimums, maximums);
 	}
 
 	protected native void getColumnNamesInternal(String[] input) throws MonetDBEmbeddedException;
@@ -195,9 +222,10 @@ public final class MonetDBTable extends AbstractConnectionResult {
 	 * Private method to check the limits of iteration.
 	 *
 	 * @param iterator The iterator to check
+	 * @param numberOfRows The number of rows in the table
 	 * @return An integer array with the limits fixed
 	 */
-	private int[] prepareIterator(IMonetDBTableBaseIterator iterator) {
+	private int[] prepareIterator(IMonetDBTableBaseIterator iterator, int numberOfRows) {
 		int[] res = {iterator.getFirstRowToIterate(), iterator.getLastRowToIterate()};
 		if(res[1] < res[0]) {
 			res[0] ^= res[1];
@@ -207,7 +235,6 @@ public final class MonetDBTable extends AbstractConnectionResult {
 		if (res[0] < 1) {
 			res[0] = 1;
 		}
-		int numberOfRows = this.getNumberOfRows();
 		if (res[1] >= numberOfRows) {
 			res[1] = numberOfRows;
 		}
@@ -215,31 +242,80 @@ public final class MonetDBTable extends AbstractConnectionResult {
 	}
 
 	/**
-	 * Iterate over the table using a {@link IMonetDBTableCursor} instance.
+	 * Iterate over the table using a {@link IMonetDBTableCursor} instance, fetching all the columns in batches of
+	 * {@link #DEFAULT_ITERATION_BATCH_SIZE} rows.
 	 *
 	 * @param cursor The iterator with the business logic
 	 * @return The number of rows iterated
 	 * @throws MonetDBEmbeddedException If an error in the database occurred
 	 */
 	public int iterateTable(IMonetDBTableCursor cursor) throws MonetDBEmbeddedException {
-		int[] limits = this.prepareIterator(cursor);
-		int res = 0;
-		String query = "SELECT * FROM \"" + this.getTableSchema() + "\".\"" + this.getTableName()
-				+ "\" LIMIT " + (limits[1] - limits[0] + 1) + " OFFSET " + (limits[0] - 1) + ";";
-
-		QueryResultSet eqr = this.getConnection().executeQuery(query);
-		MonetDBRow[] array = eqr.fetchAllRowValues().getAllRows();
-		eqr.close();
-		Object[][] data = new Object[eqr.getNumberOfRows()][this.getNumberOfColumns()];
-		for(int i = 0 ; i < eqr.getNumberOfRows() ; i++) {
-			data[i] = array[i].getAllColumns();
+		return this.iterateTable(cursor, null, DEFAULT_ITERATION_BATCH_SIZE);
+	}
+
+	/**
+	 * Iterate over the table using a {@link IMonetDBTableCursor} instance. The table's columns are scanned natively
+	 * on a snapshot of the current transaction, without running a query, and only the projected columns are fetched,
+	 * one batch at a time into reused buffers. The values of the columns not projected are null in the iterated rows.
+	 * <br>
+	 * The transaction stays open until the iteration ends, so the snapshot holds for all the batches. The statements
+	 * run on the same connection while iterating join this transaction, which in auto-commit mode is committed when
+	 * the iteration ends.
+	 *
+	 * @param cursor The iterator with the business logic
+	 * @param columns The indexes of the columns to fetch (starting from 1), or null to fetch all
+	 * @param batchSize The number of rows to fetch at once
+	 * @return The number of rows iterated
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public int iterateTable(IMonetDBTableCursor cursor, int[] columns, int batchSize)
+			throws MonetDBEmbeddedException {
+		if (batchSize < 1) {
+			throw new IllegalArgumentException("The batch size must be at least 1");
+		}
+		int numberOfColumns = this.getNumberOfColumns();
+		int[] projection;
+		if (columns == null) {
+			projection = new int[numberOfColumns];
+			for (int i = 0 ; i < numberOfColumns ; i++) {
+				projection[i] = i;
+			}
+		} else {
+			projection = new int[columns.length];
+			for (int i = 0 ; i < columns.length ; i++) {
+				if (columns[i] < 1 || columns[i] > numberOfColumns) {
+					throw new ArrayIndexOutOfBoundsException("The column index must be between 1 and " +
+							numberOfColumns);
+				}
+				projection[i] = columns[i] - 1;
+			}
 		}
 
-		RowIterator ri = new RowIterator(this, data, limits[0], limits[1]);
-		while(ri.hasMore()) {
-			cursor.processNextRow(ri);
-			ri.setNextIteration();
-			res++;
+		int[] numberOfRows = new int[1];
+		int[] typeIDs = new int[projection.length];
+		long cursorPointer = this.openCursorInternal(projection, numberOfRows, typeIDs);
+		int res = 0;
+		try {
+			int[] limits = this.prepareIterator(cursor, numberOfRows[0]);
+			int total = Math.max(limits[1] - limits[0] + 1, 0);
+			int batchLength = Math.max(Math.min(batchSize, total), 1);
+			Object[] buffers = new Object[projection.length];
+			for (int i = 0 ; i < projection.length ; i++) {
+				buffers[i] = RowIterator.createBuffer(typeIDs[i], batchLength);
+			}
+			RowIterator ri = new RowIterator(this, batchLength, limits[0], limits[1]);
+			while (res < total) {
+				int length = Math.min(batchLength, total - res);
+				this.fetchCursorBatchInternal(cursorPointer, limits[0] - 1 + res, length, buffers);
+				ri.setBatch(buffers, projection, typeIDs, length);
+				for (int i = 0 ; i < length ; i++) {
+					cursor.processNextRow(ri);
+					ri.setNextIteration();
+				}
+				res += length;
+			}
+		} finally {
+			this.closeCursorInternal(cursorPointer);
 		}
 		return res;
 	}
@@ -247,27 +323,466 @@ public final class MonetDBTable extends AbstractConnectionResult {
 	/**
 	 * Appends new rows to the table column-wise.
 	 *
+	 * Besides the {@link java.sql.Date}, {@link java.sql.Time} and {@link java.sql.Timestamp} arrays, temporal columns
+	 * also accept primitive arrays, which are converted natively without any per-row object: an {@code int[]} of days
+	 * since 1970-01-01 for a date column, a {@code long[]} of microseconds since midnight for a time column and a
+	 * {@code long[]} of microseconds since 1970-01-01 00:00:00 for a timestamp column. The int and long null constants
+	 * of {@link nl.cwi.monetdb.embedded.mapping.NullMappings} map to null.
+	 *
+	 * A decimal column also accepts a {@code long[]} of unscaled values already in the column's scale, see
+	 * {@link #appendColumns(Object[], int[])} for other scales.
+	 *
 	 * @param input An array of columns to append
 	 * @return The number of rows appended
 	 * @throws MonetDBEmbeddedException If an error in the database occurred
 	 */
 	public int appendColumns(Object[] input) throws MonetDBEmbeddedException {
+		return this.appendColumns(input, null);
+	}
+
+	/**
+	 * Appends new rows to the table column-wise, where decimal columns may be given as {@code long[]} of unscaled
+	 * values. The value {@code v} at scale {@code s} stands for {@code v * 10^-s}, and it is rescaled natively to the
+	 * column's scale using the table's rounding mode, without creating any {@link BigDecimal}.
+	 *
+	 * @param input An array of columns to append
+	 * @param decimalScales The scale of each unscaled decimal column in the input, indexed as the columns. If null,
+	 *                      the unscaled values are taken in the scale of the respective column
+	 * @return The number of rows appended
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public int appendColumns(Object[] input, int[] decimalScales) throws MonetDBEmbeddedException {
 		int numberOfColumns = this.getNumberOfColumns();
 		if (input.length != numberOfColumns) {
 			throw new ArrayStoreException("The number of columns between the input and the table is not consistent");
 		}
+		if (decimalScales != null && decimalScales.length != numberOfColumns) {
+			throw new ArrayStoreException("The number of decimal scales and columns is not consistent");
+		}
+		return this.appendColumnsInternal(input, decimalScales, this.roundingMode);
+	}
+
+	/**
+	 * Creates a row-oriented appender for this table, flushing every {@link TableAppender#DEFAULT_CHUNK_SIZE} rows.
+	 *
+	 * @return The appender instance
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public TableAppender createAppender() throws MonetDBEmbeddedException {
+		return new TableAppender(this, TableAppender.DEFAULT_CHUNK_SIZE);
+	}
+
+	/**
+	 * Creates a row-oriented appender for this table.
+	 *
+	 * @param chunkSize The number of rows buffered before each flush into the table
+	 * @return The appender instance
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public TableAppender createAppender(int chunkSize) throws MonetDBEmbeddedException {
+		return new TableAppender(this, chunkSize);
+	}
+
+	/**
+	 * Deletes rows of the table by their row ids, such as the ones of {@link #lookupRange(int, Object, Object)} or
+	 * {@link #lookupByKey(int, Object[])}, in a single transaction. The deletes are handed straight to the storage
+	 * layer without any SQL, so triggers are not fired. The rows of a table referenced by foreign keys cannot be
+	 * deleted this way. If the storage layer fails, the current transaction is aborted as by a failed statement: in
+	 * auto-commit mode only this call is rolled back, otherwise the whole transaction must be rolled back.
+	 *
+	 * @param rowIds The row ids of the rows to delete, which may be repeated
+	 * @return The number of rows deleted
+	 * @throws MonetDBEmbeddedException If an error in the database occurred, or a row id is not in the table
+	 */
+	public int deleteRows(long[] rowIds) throws MonetDBEmbeddedException {
+		return this.deleteRowsInternal(rowIds);
+	}
+
+	/**
+	 * Sets new values of a column for rows given by their row ids, in a single transaction. The new values are given
+	 * as a column array of the same classes as in {@link #appendColumns(Object[])}, converted natively and handed
+	 * straight to the storage layer without any SQL, so triggers are not fired. The columns of primary, unique and
+	 * foreign keys cannot be updated this way. If the storage layer fails, the current transaction is aborted as by
+	 * a failed statement: in auto-commit mode only this call is rolled back, otherwise the whole transaction must be
+	 * rolled back.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param rowIds The row ids of the rows to update, in any order, where a repeated row id takes its last value
+	 * @param newValues The new values, in the same order as the row ids
+	 * @return The number of distinct rows updated
+	 * @throws MonetDBEmbeddedException If an error in the database occurred, or a row id is not in the table
+	 */
+	public int updateColumn(int column, long[] rowIds, Object newValues) throws MonetDBEmbeddedException {
+		int numberOfColumns = this.getNumberOfColumns();
+		int index = this.checkScanColumn(column, numberOfColumns);
+		if (newValues == null || !newValues.getClass().isArray()) {
+			throw new IllegalArgumentException("The new values must be a column array");
+		}
+		return this.updateColumnInternal(index, rowIds, newValues, this.roundingMode);
+	}
+
+	/**
+	 * Scans the table natively with the projections and predicates of a {@link ScanSpec}, without generating nor
+	 * compiling any SQL. The predicates are evaluated one after the other with the GDK select operators, each one on
+	 * the candidates left by the previous ones, and only the projected columns of the selected rows are fetched. The
+	 * scan sees the table as in the current transaction.
+	 *
+	 * @param spec The scan specification
+	 * @return The projected columns of the selected rows
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public QueryResultSet scan(ScanSpec spec) throws MonetDBEmbeddedException {
+		int numberOfColumns = this.getNumberOfColumns();
+		int[] columns = this.getScanProjection(spec.getProjection(), numberOfColumns);
+		MonetDBToJavaMapping[] mappings = new MonetDBToJavaMapping[numberOfColumns];
+		this.getMappings(mappings);
+		int[] scales = new int[numberOfColumns];
+		this.getColumnScales(scales);
+		List<ScanSpec.Predicate> predicates = spec.getPredicates();
+		int[] predicateColumns = new int[predicates.size()];
+		int[] predicateKinds = new int[predicates.size()];
+		byte[] predicateFlags = new byte[predicates.size()];
+		Object[] predicateValues = new Object[predicates.size()];
+		for (int i = 0 ; i < predicateColumns.length ; i++) {
+			ScanSpec.Predicate next = predicates.get(i);
+			int column = this.checkScanColumn(next.column, numberOfColumns);
+			if (mappings[column] == MonetDBToJavaMapping.Blob) {
+				throw new IllegalArgumentException("Blob columns cannot be used in scan predicates");
+			}
+			String[] values = new String[next.values.length];
+			for (int j = 0 ; j < values.length ; j++) {
+				values[j] = this.toScanValue(next.values[j], mappings[column], scales[column]);
+			}
+			predicateColumns[i] = column;
+			predicateKinds[i] = next.kind;
+			predicateFlags[i] = next.flags;
+			predicateValues[i] = values;
+		}
+		QueryResultSet res = this.scanInternal(columns, predicateColumns, predicateKinds, predicateFlags,
+				predicateValues);
+		this.registerResult(res);
+		return res;
+	}
+
+	/**
+	 * Looks up the rows whose values of a column are in an inclusive range, without projecting any column.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param low The lower bound, or null if unbounded
+	 * @param high The upper bound, or null if unbounded
+	 * @return The rows matched
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public MonetDBTableRange lookupRange(int column, Object low, Object high) throws MonetDBEmbeddedException {
+		return this.lookupRange(column, low, high, null);
+	}
+
+	/**
+	 * Looks up the rows whose values of a column are in an inclusive range, as in {@code column BETWEEN low AND high},
+	 * and fetches the projected columns of those rows. When the column is sorted, the range is found with a binary
+	 * search for each bound, so the row ids are known without reading the column. Otherwise the range is selected
+	 * with GDK, which uses the column's ordered index if there is one (see {@link #createOrderedIndex(int)}). The
+	 * nulls are never matched. The lookup sees the table as in the current transaction.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param low The lower bound, or null if unbounded
+	 * @param high The upper bound, or null if unbounded
+	 * @param projection The indexes of the columns to fetch (starting from 1), or null to fetch none
+	 * @return The rows matched
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public MonetDBTableRange lookupRange(int column, Object low, Object high, int[] projection)
+			throws MonetDBEmbeddedException {
+		int numberOfColumns = this.getNumberOfColumns();
+		int index = this.checkScanColumn(column, numberOfColumns);
+		int[] columns = projection == null ? null : this.getScanProjection(projection, numberOfColumns);
 		MonetDBToJavaMapping[] mappings = new MonetDBToJavaMapping[numberOfColumns];
 		this.getMappings(mappings);
-		int[] javaIndexes = new int[numberOfColumns];
-		for (int i = 0; i < mappings.length; i++) {
-			javaIndexes[i] = mappings[i].ordinal();
+		if (mappings[index] == MonetDBToJavaMapping.Blob) {
+			throw new IllegalArgumentException("Blob columns cannot be looked up");
+		}
+		int[] scales = new int[numberOfColumns];
+		this.getColumnScales(scales);
+
+		long[] bounds = new long[2];
+		long[][] rowIds = new long[1][];
+		QueryResultSet res = this.lookupRangeInternal(index, this.toScanValue(low, mappings[index], scales[index]),
+				this.toScanValue(high, mappings[index], scales[index]), columns, bounds, rowIds);
+		if (res != null) {
+			this.registerResult(res);
 		}
-		return this.appendColumnsInternal(input, javaIndexes, this.roundingMode);
+		return new MonetDBTableRange(bounds[0], bounds[1], rowIds[0], res);
+	}
+
+	/**
+	 * Looks up the rows whose values of a column are equal to any of the given keys, without projecting any column.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param keys The keys to look up
+	 * @return The rows matched
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public MonetDBTableLookup lookupByKey(int column, Object[] keys) throws MonetDBEmbeddedException {
+		return this.lookupByKey(column, keys, null);
+	}
+
+	/**
+	 * Looks up in bulk the rows whose values of a column are equal to any of the given keys, and fetches the projected
+	 * columns of those rows. Each key is probed in the GDK hash of the column, which is built on the first lookup and
+	 * then kept with the stored column for the next ones, so a lookup costs a hash probe per key and a single native
+	 * call. The hash is rebuilt on every lookup while the table has pending inserts or updates in the current
+	 * transaction. Null keys never match.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param keys The keys to look up
+	 * @param projection The indexes of the columns to fetch (starting from 1), or null to fetch none
+	 * @return The rows matched
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public MonetDBTableLookup lookupByKey(int column, Object[] keys, int[] projection)
+			throws MonetDBEmbeddedException {
+		int numberOfColumns = this.getNumberOfColumns();
+		int index = this.checkScanColumn(column, numberOfColumns);
+		int[] columns = projection == null ? null : this.getScanProjection(projection, numberOfColumns);
+		MonetDBToJavaMapping[] mappings = new MonetDBToJavaMapping[numberOfColumns];
+		this.getMappings(mappings);
+		if (mappings[index] == MonetDBToJavaMapping.Blob) {
+			throw new IllegalArgumentException("Blob columns cannot be looked up");
+		}
+		int[] scales = new int[numberOfColumns];
+		this.getColumnScales(scales);
+
+		String[] values = new String[keys.length];
+		for (int i = 0 ; i < keys.length ; i++) {
+			values[i] = this.toScanValue(keys[i], mappings[index], scales[index]);
+		}
+		Object[] positions = new Object[2];
+		QueryResultSet res = this.lookupByKeyInternal(index, values, columns, positions);
+		if (res != null) {
+			this.registerResult(res);
+		}
+		return new MonetDBTableLookup((long[]) positions[0], (int[]) positions[1], res);
+	}
+
+	private int[] getScanProjection(int[] projection, int numberOfColumns) {
+		int[] columns;
+		if (projection == null) {
+			columns = new int[numberOfColumns];
+			for (int i = 0 ; i < numberOfColumns ; i++) {
+				columns[i] = i;
+			}
+		} else {
+			columns = new int[projection.length];
+			for (int i = 0 ; i < projection.length ; i++) {
+				columns[i] = this.checkScanColumn(projection[i], numberOfColumns);
+			}
+		}
+		return columns;
+	}
+
+	private int checkScanColumn(int column, int numberOfColumns) {
+		if (column < 1 || column > numberOfColumns) {
+			throw new ArrayIndexOutOfBoundsException("The column index must be between 1 and " + numberOfColumns);
+		}
+		return column - 1;
+	}
+
+	/**
+	 * Converts a scan predicate value to the String parsed natively. The decimals are given unscaled in the column's
+	 * scale.
+	 */
+	private String toScanValue(Object value, MonetDBToJavaMapping mapping, int scale) {
+		if (value == null) {
+			return null;
+		}
+		if (mapping == MonetDBToJavaMapping.Decimal) {
+			BigDecimal decimal = value instanceof BigDecimal ? (BigDecimal) value : new BigDecimal(value.toString());
+			return decimal.setScale(scale, this.roundingMode).unscaledValue().toString();
+		}
+		return value.toString();
+	}
+
+	/**
+	 * Creates an ordered index on a column, named after the table and the column.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void createOrderedIndex(int column) throws MonetDBEmbeddedException {
+		this.createIndex(null, column, MonetDBTableIndex.IndexType.Ordered);
+	}
+
+	/**
+	 * Creates an ordered index on a column, as in {@code CREATE ORDERED INDEX}. The GDK order index is built right
+	 * away instead of lazily, and it is persisted with the column in an on-disk database.
+	 *
+	 * @param indexName The name of the index
+	 * @param column The column index (starting from 1)
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void createOrderedIndex(String indexName, int column) throws MonetDBEmbeddedException {
+		this.createIndex(indexName, column, MonetDBTableIndex.IndexType.Ordered);
+	}
+
+	/**
+	 * Creates an imprints index on a column, named after the table and the column.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void createImprints(int column) throws MonetDBEmbeddedException {
+		this.createIndex(null, column, MonetDBTableIndex.IndexType.Imprints);
+	}
+
+	/**
+	 * Creates an imprints index on a column, as in {@code CREATE IMPRINTS INDEX}. The column imprints are built right
+	 * away instead of on the first range selection, and they are persisted with the column in an on-disk database.
+	 * Only fixed size numeric and temporal columns can have imprints.
+	 *
+	 * @param indexName The name of the index
+	 * @param column The column index (starting from 1)
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void createImprints(String indexName, int column) throws MonetDBEmbeddedException {
+		this.createIndex(indexName, column, MonetDBTableIndex.IndexType.Imprints);
+	}
+
+	private void createIndex(String indexName, int column, MonetDBTableIndex.IndexType type)
+			throws MonetDBEmbeddedException {
+		MonetDBTableColumn metadata = this.getColumnMetadataByIndex(column);
+		if (metadata == null) {
+			throw new ArrayIndexOutOfBoundsException("The column index must be between 1 and " +
+					this.getNumberOfColumns());
+		}
+		boolean ordered = type == MonetDBTableIndex.IndexType.Ordered;
+		if (indexName == null) {
+			indexName = this.tableName + "_" + metadata.getColumnName() + (ordered ? "_oidx" : "_imprints");
+		}
+		this.getConnection().executeUpdate("CREATE " + (ordered ? "ORDERED" : "IMPRINTS") + " INDEX " +
+				StringEscaper.sqlIdentifierEscape(indexName) + " ON " + this.getQualifiedName() + " (" +
+				StringEscaper.sqlIdentifierEscape(metadata.getColumnName()) + ");");
+		this.buildIndexInternal(column - 1, type.ordinal());
+	}
+
+	/**
+	 * Drops an index of this table, releasing its GDK structures.
+	 *
+	 * @param indexName The name of the index
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void dropIndex(String indexName) throws MonetDBEmbeddedException {
+		this.destroyIndexInternal(indexName);
+		this.getConnection().executeUpdate("DROP INDEX " + StringEscaper.sqlIdentifierEscape(this.tableSchema) +
+				"." + StringEscaper.sqlIdentifierEscape(indexName) + ";");
+	}
+
+	/**
+	 * Lists the indexes of this table, including the ones of primary, unique and foreign keys.
+	 *
+	 * @return The indexes of this table
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public MonetDBTableIndex[] listIndexes() throws MonetDBEmbeddedException {
+		int numberOfIndexes = this.getNumberOfIndexesInternal();
+		String[] names = new String[numberOfIndexes];
+		int[] types = new int[numberOfIndexes];
+		boolean[] built = new boolean[numberOfIndexes];
+		String[][] columns = new String[numberOfIndexes][];
+		this.getIndexesInternal(names, types, built, columns);
+		MonetDBTableIndex.IndexType[] values = MonetDBTableIndex.IndexType.values();
+		MonetDBTableIndex[] res = new MonetDBTableIndex[numberOfIndexes];
+		for (int i = 0 ; i < numberOfIndexes ; i++) {
+			res[i] = new MonetDBTableIndex(names[i], values[types[i]], columns[i], built[i]);
+		}
+		return res;
+	}
+
+	private String getQualifiedName() {
+		return StringEscaper.sqlIdentifierEscape(this.tableSchema) + "." +
+				StringEscaper.sqlIdentifierEscape(this.tableName);
+	}
+
+	/**
+	 * Starts an asynchronous ingestion service for this table, with its own connection and writer thread.
+	 *
+	 * @param capacity The maximum number of rows queued, after which the producers are blocked
+	 * @param maxTransactionRows The maximum number of rows appended by the writer in a single transaction
+	 * @return The ingestion service instance
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public TableIngestionService createIngestionService(int capacity, int maxTransactionRows)
+			throws MonetDBEmbeddedException {
+		return new TableIngestionService(this, capacity, maxTransactionRows, null);
+	}
+
+	/**
+	 * Starts an asynchronous ingestion service for this table, with its own connection and writer thread.
+	 *
+	 * @param capacity The maximum number of rows queued, after which the producers are blocked
+	 * @param maxTransactionRows The maximum number of rows appended by the writer in a single transaction
+	 * @param decimalScales The scale of each unscaled decimal column in the batches, see
+	 *                      {@link #appendColumns(Object[], int[])}
+	 * @return The ingestion service instance
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public TableIngestionService createIngestionService(int capacity, int maxTransactionRows, int[] decimalScales)
+			throws MonetDBEmbeddedException {
+		return new TableIngestionService(this, capacity, maxTransactionRows, decimalScales);
 	}
 
 	@Override
-	protected void closeResultImplementation() {} //Do Nothing!!!
+	protected void closeResultImplementation() {
+		if (this.descriptorPointer != 0) {
+			this.freeTableDescriptorInternal();
+		}
+	}
 
-	private native int appendColumnsInternal(Object[] data, int[] javaIndexes, int roundingMode)
+	@Override
+	public void close() {
+		super.close();
+		this.closeResultImplementation();
+	}
+
+	private native int appendColumnsInternal(Object[] data, int[] decimalScales, int roundingMode)
+			throws MonetDBEmbeddedException;
+
+	private native void freeTableDescriptorInternal();
+
+	private native int getNumberOfIndexesInternal() throws MonetDBEmbeddedException;
+
+	private native void getIndexesInternal(String[] names, int[] types, boolean[] built, String[][] columns)
+			throws MonetDBEmbeddedException;
+
+	private native void buildIndexInternal(int column, int type) throws MonetDBEmbeddedException;
+
+	private native void destroyIndexInternal(String indexName) throws MonetDBEmbeddedException;
+
+	private native QueryResultSet scanInternal(int[] projection, int[] predicateColumns, int[] predicateKinds,
+											   byte[] predicateFlags, Object[] predicateValues)
+			throws MonetDBEmbeddedException;
+
+	private native QueryResultSet lookupRangeInternal(int column, String low, String high, int[] projection,
+													  long[] bounds, long[][] rowIds) throws MonetDBEmbeddedException;
+
+	private native QueryResultSet lookupByKeyInternal(int column, String[] keys, int[] projection, Object[] positions)
+			throws MonetDBEmbeddedException;
+
+	private native int deleteRowsInternal(long[] rowIds) throws MonetDBEmbeddedException;
+
+	private native int updateColumnInternal(int column, long[] rowIds, Object values, int roundingMode)
+			throws MonetDBEmbeddedException;
+
+	private native long getNumberOfRowsInternal() throws MonetDBEmbeddedException;
+
+	private native long getTableStatisticsInternal(long[] deletedRows, long[] nilCounts, long[] distinctCounts,
+												   byte[] flags, String[] minimums, String[] maximums)
+			throws MonetDBEmbeddedException;
+
+	private native long openCursorInternal(int[] columns, int[] numberOfRows, int[] typeIDs)
 			throws MonetDBEmbeddedException;
+
+	private native void fetchCursorBatchInternal(long cursorPointer, int first, int size, Object[] buffers)
+			throws MonetDBEmbeddedException;
+
+	private native void closeCursorInternal(long cursorPointer);
 }
@@ -0,0 +1,82 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.tables;
+
+/**
+ * Java representation of an index on a MonetDB table, as listed by {@link MonetDBTable#listIndexes()}.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public final class MonetDBTableIndex {
+
+	/**
+	 * The index types.
+	 */
+	public enum IndexType {
+		/* PLEASE Don't change the enum values order, it's the same as in the native side!! */
+		/** The hash index of a primary or unique key */
+		Hash,
+		/** The join index of a foreign key */
+		Join,
+		/** An ordered index, built with the GDK order index */
+		Ordered,
+		/** A column imprints index */
+		Imprints,
+		/** Any other index type */
+		Other
+	}
+
+	/** The name of the index */
+	private final String name;
+
+	/** The type of the index */
+	private final IndexType type;
+
+	/** The indexed columns */
+	private final String[] columnNames;
+
+	/** If the GDK structure of the index is built */
+	private final boolean built;
+
+	MonetDBTableIndex(String name, IndexType type, String[] columnNames, boolean built) {
+		this.name = name;
+		this.type = type;
+		this.columnNames = columnNames;
+		this.built = built;
+	}
+
+	/**
+	 * Gets the name of the index.
+	 *
+	 * @return The name of the index
+	 */
+	public String getName() { return this.name; }
+
+	/**
+	 * Gets the type of the index.
+	 *
+	 * @return The type of the index
+	 */
+	public IndexType getType() { return this.type; }
+
+	/**
+	 * Gets the names of the indexed columns.
+	 *
+	 * @return The names of the indexed columns
+	 */
+	public String[] getColumnNames() { return this.columnNames.clone(); }
+
+	/**
+	 * Tells if the ordered index or imprints are currently built on the stored column. The other index types are
+	 * maintained by the engine, so it's always false for them.
+	 *
+	 * @return If the GDK structure of the index is built
+	 */
+	public boolean isBuilt() { return this.built; }
+}
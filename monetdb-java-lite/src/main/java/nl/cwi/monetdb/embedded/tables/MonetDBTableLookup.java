@@ -0,0 +1,64 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.tables;
+
+import nl.cwi.monetdb.embedded.resultset.QueryResultSet;
+
+/**
+ * The rows of a MonetDB table matched by {@link MonetDBTable#lookupByKey(int, Object[], int[])}. Each matched row
+ * has its row id, i.e. its position in the stored columns, and the index of the key it matched. The rows are grouped
+ * by key in the order of the keys, and by ascending row id within each key. A key without a match has no rows.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public final class MonetDBTableLookup {
+
+	/** The row ids of the rows matched */
+	private final long[] rowIds;
+
+	/** The index of the key matched by each row */
+	private final int[] keyIndexes;
+
+	/** The projected columns of the rows, or null if none were projected */
+	private final QueryResultSet columns;
+
+	MonetDBTableLookup(long[] rowIds, int[] keyIndexes, QueryResultSet columns) {
+		this.rowIds = rowIds;
+		this.keyIndexes = keyIndexes;
+		this.columns = columns;
+	}
+
+	/**
+	 * Gets the number of rows matched.
+	 *
+	 * @return The number of rows
+	 */
+	public int getNumberOfRows() { return this.rowIds.length; }
+
+	/**
+	 * Gets the row ids of the rows matched.
+	 *
+	 * @return The row ids
+	 */
+	public long[] getRowIds() { return this.rowIds.clone(); }
+
+	/**
+	 * Gets the index in the looked up keys of the key matched by each row.
+	 *
+	 * @return The key indexes (starting from 0)
+	 */
+	public int[] getKeyIndexes() { return this.keyIndexes.clone(); }
+
+	/**
+	 * Gets the projected columns of the rows matched, in the same order as the row ids.
+	 *
+	 * @return The projected columns, or null if none were projected
+	 */
+	public QueryResultSet getColumns() { return this.columns; }
+}
@@ -0,0 +1,93 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.tables;
+
+import nl.cwi.monetdb.embedded.resultset.QueryResultSet;
+
+/**
+ * The rows of a MonetDB table matched by {@link MonetDBTable#lookupRange(int, Object, Object, int[])}. The rows are
+ * identified by their row ids, i.e. their positions in the stored columns, including the deleted rows before them.
+ * When the matched rows are contiguous, only the bounds of the range are kept.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public final class MonetDBTableRange {
+
+	/** The first row id */
+	private final long firstRowId;
+
+	/** The row id after the last one */
+	private final long lastRowId;
+
+	/** The row ids, or null if contiguous */
+	private final long[] rowIds;
+
+	/** The projected columns of the rows, or null if none were projected */
+	private final QueryResultSet columns;
+
+	MonetDBTableRange(long firstRowId, long lastRowId, long[] rowIds, QueryResultSet columns) {
+		this.firstRowId = firstRowId;
+		this.lastRowId = lastRowId;
+		this.rowIds = rowIds;
+		this.columns = columns;
+	}
+
+	/**
+	 * Gets the number of rows matched.
+	 *
+	 * @return The number of rows
+	 */
+	public int getNumberOfRows() {
+		return this.rowIds != null ? this.rowIds.length : (int) (this.lastRowId - this.firstRowId);
+	}
+
+	/**
+	 * Tells if the matched rows have contiguous row ids.
+	 *
+	 * @return If the rows are contiguous
+	 */
+	public boolean isContiguous() { return this.rowIds == null; }
+
+	/**
+	 * Gets the row id of the first row matched.
+	 *
+	 * @return The first row id
+	 */
+	public long getFirstRowId() { return this.firstRowId; }
+
+	/**
+	 * Gets the row id after the last row matched, so an empty range has the same first and last row ids.
+	 *
+	 * @return The row id after the last one
+	 */
+	public long getLastRowId() { return this.lastRowId; }
+
+	/**
+	 * Gets the row ids of the rows matched, in ascending order.
+	 *
+	 * @return The row ids
+	 */
+	public long[] getRowIds() {
+		if (this.rowIds != null) {
+			return this.rowIds.clone();
+		}
+		long[] res = new long[(int) (this.lastRowId - this.firstRowId)];
+		for (int i = 0 ; i < res.length ; i++) {
+			res[i] = this.firstRowId + i;
+		}
+		return res;
+	}
+
+	/**
+	 * Gets the projected columns of the rows matched, in the order of the row ids.
+	 *
+	 * @return The projected columns, or null if none were projected
+	 */
+	public QueryResultSet getColumns() { return this.columns; }
+}
@@ -0,0 +1,157 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.tables;
+
+/**
+ * A snapshot of the statistics of a MonetDB table, read straight from the storage layer without running a query.
+ * The row counts are always exact. The column properties are the ones GDK already tracks on the stored columns, so
+ * they are only known while the table has no pending deletes or updates in the current transaction, and each of them
+ * may still be unknown if GDK has not derived it yet.
+ * <br>
+ * The columns are indexed from 1, as in {@link MonetDBTable#getColumnMetadataByIndex(int)}.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public final class MonetDBTableStatistics {
+
+	/** The column property flags, the same as in the native side */
+	static final byte STATS_KNOWN = 1;
+	static final byte STATS_SORTED = 2;
+	static final byte STATS_REVSORTED = 4;
+	static final byte STATS_KEY = 8;
+	static final byte STATS_NONIL = 16;
+
+	/** The number of visible rows */
+	private final long numberOfRows;
+
+	/** The number of deleted rows still stored */
+	private final long numberOfDeletedRows;
+
+	/** The number of nulls of each column, -1 if unknown */
+	private final long[] nilCounts;
+
+	/** The number of distinct values of each column, -1 if unknown */
+	private final long[] distinctCounts;
+
+	/** The property flags of each column */
+	private final byte[] flags;
+
+	/** The minimum value of each column as a String, or null if unknown */
+	private final String[] minimums;
+
+	/** The maximum value of each column as a String, or null if unknown */
+	private final String[] maximums;
+
+	MonetDBTableStatistics(long numberOfRows, long numberOfDeletedRows, long[] nilCounts, long[] distinctCounts,
+						   byte[] flags, String[] minimums, String[] maximums) {
+		this.numberOfRows = numberOfRows;
+		this.numberOfDeletedRows = numberOfDeletedRows;
+		this.nilCounts = nilCounts;
+		this.distinctCounts = distinctCounts;
+		this.flags = flags;
+		this.minimums = minimums;
+		this.maximums = maximums;
+	}
+
+	/**
+	 * Gets the number of rows visible in the table.
+	 *
+	 * @return The number of rows
+	 */
+	public long getNumberOfRows() { return this.numberOfRows; }
+
+	/**
+	 * Gets the number of deleted rows still kept in the storage.
+	 *
+	 * @return The number of deleted rows
+	 */
+	public long getNumberOfDeletedRows() { return this.numberOfDeletedRows; }
+
+	/**
+	 * Gets the number of columns.
+	 *
+	 * @return The number of columns
+	 */
+	public int getNumberOfColumns() { return this.flags.length; }
+
+	private int checkColumn(int column) {
+		if (column < 1 || column > this.flags.length) {
+			throw new ArrayIndexOutOfBoundsException("The column index must be between 1 and " + this.flags.length);
+		}
+		return column - 1;
+	}
+
+	/**
+	 * Tells if the properties of a column are known, i.e. the table has no pending deletes or updates.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return If the column properties are known
+	 */
+	public boolean areColumnPropertiesKnown(int column) {
+		return (this.flags[this.checkColumn(column)] & STATS_KNOWN) != 0;
+	}
+
+	/**
+	 * Tells if a column is known to be sorted in ascending order.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return If the column is sorted, false if unknown
+	 */
+	public boolean isSorted(int column) { return (this.flags[this.checkColumn(column)] & STATS_SORTED) != 0; }
+
+	/**
+	 * Tells if a column is known to be sorted in descending order.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return If the column is reverse sorted, false if unknown
+	 */
+	public boolean isReverseSorted(int column) {
+		return (this.flags[this.checkColumn(column)] & STATS_REVSORTED) != 0;
+	}
+
+	/**
+	 * Tells if the values of a column are known to be unique.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return If the values are unique, false if unknown
+	 */
+	public boolean isUnique(int column) { return (this.flags[this.checkColumn(column)] & STATS_KEY) != 0; }
+
+	/**
+	 * Gets the number of nulls in a column.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return The number of nulls, -1 if unknown
+	 */
+	public long getNilCount(int column) { return this.nilCounts[this.checkColumn(column)]; }
+
+	/**
+	 * Gets the number of distinct values in a column.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return The number of distinct values, -1 if unknown
+	 */
+	public long getDistinctCount(int column) { return this.distinctCounts[this.checkColumn(column)]; }
+
+	/**
+	 * Gets the minimum value of a column, formatted as MonetDB does.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return The minimum value, null if unknown
+	 */
+	public String getMinimum(int column) { return this.minimums[this.checkColumn(column)]; }
+
+	/**
+	 * Gets the maximum value of a column, formatted as MonetDB does.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return The maximum value, null if unknown
+	 */
+	public String getMaximum(int column) { return this.maximums[this.checkColumn(column)]; }
+}
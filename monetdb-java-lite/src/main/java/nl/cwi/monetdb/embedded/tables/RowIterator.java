@@ -11,6 +11,9 @@ package nl.cwi.monetdb.embedded.tables;
 import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedException;
 import nl.cwi.monetdb.embedded.mapping.AbstractRowSet;
 import nl.cwi.monetdb.embedded.mapping.MonetDBRow;
+import nl.cwi.monetdb.embedded.mapping.NullMappings;
+
+import java.util.Arrays;
 
 /**
  * The iterator class for a MonetDB table. It's possible to inspect the current currentColumns in the row as well
@@ -35,10 +38,51 @@ public final class RowIterator extends AbstractRowSet {
 	 */
 	private final int lastIndex;
 
+	/**
+	 * The iteration number of the first row in the current batch.
+	 */
+	private int batchStart = 0;
+
+	/**
+	 * The values of each projected column in the current batch, in primitive arrays for the numeric types.
+	 */
+	private Object[] buffers;
+
+	/**
+	 * The index of each projected column in the table (starting from 0).
+	 */
+	private int[] projection;
+
+	/**
+	 * The type ID of each projected column.
+	 */
+	private int[] typeIDs;
+
+	/**
+	 * The rows of the current batch whose values were already converted to Java objects.
+	 */
+	private final boolean[] loaded;
+
+	/**
+	 * The null values of the primitive buffers, read once from {@link NullMappings}.
+	 */
+	private final byte booleanNull = NullMappings.getBooleanNullConstant();
+	private final byte byteNull = NullMappings.getByteNullConstant();
+	private final short shortNull = NullMappings.getShortNullConstant();
+	private final int intNull = NullMappings.getIntNullConstant();
+	private final long longNull = NullMappings.getLongNullConstant();
+	private final float floatNull = NullMappings.getFloatNullConstant();
+	private final double doubleNull = NullMappings.getDoubleNullConstant();
+
 	RowIterator(MonetDBTable table, Object[][] rows, int firstIndex, int lastIndex) throws MonetDBEmbeddedException {
 		super(table, rows);
 		this.firstIndex = firstIndex;
 		this.lastIndex = lastIndex;
+		this.loaded = new boolean[rows.length];
+	}
+
+	RowIterator(MonetDBTable table, int batchSize, int firstIndex, int lastIndex) throws MonetDBEmbeddedException {
+		this(table, new Object[batchSize][table.getNumberOfColumns()], firstIndex, lastIndex);
 	}
 
 	@Override
@@ -101,7 +145,17 @@ public final class RowIterator extends AbstractRowSet {
 	 *
 	 * @return The current row currentColumns values as Java objects
 	 */
-	public MonetDBRow getCurrentRow() { return this.rows[this.currentIterationNumber]; }
+	public MonetDBRow getCurrentRow() {
+		int row = this.currentIterationNumber - this.batchStart;
+		if (this.buffers != null && !this.loaded[row]) {
+			Object[] values = this.rows[row].getAllColumns();
+			for (int j = 0 ; j < this.projection.length ; j++) {
+				values[this.projection[j]] = getBufferValue(this.buffers[j], this.typeIDs[j], row);
+			}
+			this.loaded[row] = true;
+		}
+		return this.rows[row];
+	}
 
 	/**
 	 * Checks if there are more rows to iterate after the current one.
@@ -161,6 +215,87 @@ public final class RowIterator extends AbstractRowSet {
 		return this.getColumnByIndex(index);
 	}
 
+	/**
+	 * Loads the next batch of rows, starting at the current iteration. The values of a row are converted to Java
+	 * objects only when it is read. The rows are reused between batches, so the values of the columns not projected
+	 * are left null.
+	 *
+	 * @param buffers The values of each projected column in the batch, reused between batches
+	 * @param projection The index of each projected column in the table (starting from 0)
+	 * @param typeIDs The type ID of each projected column
+	 * @param length The number of rows in the batch
+	 */
+	void setBatch(Object[] buffers, int[] projection, int[] typeIDs, int length) {
+		this.batchStart = this.currentIterationNumber;
+		this.buffers = buffers;
+		this.projection = projection;
+		this.typeIDs = typeIDs;
+		Arrays.fill(this.loaded, 0, length, false);
+	}
+
+	/**
+	 * Creates the buffer of a column for a batch, a primitive array for the numeric types, whose nulls are the ones
+	 * of {@link NullMappings}, or else an array of objects.
+	 *
+	 * @param typeID The type ID of the column, the same as in the query result sets
+	 * @param length The number of rows in a batch
+	 * @return The buffer of the column
+	 */
+	static Object createBuffer(int typeID, int length) {
+		switch (typeID) {
+			case 1:
+			case 2:
+				return new byte[length];
+			case 3:
+				return new short[length];
+			case 4:
+				return new int[length];
+			case 5:
+				return new long[length];
+			case 6:
+				return new float[length];
+			case 7:
+				return new double[length];
+			default:
+				return new Object[length];
+		}
+	}
+
+	private Object getBufferValue(Object buffer, int typeID, int row) {
+		switch (typeID) {
+			case 1: {
+				byte value = ((byte[]) buffer)[row];
+				return value == this.booleanNull ? null : value != 0;
+			}
+			case 2: {
+				byte value = ((byte[]) buffer)[row];
+				return value == this.byteNull ? null : value;
+			}
+			case 3: {
+				short value = ((short[]) buffer)[row];
+				return value == this.shortNull ? null : value;
+			}
+			case 4: {
+				int value = ((int[]) buffer)[row];
+				return value == this.intNull ? null : value;
+			}
+			case 5: {
+				long value = ((long[]) buffer)[row];
+				return value == this.longNull ? null : value;
+			}
+			case 6: {
+				float value = ((float[]) buffer)[row];
+				return Float.compare(value, this.floatNull) == 0 ? null : value;
+			}
+			case 7: {
+				double value = ((double[]) buffer)[row];
+				return Double.compare(value, this.doubleNull) == 0 ? null : value;
+			}
+			default:
+				return ((Object[]) buffer)[row];
+		}
+	}
+
 	/**
 	 * Sets the next value to iterate.
 	 */
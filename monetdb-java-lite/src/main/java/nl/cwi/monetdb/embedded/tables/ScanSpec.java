@@ -0,0 +1,177 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.tables;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * The specification of a {@link MonetDBTable#scan(ScanSpec)}: the columns to project and a conjunction of simple
+ * predicates, evaluated natively on the table's columns without going through the SQL front-end.
+ * <br>
+ * The columns are indexed from 1, as in {@link MonetDBTable#getColumnMetadataByIndex(int)}. The predicate values
+ * are given as the Java classes of the column's mapping, or as their String representation. Decimal columns also
+ * accept any {@link Number}. Blob columns cannot be used in predicates.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public final class ScanSpec {
+
+	/** The predicate kinds, the same as in the native side */
+	static final int RANGE = 0;
+	static final int EQUALS = 1;
+	static final int IN = 2;
+	static final int IS_NULL = 3;
+	static final int IS_NOT_NULL = 4;
+
+	/** The range bound flags, the same as in the native side */
+	static final byte LOW_INCLUSIVE = 1;
+	static final byte HIGH_INCLUSIVE = 2;
+
+	/** A predicate on a single column */
+	static final class Predicate {
+
+		final int column;
+
+		final int kind;
+
+		final byte flags;
+
+		final Object[] values;
+
+		private Predicate(int column, int kind, byte flags, Object[] values) {
+			this.column = column;
+			this.kind = kind;
+			this.flags = flags;
+			this.values = values;
+		}
+	}
+
+	/** The columns to project (starting from 1), or null for all */
+	private int[] projection;
+
+	/** The predicates, all of which must hold */
+	private final List<Predicate> predicates = new ArrayList<>();
+
+	/**
+	 * Gets the columns to project.
+	 *
+	 * @return The indexes of the columns to project (starting from 1), or null for all
+	 */
+	public int[] getProjection() { return this.projection; }
+
+	/**
+	 * Sets the columns to project, in the order of the result (default all the columns).
+	 *
+	 * @param columns The indexes of the columns to project (starting from 1)
+	 * @return This instance
+	 */
+	public ScanSpec project(int... columns) {
+		if (columns == null || columns.length == 0) {
+			throw new IllegalArgumentException("At least one column must be projected");
+		}
+		this.projection = columns.clone();
+		return this;
+	}
+
+	/**
+	 * Adds an inclusive range predicate, as in {@code column BETWEEN low AND high}.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param low The lower bound, or null if unbounded
+	 * @param high The upper bound, or null if unbounded
+	 * @return This instance
+	 */
+	public ScanSpec between(int column, Object low, Object high) {
+		return this.range(column, low, true, high, true);
+	}
+
+	/**
+	 * Adds a range predicate.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param low The lower bound, or null if unbounded
+	 * @param lowInclusive If the lower bound is included
+	 * @param high The upper bound, or null if unbounded
+	 * @param highInclusive If the upper bound is included
+	 * @return This instance
+	 */
+	public ScanSpec range(int column, Object low, boolean lowInclusive, Object high, boolean highInclusive) {
+		if (low == null && high == null) {
+			throw new IllegalArgumentException("A range needs at least one bound");
+		}
+		byte flags = (byte) ((lowInclusive ? LOW_INCLUSIVE : 0) | (highInclusive ? HIGH_INCLUSIVE : 0));
+		return this.addPredicate(column, RANGE, flags, new Object[]{low, high});
+	}
+
+	/**
+	 * Adds an equality predicate, as in {@code column = value}.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param value The value to match
+	 * @return This instance
+	 */
+	public ScanSpec equalTo(int column, Object value) {
+		if (value == null) {
+			throw new IllegalArgumentException("Use isNull to match the null values");
+		}
+		return this.addPredicate(column, EQUALS, (byte) 0, new Object[]{value});
+	}
+
+	/**
+	 * Adds a membership predicate, as in {@code column IN (values)}.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @param values The values to match
+	 * @return This instance
+	 */
+	public ScanSpec in(int column, Object... values) {
+		for (Object next : values) {
+			if (next == null) {
+				throw new IllegalArgumentException("Use isNull to match the null values");
+			}
+		}
+		return this.addPredicate(column, IN, (byte) 0, values.clone());
+	}
+
+	/**
+	 * Adds a predicate matching the null values, as in {@code column IS NULL}.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return This instance
+	 */
+	public ScanSpec isNull(int column) {
+		return this.addPredicate(column, IS_NULL, (byte) 0, new Object[0]);
+	}
+
+	/**
+	 * Adds a predicate matching the non null values, as in {@code column IS NOT NULL}.
+	 *
+	 * @param column The column index (starting from 1)
+	 * @return This instance
+	 */
+	public ScanSpec isNotNull(int column) {
+		return this.addPredicate(column, IS_NOT_NULL, (byte) 0, new Object[0]);
+	}
+
+	/**
+	 * Gets the predicates.
+	 *
+	 * @return The predicates
+	 */
+	List<Predicate> getPredicates() { return this.predicates; }
+
+	private ScanSpec addPredicate(int column, int kind, byte flags, Object[] values) {
+		if (column < 1) {
+			throw new ArrayIndexOutOfBoundsException("The column index must be at least 1");
+		}
+		this.predicates.add(new Predicate(column, kind, flags, values));
+		return this;
+	}
+}
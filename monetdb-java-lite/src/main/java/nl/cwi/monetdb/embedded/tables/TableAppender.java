@@ -0,0 +1,477 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.tables;
+
+import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedException;
+import nl.cwi.monetdb.embedded.mapping.MonetDBToJavaMapping;
+import nl.cwi.monetdb.embedded.mapping.NullMappings;
+
+import java.lang.reflect.Array;
+import java.math.BigDecimal;
+import java.time.LocalDate;
+import java.time.LocalDateTime;
+import java.time.LocalTime;
+import java.time.ZoneOffset;
+import java.util.Arrays;
+
+/**
+ * A row-oriented appender for a MonetDB table. The values are buffered column-wise in primitive arrays with the size
+ * of a chunk, and every full chunk is sent to the table in a single append, so no {@code Object[]} column arrays are
+ * needed. The values of a row are given in the columns order, with one append call per column and then
+ * {@link #endRow()}.
+ *
+ * Temporal and decimal columns are buffered as primitives: days since epoch for dates, microseconds for times and
+ * timestamps, and unscaled longs in the column's scale for decimals (see {@link MonetDBTable#appendColumns(Object[],
+ * int[])}).
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public final class TableAppender implements AutoCloseable {
+
+	/** The default number of rows buffered before flushing */
+	public static final int DEFAULT_CHUNK_SIZE = 8192;
+
+	/** The table to append to */
+	private final MonetDBTable table;
+
+	/** The mappings of the table columns */
+	private final MonetDBToJavaMapping[] mappings;
+
+	/** The scales of the table columns, used for the decimals */
+	private final int[] scales;
+
+	/** The buffered columns */
+	private final Object[] buffers;
+
+	/** The number of rows per chunk */
+	private final int chunkSize;
+
+	/** The number of buffered rows */
+	private int bufferedRows;
+
+	/** The column to be appended next in the current row */
+	private int currentColumn;
+
+	/** The total number of rows appended */
+	private long appendedRows;
+
+	/** If the appender is closed */
+	private boolean closed;
+
+	TableAppender(MonetDBTable table, int chunkSize) throws MonetDBEmbeddedException {
+		if (chunkSize < 1) {
+			throw new IllegalArgumentException("The chunk size must be at least 1");
+		}
+		int numberOfColumns = table.getNumberOfColumns();
+		this.table = table;
+		this.chunkSize = chunkSize;
+		this.mappings = new MonetDBToJavaMapping[numberOfColumns];
+		this.scales = new int[numberOfColumns];
+		this.buffers = new Object[numberOfColumns];
+		table.getMappings(this.mappings);
+		table.getColumnScales(this.scales);
+		for (int i = 0; i < numberOfColumns; i++) {
+			this.buffers[i] = createBuffer(this.mappings[i], chunkSize);
+		}
+	}
+
+	private static Object createBuffer(MonetDBToJavaMapping mapping, int size) {
+		switch (mapping) {
+			case Boolean:
+			case Tinyint:
+				return new byte[size];
+			case Smallint:
+				return new short[size];
+			case Int:
+			case MonthInterval:
+			case Date:
+				return new int[size];
+			case Bigint:
+			case SecondInterval:
+			case Decimal:
+			case Time:
+			case TimeTz:
+			case Timestamp:
+			case TimestampTz:
+				return new long[size];
+			case Real:
+				return new float[size];
+			case Double:
+				return new double[size];
+			case Blob:
+				return new byte[size][];
+			default: //Char, Varchar, Clob and Oid
+				return new String[size];
+		}
+	}
+
+	/**
+	 * Gets the number of rows per chunk.
+	 *
+	 * @return The number of rows per chunk
+	 */
+	public int getChunkSize() { return this.chunkSize; }
+
+	/**
+	 * Gets the number of rows buffered and not yet flushed.
+	 *
+	 * @return The number of buffered rows
+	 */
+	public int getBufferedRows() { return this.bufferedRows; }
+
+	/**
+	 * Gets the total number of rows flushed into the table by this appender.
+	 *
+	 * @return The number of appended rows
+	 */
+	public long getAppendedRows() { return this.appendedRows; }
+
+	/**
+	 * Tells if the appender is closed.
+	 *
+	 * @return A boolean indicating if the appender is closed
+	 */
+	public boolean isClosed() { return this.closed; }
+
+	private Object nextBuffer(MonetDBToJavaMapping... accepted) {
+		if (this.closed) {
+			throw new IllegalStateException("The appender is already closed");
+		}
+		if (this.currentColumn >= this.buffers.length) {
+			throw new ArrayStoreException("The row already has all the " + this.buffers.length + " columns");
+		}
+		if (this.bufferedRows >= this.chunkSize) {
+			throw new IllegalStateException("The chunk is full, the row must be ended first");
+		}
+		MonetDBToJavaMapping mapping = this.mappings[this.currentColumn];
+		for (MonetDBToJavaMapping next : accepted) {
+			if (next == mapping) {
+				return this.buffers[this.currentColumn++];
+			}
+		}
+		throw new ArrayStoreException("The column " + (this.currentColumn + 1) + " is of type " + mapping);
+	}
+
+	/**
+	 * Appends a boolean to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendBoolean(boolean value) {
+		((byte[]) this.nextBuffer(MonetDBToJavaMapping.Boolean))[this.bufferedRows] = value ? (byte) 1 : (byte) 0;
+		return this;
+	}
+
+	/**
+	 * Appends a byte to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendByte(byte value) {
+		((byte[]) this.nextBuffer(MonetDBToJavaMapping.Tinyint))[this.bufferedRows] = value;
+		return this;
+	}
+
+	/**
+	 * Appends a short to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendShort(short value) {
+		((short[]) this.nextBuffer(MonetDBToJavaMapping.Smallint))[this.bufferedRows] = value;
+		return this;
+	}
+
+	/**
+	 * Appends an int to the next column of the current row. For a date column, it's the number of days since
+	 * 1970-01-01.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendInt(int value) {
+		((int[]) this.nextBuffer(MonetDBToJavaMapping.Int, MonetDBToJavaMapping.MonthInterval,
+				MonetDBToJavaMapping.Date))[this.bufferedRows] = value;
+		return this;
+	}
+
+	/**
+	 * Appends a long to the next column of the current row. For a decimal column, it's the unscaled value in the
+	 * column's scale, while for time and timestamp columns it's the number of microseconds since midnight and since
+	 * 1970-01-01 00:00:00 respectively.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendLong(long value) {
+		((long[]) this.nextBuffer(MonetDBToJavaMapping.Bigint, MonetDBToJavaMapping.SecondInterval,
+				MonetDBToJavaMapping.Decimal, MonetDBToJavaMapping.Time, MonetDBToJavaMapping.TimeTz,
+				MonetDBToJavaMapping.Timestamp, MonetDBToJavaMapping.TimestampTz))[this.bufferedRows] = value;
+		return this;
+	}
+
+	/**
+	 * Appends a float to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendFloat(float value) {
+		((float[]) this.nextBuffer(MonetDBToJavaMapping.Real))[this.bufferedRows] = value;
+		return this;
+	}
+
+	/**
+	 * Appends a double to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendDouble(double value) {
+		((double[]) this.nextBuffer(MonetDBToJavaMapping.Double))[this.bufferedRows] = value;
+		return this;
+	}
+
+	/**
+	 * Appends a String to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendString(String value) {
+		((String[]) this.nextBuffer(MonetDBToJavaMapping.Char, MonetDBToJavaMapping.Varchar,
+				MonetDBToJavaMapping.Clob, MonetDBToJavaMapping.Oid))[this.bufferedRows] = value;
+		return this;
+	}
+
+	/**
+	 * Appends a BigDecimal to the next column of the current row, rounded with the table's rounding mode.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendDecimal(BigDecimal value) {
+		int scale = this.scales[this.currentColumn < this.scales.length ? this.currentColumn : 0];
+		long unscaled = value == null ? NullMappings.getLongNullConstant() :
+				value.setScale(scale, this.table.getRoundingMode()).unscaledValue().longValueExact();
+		((long[]) this.nextBuffer(MonetDBToJavaMapping.Decimal))[this.bufferedRows] = unscaled;
+		return this;
+	}
+
+	/**
+	 * Appends a date to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendDate(LocalDate value) {
+		((int[]) this.nextBuffer(MonetDBToJavaMapping.Date))[this.bufferedRows] =
+				value == null ? NullMappings.getIntNullConstant() : (int) value.toEpochDay();
+		return this;
+	}
+
+	/**
+	 * Appends a time to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendTime(LocalTime value) {
+		((long[]) this.nextBuffer(MonetDBToJavaMapping.Time, MonetDBToJavaMapping.TimeTz))[this.bufferedRows] =
+				value == null ? NullMappings.getLongNullConstant() : value.toNanoOfDay() / 1000L;
+		return this;
+	}
+
+	/**
+	 * Appends a timestamp to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendTimestamp(LocalDateTime value) {
+		long micros = NullMappings.getLongNullConstant();
+		if (value != null) {
+			micros = value.toEpochSecond(ZoneOffset.UTC) * 1000000L + value.getNano() / 1000L;
+		}
+		((long[]) this.nextBuffer(MonetDBToJavaMapping.Timestamp,
+				MonetDBToJavaMapping.TimestampTz))[this.bufferedRows] = micros;
+		return this;
+	}
+
+	/**
+	 * Appends a BLOB to the next column of the current row.
+	 *
+	 * @param value The value to append
+	 * @return This appender
+	 */
+	public TableAppender appendBlob(byte[] value) {
+		((byte[][]) this.nextBuffer(MonetDBToJavaMapping.Blob))[this.bufferedRows] = value;
+		return this;
+	}
+
+	/**
+	 * Appends a null value to the next column of the current row.
+	 *
+	 * @return This appender
+	 */
+	public TableAppender appendNull() {
+		Object buffer = this.nextBuffer(MonetDBToJavaMapping.values());
+		int row = this.bufferedRows;
+		if (buffer instanceof byte[]) {
+			((byte[]) buffer)[row] = this.mappings[this.currentColumn - 1] == MonetDBToJavaMapping.Boolean ?
+					NullMappings.getBooleanNullConstant() : NullMappings.getByteNullConstant();
+		} else if (buffer instanceof short[]) {
+			((short[]) buffer)[row] = NullMappings.getShortNullConstant();
+		} else if (buffer instanceof int[]) {
+			((int[]) buffer)[row] = NullMappings.getIntNullConstant();
+		} else if (buffer instanceof long[]) {
+			((long[]) buffer)[row] = NullMappings.getLongNullConstant();
+		} else if (buffer instanceof float[]) {
+			((float[]) buffer)[row] = NullMappings.getFloatNullConstant();
+		} else if (buffer instanceof double[]) {
+			((double[]) buffer)[row] = NullMappings.getDoubleNullConstant();
+		} else {
+			((Object[]) buffer)[row] = null;
+		}
+		return this;
+	}
+
+	/**
+	 * Appends a value to the next column of the current row, dispatching on its class.
+	 *
+	 * @param value The value to append, or null
+	 * @return This appender
+	 */
+	public TableAppender appendObject(Object value) {
+		if (value == null) {
+			return this.appendNull();
+		} else if (value instanceof Boolean) {
+			return this.appendBoolean((Boolean) value);
+		} else if (value instanceof Byte) {
+			return this.appendByte((Byte) value);
+		} else if (value instanceof Short) {
+			return this.appendShort((Short) value);
+		} else if (value instanceof Integer) {
+			return this.appendInt((Integer) value);
+		} else if (value instanceof Long) {
+			return this.appendLong((Long) value);
+		} else if (value instanceof Float) {
+			return this.appendFloat((Float) value);
+		} else if (value instanceof Double) {
+			return this.appendDouble((Double) value);
+		} else if (value instanceof String) {
+			return this.appendString((String) value);
+		} else if (value instanceof BigDecimal) {
+			return this.appendDecimal((BigDecimal) value);
+		} else if (value instanceof LocalDate) {
+			return this.appendDate((LocalDate) value);
+		} else if (value instanceof LocalTime) {
+			return this.appendTime((LocalTime) value);
+		} else if (value instanceof LocalDateTime) {
+			return this.appendTimestamp((LocalDateTime) value);
+		} else if (value instanceof byte[]) {
+			return this.appendBlob((byte[]) value);
+		}
+		throw new ArrayStoreException("The class " + value.getClass().getName() + " cannot be appended");
+	}
+
+	/**
+	 * Ends the current row. If the chunk gets full, it's flushed into the table, and if that fails the whole chunk is
+	 * discarded.
+	 *
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void endRow() throws MonetDBEmbeddedException {
+		if (this.currentColumn != this.buffers.length) {
+			throw new ArrayStoreException("The row has " + this.currentColumn + " columns, but the table has "
+					+ this.buffers.length);
+		}
+		this.currentColumn = 0;
+		this.bufferedRows++;
+		if (this.bufferedRows == this.chunkSize) {
+			this.flush();
+		}
+	}
+
+	/**
+	 * Appends a whole row and ends it.
+	 *
+	 * @param values The row values in the columns order
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void appendRow(Object... values) throws MonetDBEmbeddedException {
+		if (values.length != this.buffers.length) {
+			throw new ArrayStoreException("The number of columns between the row and the table is not consistent");
+		}
+		for (Object value : values) {
+			this.appendObject(value);
+		}
+		this.endRow();
+	}
+
+	/**
+	 * Flushes the buffered rows into the table. A partially appended row is kept. If the append fails, the buffered
+	 * rows are discarded and the exception is thrown.
+	 *
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	public void flush() throws MonetDBEmbeddedException {
+		if (this.closed) {
+			throw new IllegalStateException("The appender is already closed");
+		}
+		int rows = this.bufferedRows;
+		if (rows == 0) {
+			return;
+		}
+		Object[] input = this.buffers;
+		if (rows < this.chunkSize) {
+			input = new Object[this.buffers.length];
+			for (int i = 0; i < input.length; i++) {
+				input[i] = Array.newInstance(this.buffers[i].getClass().getComponentType(), rows);
+				System.arraycopy(this.buffers[i], 0, input[i], 0, rows);
+			}
+		}
+		try {
+			this.table.appendColumns(input, this.scales);
+			this.appendedRows += rows;
+		} finally { //on failure the chunk is discarded, so the appender can keep going with the next rows
+			this.bufferedRows = 0;
+			if (this.currentColumn > 0) { //move the partial row to the beginning of the buffers
+				for (Object buffer : this.buffers) {
+					System.arraycopy(buffer, rows, buffer, 0, 1);
+				}
+			}
+			for (Object buffer : this.buffers) { //don't hold references to flushed values
+				if (buffer instanceof Object[]) {
+					Arrays.fill((Object[]) buffer, this.currentColumn > 0 ? 1 : 0, this.chunkSize, null);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Flushes the remaining rows and closes the appender. An incomplete row is discarded.
+	 *
+	 * @throws MonetDBEmbeddedException If an error in the database occurred
+	 */
+	@Override
+	public void close() throws MonetDBEmbeddedException {
+		if (!this.closed) {
+			this.currentColumn = 0;
+			try {
+				this.flush();
+			} finally {
+				this.closed = true;
+			}
+		}
+	}
+}
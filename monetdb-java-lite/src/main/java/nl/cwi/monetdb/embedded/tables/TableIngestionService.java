@@ -0,0 +1,417 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0.  If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * Copyright 1997 - July 2008 CWI, August 2008 - 2018 MonetDB B.V.
+ */
+
+package nl.cwi.monetdb.embedded.tables;
+
+import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedConnection;
+import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedDatabase;
+import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedException;
+
+import java.lang.reflect.Array;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.Semaphore;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.locks.LockSupport;
+
+/**
+ * An asynchronous ingestion service for a MonetDB table. Several producer threads submit column batches in the same
+ * format of {@link MonetDBTable#appendColumns(Object[], int[])} into a lock-free queue, while a dedicated writer
+ * thread coalesces them and appends them in large transactions on its own connection. The number of rows queued is
+ * bounded: {@link #submit(Object[])} blocks while the queue is full and {@link #offer(Object[])} reports it instead.
+ * <br>
+ * An append failure is kept and thrown to the producers on their next submission, as well as on {@link #flush()} and
+ * {@link #close()}. The batches of the failed transaction are discarded.
+ *
+ * @author <a href="mailto:pedro.ferreira@monetdbsolutions.com">Pedro Ferreira</a>
+ */
+public final class TableIngestionService implements AutoCloseable {
+
+	/** A submitted batch */
+	private static final class Batch {
+
+		private final Object[] columns;
+
+		private final int rows;
+
+		private Batch(Object[] columns, int rows) {
+			this.columns = columns;
+			this.rows = rows;
+		}
+	}
+
+	/** The writer's own connection */
+	private final MonetDBEmbeddedConnection connection;
+
+	/** The table on the writer's connection */
+	private final MonetDBTable table;
+
+	/** The scales of unscaled decimal columns in the batches, or null */
+	private final int[] decimalScales;
+
+	/** The maximum number of rows appended in a single transaction */
+	private final int maxTransactionRows;
+
+	/** The maximum number of rows queued */
+	private final int capacity;
+
+	/** The queued batches */
+	private final ConcurrentLinkedQueue<Batch> queue = new ConcurrentLinkedQueue<>();
+
+	/** Permits for the number of rows queued, to bound the memory */
+	private final Semaphore available;
+
+	/** The writer thread */
+	private final Thread writer;
+
+	/** Monitor for the producers waiting on a flush */
+	private final Object flushMonitor = new Object();
+
+	/** The number of rows submitted so far */
+	private long submittedRows;
+
+	/** The number of rows processed by the writer so far, either appended or discarded */
+	private long processedRows;
+
+	/** The number of rows successfully appended */
+	private volatile long appendedRows;
+
+	/** The first failure of the writer */
+	private volatile MonetDBEmbeddedException failure;
+
+	/** If the service is not accepting batches anymore */
+	private volatile boolean closed;
+
+	/** The number of producers inside a submission, which the closing waits for before the last drain */
+	private final AtomicInteger submitters = new AtomicInteger();
+
+	/** If the remaining batches have been drained after the closing */
+	private volatile boolean terminated;
+
+	TableIngestionService(MonetDBTable table, int capacity, int maxTransactionRows, int[] decimalScales)
+			throws MonetDBEmbeddedException {
+		if (capacity < 1 || maxTransactionRows < 1) {
+			throw new IllegalArgumentException("The capacity and the transaction size must be at least 1");
+		}
+		this.capacity = capacity;
+		this.maxTransactionRows = maxTransactionRows;
+		this.decimalScales = decimalScales;
+		this.available = new Semaphore(capacity);
+		this.connection = MonetDBEmbeddedDatabase.createConnection();
+		try {
+			this.table = this.connection.getMonetDBTable(table.getTableSchema(), table.getTableName());
+			this.table.setRoundingMode(table.getRoundingMode());
+		} catch (MonetDBEmbeddedException ex) {
+			this.connection.close();
+			throw ex;
+		}
+		this.writer = new Thread(this::writerLoop, "MonetDB ingestion " + table.getTableSchema() + "."
+				+ table.getTableName());
+		this.writer.setDaemon(true);
+		this.writer.start();
+	}
+
+	/**
+	 * Gets the maximum number of rows that can be queued.
+	 *
+	 * @return The queue capacity in rows
+	 */
+	public int getCapacity() { return this.capacity; }
+
+	/**
+	 * Gets the number of rows currently queued.
+	 *
+	 * @return The number of queued rows
+	 */
+	public int getQueuedRows() { return this.capacity - this.available.availablePermits(); }
+
+	/**
+	 * Gets the number of rows appended into the table so far.
+	 *
+	 * @return The number of appended rows
+	 */
+	public long getAppendedRows() { return this.appendedRows; }
+
+	/**
+	 * Tells if the service has been closed.
+	 *
+	 * @return A boolean indicating if the service is closed
+	 */
+	public boolean isClosed() { return this.closed; }
+
+	private int checkBatch(Object[] columns) throws MonetDBEmbeddedException {
+		if (this.closed) {
+			throw new MonetDBEmbeddedException("The ingestion service is already closed");
+		}
+		if (this.failure != null) {
+			throw this.failure;
+		}
+		if (columns.length == 0 || columns[0] == null) {
+			throw new ArrayStoreException("The batch has no columns");
+		}
+		int rows = Array.getLength(columns[0]);
+		if (rows > this.capacity) {
+			throw new ArrayStoreException("The batch has more rows than the capacity of the service");
+		}
+		return rows;
+	}
+
+	private void enqueue(Object[] columns, int rows) {
+		synchronized (this.flushMonitor) {
+			this.submittedRows += rows;
+		}
+		this.queue.offer(new Batch(columns, rows));
+		LockSupport.unpark(this.writer);
+	}
+
+	/**
+	 * Submits a batch of columns, waiting while the queue is full. The arrays must not be modified afterwards.
+	 *
+	 * @param columns An array of columns to append
+	 * @throws MonetDBEmbeddedException If the service is closed or a previous append failed
+	 * @throws InterruptedException If interrupted while waiting
+	 */
+	public void submit(Object[] columns) throws MonetDBEmbeddedException, InterruptedException {
+		this.submitters.incrementAndGet();
+		try {
+			int rows = this.checkBatch(columns);
+			this.available.acquire(rows);
+			this.enqueue(columns, rows);
+		} finally {
+			this.submitters.decrementAndGet();
+		}
+	}
+
+	/**
+	 * Submits a batch of columns, waiting up to the given time while the queue is full. The arrays must not be
+	 * modified afterwards.
+	 *
+	 * @param columns An array of columns to append
+	 * @param timeout The maximum time to wait
+	 * @param unit The time unit of the timeout
+	 * @return False if the queue remained full
+	 * @throws MonetDBEmbeddedException If the service is closed or a previous append failed
+	 * @throws InterruptedException If interrupted while waiting
+	 */
+	public boolean submit(Object[] columns, long timeout, TimeUnit unit)
+			throws MonetDBEmbeddedException, InterruptedException {
+		this.submitters.incrementAndGet();
+		try {
+			int rows = this.checkBatch(columns);
+			if (!this.available.tryAcquire(rows, timeout, unit)) {
+				return false;
+			}
+			this.enqueue(columns, rows);
+			return true;
+		} finally {
+			this.submitters.decrementAndGet();
+		}
+	}
+
+	/**
+	 * Submits a batch of columns if there is room for it in the queue, without waiting. The arrays must not be
+	 * modified afterwards.
+	 *
+	 * @param columns An array of columns to append
+	 * @return False if the queue is full
+	 * @throws MonetDBEmbeddedException If the service is closed or a previous append failed
+	 */
+	public boolean offer(Object[] columns) throws MonetDBEmbeddedException {
+		this.submitters.incrementAndGet();
+		try {
+			int rows = this.checkBatch(columns);
+			if (!this.available.tryAcquire(rows)) {
+				return false;
+			}
+			this.enqueue(columns, rows);
+			return true;
+		} finally {
+			this.submitters.decrementAndGet();
+		}
+	}
+
+	/**
+	 * Waits until all the batches submitted before this call have been appended.
+	 *
+	 * @throws MonetDBEmbeddedException If an append failed
+	 * @throws InterruptedException If interrupted while waiting
+	 */
+	public void flush() throws MonetDBEmbeddedException, InterruptedException {
+		boolean lost;
+		synchronized (this.flushMonitor) {
+			long target = this.submittedRows;
+			while (this.processedRows < target && !this.terminated) {
+				this.flushMonitor.wait(100);
+			}
+			lost = this.processedRows < target;
+		}
+		if (this.failure != null) {
+			throw this.failure;
+		}
+		if (lost) {
+			throw new MonetDBEmbeddedException("The ingestion service was closed before appending all the batches");
+		}
+	}
+
+	/**
+	 * Stops accepting batches, appends the remaining ones and closes the writer's connection.
+	 *
+	 * @throws MonetDBEmbeddedException If an append failed
+	 */
+	@Override
+	public void close() throws MonetDBEmbeddedException {
+		if (!this.closed) {
+			this.closed = true;
+			LockSupport.unpark(this.writer);
+			boolean interrupted = false;
+			//the producers that passed the closed check before it was set may still be enqueuing, while the writer keeps
+			//draining the queue, so the blocked ones get their permits
+			while (this.submitters.get() > 0) {
+				LockSupport.parkNanos(this, TimeUnit.MILLISECONDS.toNanos(1));
+			}
+			while (this.writer.isAlive()) {
+				try {
+					this.writer.join();
+				} catch (InterruptedException ex) {
+					interrupted = true;
+				}
+			}
+			try {
+				if (!this.queue.isEmpty()) { //a producer enqueued after the writer exited
+					this.writerLoop();
+				}
+				this.connection.close();
+			} finally {
+				synchronized (this.flushMonitor) {
+					this.terminated = true;
+					this.flushMonitor.notifyAll();
+				}
+			}
+			if (interrupted) {
+				Thread.currentThread().interrupt();
+			}
+		}
+		if (this.failure != null) {
+			throw this.failure;
+		}
+	}
+
+	/**
+	 * Concatenates the same column of several batches.
+	 */
+	private static Object concatenate(List<Batch> group, int column, int rows) {
+		Object first = group.get(0).columns[column];
+		if (group.size() == 1) {
+			return first;
+		}
+		Object res = Array.newInstance(first.getClass().getComponentType(), rows);
+		int offset = 0;
+		for (Batch next : group) {
+			System.arraycopy(next.columns[column], 0, res, offset, next.rows);
+			offset += next.rows;
+		}
+		return res;
+	}
+
+	/**
+	 * Tells if two batches can be appended together, i.e. their columns have the same array classes.
+	 */
+	private static boolean compatible(Batch one, Batch two) {
+		if (one.columns.length != two.columns.length) {
+			return false;
+		}
+		for (int i = 0; i < one.columns.length; i++) {
+			if (one.columns[i] == null || two.columns[i] == null ||
+					one.columns[i].getClass() != two.columns[i].getClass()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	private void appendGroup(List<Batch> group, int rows) throws MonetDBEmbeddedException {
+		Object[] input = new Object[group.get(0).columns.length];
+		for (int i = 0; i < input.length; i++) {
+			input[i] = concatenate(group, i, rows);
+		}
+		this.table.appendColumns(input, this.decimalScales);
+	}
+
+	/**
+	 * Appends the drained batches in a single transaction, coalescing the consecutive compatible ones.
+	 */
+	private void appendTransaction(List<Batch> drained) throws MonetDBEmbeddedException {
+		List<Batch> group = new ArrayList<>();
+		int groupRows = 0;
+		boolean inTransaction = false;
+		try {
+			for (Batch next : drained) {
+				if (!group.isEmpty() && !compatible(group.get(0), next)) {
+					if (!inTransaction) {
+						this.connection.startTransaction();
+						inTransaction = true;
+					}
+					this.appendGroup(group, groupRows);
+					group.clear();
+					groupRows = 0;
+				}
+				group.add(next);
+				groupRows += next.rows;
+			}
+			this.appendGroup(group, groupRows);
+			if (inTransaction) {
+				this.connection.commit();
+			}
+		} catch (MonetDBEmbeddedException ex) {
+			if (inTransaction) {
+				try {
+					this.connection.rollback();
+				} catch (MonetDBEmbeddedException ignored) {}
+			}
+			throw ex;
+		}
+	}
+
+	private void writerLoop() {
+		List<Batch> drained = new ArrayList<>();
+		while (true) {
+			Batch next = this.queue.poll();
+			if (next == null) {
+				if (this.closed && this.queue.isEmpty()) {
+					break;
+				}
+				LockSupport.parkNanos(this, TimeUnit.MILLISECONDS.toNanos(10));
+				continue;
+			}
+			int rows = 0;
+			do {
+				drained.add(next);
+				rows += next.rows;
+			} while (rows < this.maxTransactionRows && (next = this.queue.poll()) != null);
+
+			if (this.failure == null) {
+				try {
+					this.appendTransaction(drained);
+					this.appendedRows += rows;
+				} catch (MonetDBEmbeddedException ex) {
+					this.failure = ex;
+				} catch (RuntimeException ex) {
+					this.failure = new MonetDBEmbeddedException(ex);
+				}
+			}
+			drained.clear();
+			this.available.release(rows);
+			synchronized (this.flushMonitor) {
+				this.processedRows += rows;
+				this.flushMonitor.notifyAll();
+			}
+		}
+	}
+}
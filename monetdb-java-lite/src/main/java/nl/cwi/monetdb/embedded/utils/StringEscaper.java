@@ -27,4 +27,14 @@ public final class StringEscaper {
 		return "'" + input.replaceAll("\\\\", "\\\\\\\\").replaceAll("'", "\\\\'")
 				+ "'";
 	}
+
+	/**
+	 * Quotes a Java String as a SQL identifier, such as a table or column name.
+	 *
+	 * @param input The identifier to quote
+	 * @return The input String as a quoted identifier
+	 */
+	public static String sqlIdentifierEscape(String input) {
+		return "\"" + input.replace("\"", "\"\"") + "\"";
+	}
 }
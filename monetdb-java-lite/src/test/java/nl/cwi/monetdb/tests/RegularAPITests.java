@@ -8,6 +8,8 @@
 
 package nl.cwi.monetdb.tests;
 
+import nl.cwi.monetdb.embedded.env.CopyOptions;
+import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedCancelledException;
 import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedConnection;
 import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedDatabase;
 import nl.cwi.monetdb.embedded.env.MonetDBEmbeddedException;
@@ -17,7 +19,14 @@ import nl.cwi.monetdb.embedded.mapping.NullMappings;
 import nl.cwi.monetdb.embedded.resultset.QueryResultSet;
 import nl.cwi.monetdb.embedded.tables.IMonetDBTableCursor;
 import nl.cwi.monetdb.embedded.tables.MonetDBTable;
+import nl.cwi.monetdb.embedded.tables.MonetDBTableIndex;
+import nl.cwi.monetdb.embedded.tables.MonetDBTableLookup;
+import nl.cwi.monetdb.embedded.tables.MonetDBTableRange;
+import nl.cwi.monetdb.embedded.tables.MonetDBTableStatistics;
 import nl.cwi.monetdb.embedded.tables.RowIterator;
+import nl.cwi.monetdb.embedded.tables.ScanSpec;
+import nl.cwi.monetdb.embedded.tables.TableAppender;
+import nl.cwi.monetdb.embedded.tables.TableIngestionService;
 import nl.cwi.monetdb.tests.helpers.ForkJavaProcess;
 import nl.cwi.monetdb.tests.helpers.MonetDBJavaLiteTesting;
 import nl.cwi.monetdb.tests.helpers.TryStartMonetDBEmbeddedDatabase;
@@ -25,6 +34,9 @@ import org.junit.jupiter.api.*;
 
 import java.io.*;
 import java.math.BigDecimal;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.LongBuffer;
 import java.nio.charset.StandardCharsets;
 import java.nio.file.Files;
 import java.nio.file.Path;
@@ -33,7 +45,10 @@ import java.sql.*;
 import java.sql.Date;
 import java.text.ParseException;
 import java.text.SimpleDateFormat;
+import java.time.LocalDate;
 import java.util.*;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
 
 /**
  * Test the regular API. Just that :)
@@ -604,6 +619,291 @@ public class RegularAPITests extends MonetDBJavaLiteTesting {
 		connection.executeUpdate("DROP TABLE test4;");
 	}
 
+	@Test
+	@DisplayName("Test the table iteration in batches with a projection and deleted rows")
+	void testIterateTableBatches() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testbatches (a int, b text, c decimal(8,2));");
+		MonetDBTable table = connection.getMonetDBTable("testbatches");
+		int[] values = new int[100];
+		for (int i = 0; i < values.length; i++) {
+			values[i] = i;
+		}
+		table.appendColumns(new Object[]{values, new String[100], new long[100]});
+		connection.executeUpdate("DELETE FROM testbatches WHERE a % 10 = 0;");
+
+		final int[] sum = new int[1];
+		int iterated = table.iterateTable(new IMonetDBTableCursor() {
+			@Override
+			public void processNextRow(RowIterator rowIterator) {
+				Integer next = rowIterator.getColumnByIndex(1, Integer.class);
+				Assertions.assertNotEquals(0, next % 10, "The deleted rows should not be iterated");
+				Assertions.assertNull(rowIterator.getCurrentRow().getAllColumns()[1], "The column was not projected");
+				sum[0] += next;
+			}
+
+			@Override
+			public int getFirstRowToIterate() { return 1; }
+
+			@Override
+			public int getLastRowToIterate() { return Integer.MAX_VALUE; }
+		}, new int[]{1}, 7);
+		Assertions.assertEquals(90, iterated, "The number of iterated rows is wrong");
+		Assertions.assertEquals(4500, sum[0], "The iterated values are wrong");
+		connection.executeUpdate("DROP TABLE testbatches;");
+	}
+
+	@Test
+	@DisplayName("Test the table iteration reads a snapshot of the transaction's inserts and deletes")
+	void testIterateTableSnapshot() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testsnapshot (a bigint, b text);");
+		MonetDBTable table = connection.getMonetDBTable("testsnapshot");
+		long[] values = new long[50];
+		String[] names = new String[50];
+		for (int i = 0; i < values.length; i++) {
+			values[i] = i;
+			names[i] = "row" + i;
+		}
+		table.appendColumns(new Object[]{values, names});
+		connection.startTransaction();
+		connection.executeUpdate("INSERT INTO testsnapshot VALUES (50, 'row50'), (51, 'row51'), (53, NULL);");
+		connection.executeUpdate("DELETE FROM testsnapshot WHERE a % 7 = 3;");
+
+		final long[] sum = new long[1];
+		final int[] nulls = new int[1];
+		int iterated = table.iterateTable(new IMonetDBTableCursor() {
+			@Override
+			public void processNextRow(RowIterator rowIterator) {
+				long next = rowIterator.getColumnByIndex(1, Long.class);
+				String name = rowIterator.getColumnByIndex(2, String.class);
+				Assertions.assertNotEquals(3, next % 7, "The deleted rows should not be iterated");
+				if (name == null) {
+					nulls[0]++;
+				} else {
+					Assertions.assertEquals("row" + next, name, "The columns of the row are not aligned");
+				}
+				sum[0] += next;
+				if (next == 0) {
+					try {
+						connection.executeUpdate("DELETE FROM testsnapshot WHERE a > 40;");
+					} catch (MonetDBEmbeddedException ex) {
+						Assertions.fail(ex.getMessage());
+					}
+				}
+			}
+
+			@Override
+			public int getFirstRowToIterate() { return 1; }
+
+			@Override
+			public int getLastRowToIterate() { return Integer.MAX_VALUE; }
+		}, null, 4);
+		Assertions.assertEquals(46, iterated, "The number of iterated rows is wrong");
+		Assertions.assertEquals(1211, sum[0], "The snapshot should not see the deletes made while iterating");
+		Assertions.assertEquals(1, nulls[0], "The inserted null should be iterated");
+		connection.rollback();
+
+		QueryResultSet qrs = connection.executeQuery("SELECT COUNT(*) FROM testsnapshot;");
+		Assertions.assertEquals(50, qrs.getLongByColumnIndexAndRow(1, 1), "The transaction should be rolled back");
+		qrs.close();
+		connection.executeUpdate("DROP TABLE testsnapshot;");
+	}
+
+	@Test
+	@DisplayName("Test the cached table metadata follows the schema changes")
+	void testTableDescriptorCache() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testdescriptor (a int);");
+		MonetDBTable table = connection.getMonetDBTable("testdescriptor");
+		for (int i = 0; i < 10; i++) {
+			Assertions.assertEquals(1, table.appendColumns(new Object[]{new int[]{i}}), "The row should be appended");
+		}
+		Assertions.assertEquals(1, table.getNumberOfColumns(), "The number of columns is wrong");
+
+		connection.executeUpdate("ALTER TABLE testdescriptor ADD COLUMN b varchar(8);");
+		Assertions.assertEquals(2, table.getNumberOfColumns(), "The new column should be seen");
+		Assertions.assertEquals("b", table.getColumnMetadataByIndex(2).getColumnName(), "The new column name is wrong");
+		Assertions.assertEquals(1, table.appendColumns(new Object[]{new int[]{10}, new String[]{"new"}}), "The row should be appended");
+
+		connection.startTransaction();
+		connection.executeUpdate("ALTER TABLE testdescriptor DROP COLUMN b;");
+		Assertions.assertEquals(1, table.getNumberOfColumns(), "The uncommitted change should be seen");
+		connection.rollback();
+		Assertions.assertEquals(2, table.getNumberOfColumns(), "The rolled back change should not be seen");
+		connection.executeUpdate("DROP TABLE testdescriptor;");
+	}
+
+	@Test
+	@DisplayName("Test scanning a table with native predicates")
+	void testTableScan() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testscan (a int, b varchar(8), c decimal(6,2));");
+		connection.executeUpdate("INSERT INTO testscan VALUES (1, 'x', 1.5), (2, 'y', 2.5), (3, 'x', null), (4, 'x', 4.25), (5, null, 5);");
+		connection.executeUpdate("DELETE FROM testscan WHERE a = 4;");
+		MonetDBTable table = connection.getMonetDBTable("testscan");
+
+		QueryResultSet qrs = table.scan(new ScanSpec().project(3, 1).between(1, 2, 5).equalTo(2, "x"));
+		Assertions.assertEquals(1, qrs.getNumberOfRows(), "The deleted row should not be selected");
+		Assertions.assertEquals(2, qrs.getNumberOfColumns(), "The number of projected columns is wrong");
+		Assertions.assertEquals(3, qrs.getIntegerByColumnIndexAndRow(2, 1), "The selected row is wrong");
+		Assertions.assertNull(qrs.getDecimalByColumnIndexAndRow(1, 1), "The decimal should be null");
+		qrs.close();
+
+		qrs = table.scan(new ScanSpec().project(1).in(3, new BigDecimal("1.5"), 5).range(1, null, false, 5, false));
+		Assertions.assertEquals(1, qrs.getNumberOfRows(), "The IN and range predicates are wrong");
+		Assertions.assertEquals(1, qrs.getIntegerByColumnIndexAndRow(1, 1), "The selected row is wrong");
+		qrs.close();
+
+		qrs = table.scan(new ScanSpec().project(1).in(1, 5, 4, 2, 5));
+		int[] matched = new int[2];
+		qrs.getIntColumnByIndex(1, matched);
+		Assertions.assertArrayEquals(new int[]{2, 5}, matched, "Each row should be selected once, in the table order");
+		qrs.close();
+
+		qrs = table.scan(new ScanSpec().project(1).isNull(2));
+		Assertions.assertEquals(5, qrs.getIntegerByColumnIndexAndRow(1, 1), "The IS NULL predicate is wrong");
+		qrs.close();
+		qrs = table.scan(new ScanSpec().isNotNull(3));
+		Assertions.assertEquals(3, qrs.getNumberOfRows(), "The IS NOT NULL predicate is wrong");
+		Assertions.assertEquals(3, qrs.getNumberOfColumns(), "All the columns should be projected");
+		qrs.close();
+
+		connection.startTransaction();
+		connection.executeUpdate("INSERT INTO testscan VALUES (6, 'x', 6), (7, 'x', 7);");
+		connection.executeUpdate("DELETE FROM testscan WHERE a = 6;");
+		qrs = table.scan(new ScanSpec().project(1).equalTo(2, "x"));
+		int[] pending = new int[3];
+		qrs.getIntColumnByIndex(1, pending);
+		Assertions.assertArrayEquals(new int[]{1, 3, 7}, pending, "The pending inserts should follow the stored rows");
+		qrs.close();
+		connection.rollback();
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> table.scan(new ScanSpec().equalTo(1, "one")));
+		connection.executeUpdate("DROP TABLE testscan;");
+	}
+
+	@Test
+	@DisplayName("Test creating, listing and dropping the indexes of a table")
+	void testTableIndexes() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testindexes (a int, b bigint);");
+		MonetDBTable table = connection.getMonetDBTable("testindexes");
+		table.appendColumns(new Object[]{new int[]{5, 3, 9, 1}, new long[]{1, 2, 3, 4}});
+		Assertions.assertEquals(0, table.listIndexes().length, "There should be no indexes");
+
+		table.createOrderedIndex(1);
+		table.createImprints("bimprints", 2);
+		MonetDBTableIndex[] indexes = table.listIndexes();
+		Assertions.assertEquals(2, indexes.length, "The number of indexes is wrong");
+		for (MonetDBTableIndex next : indexes) {
+			if (next.getType() == MonetDBTableIndex.IndexType.Ordered) {
+				Assertions.assertEquals("testindexes_a_oidx", next.getName(), "The default index name is wrong");
+				Assertions.assertArrayEquals(new String[]{"a"}, next.getColumnNames(), "The indexed column is wrong");
+			} else {
+				Assertions.assertEquals(MonetDBTableIndex.IndexType.Imprints, next.getType(), "The index type is wrong");
+				Assertions.assertEquals("bimprints", next.getName(), "The index name is wrong");
+			}
+		}
+		QueryResultSet qrs = connection.executeQuery("SELECT a FROM testindexes WHERE a BETWEEN 2 AND 6 ORDER BY a;");
+		Assertions.assertEquals(2, qrs.getNumberOfRows(), "The index should not change the results");
+		qrs.close();
+
+		table.dropIndex("testindexes_a_oidx");
+		table.dropIndex("bimprints");
+		Assertions.assertEquals(0, table.listIndexes().length, "The indexes should be dropped");
+		connection.executeUpdate("DROP TABLE testindexes;");
+	}
+
+	@Test
+	@DisplayName("Test looking up value ranges on sorted and unsorted columns")
+	void testTableLookupRange() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testlookup (a int, b bigint);");
+		MonetDBTable table = connection.getMonetDBTable("testlookup");
+		table.appendColumns(new Object[]{new int[]{1, 2, 4, 4, 7, 9}, new long[]{60, 50, 40, 30, 20, 10}});
+
+		MonetDBTableRange range = table.lookupRange(1, 2, 7);
+		Assertions.assertTrue(range.isContiguous(), "The range of a sorted column should be contiguous");
+		Assertions.assertEquals(1, range.getFirstRowId(), "The first row id is wrong");
+		Assertions.assertEquals(5, range.getLastRowId(), "The last row id is wrong");
+		Assertions.assertNull(range.getColumns(), "No columns were projected");
+		Assertions.assertEquals(0, table.lookupRange(1, 5, 6).getNumberOfRows(), "No rows should be matched");
+
+		range = table.lookupRange(2, 15L, 45L, new int[]{1});
+		Assertions.assertArrayEquals(new long[]{2, 3, 4}, range.getRowIds(), "The row ids are wrong");
+		int[] values = new int[3];
+		range.getColumns().getIntColumnByIndex(1, values);
+		Assertions.assertArrayEquals(new int[]{4, 4, 7}, values, "The projected values are wrong");
+		range.getColumns().close();
+
+		connection.executeUpdate("DELETE FROM testlookup WHERE b = 30;");
+		range = table.lookupRange(1, 4, null, new int[]{2});
+		Assertions.assertFalse(range.isContiguous(), "The deleted row should split the range");
+		Assertions.assertArrayEquals(new long[]{2, 4, 5}, range.getRowIds(), "The deleted row should be skipped");
+		range.getColumns().close();
+
+		connection.startTransaction();
+		connection.executeUpdate("INSERT INTO testlookup VALUES (5, 5);");
+		range = table.lookupRange(1, 4, 5);
+		Assertions.assertArrayEquals(new long[]{2, 6}, range.getRowIds(), "The pending insert should be matched");
+		connection.rollback();
+		connection.executeUpdate("DROP TABLE testlookup;");
+	}
+
+	@Test
+	@DisplayName("Test looking up keys in bulk with the hash of a column")
+	void testTableLookupByKey() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testkeys (k varchar(16), v int);");
+		MonetDBTable table = connection.getMonetDBTable("testkeys");
+		table.appendColumns(new Object[]{new String[]{"one", "two", "three", "two"}, new int[]{1, 2, 3, 22}});
+
+		MonetDBTableLookup lookup = table.lookupByKey(1, new Object[]{"two", "four", null, "one"}, new int[]{2});
+		Assertions.assertArrayEquals(new long[]{1, 3, 0}, lookup.getRowIds(), "The row ids are wrong");
+		Assertions.assertArrayEquals(new int[]{0, 0, 3}, lookup.getKeyIndexes(), "The key indexes are wrong");
+		int[] values = new int[3];
+		lookup.getColumns().getIntColumnByIndex(1, values);
+		Assertions.assertArrayEquals(new int[]{2, 22, 1}, values, "The projected values are wrong");
+		lookup.getColumns().close();
+
+		connection.executeUpdate("DELETE FROM testkeys WHERE v = 2;");
+		lookup = table.lookupByKey(1, new Object[]{"two", "three"});
+		Assertions.assertArrayEquals(new long[]{3, 2}, lookup.getRowIds(), "The deleted row should be skipped");
+		Assertions.assertNull(lookup.getColumns(), "No columns were projected");
+
+		connection.startTransaction();
+		connection.executeUpdate("INSERT INTO testkeys VALUES ('two', 5);");
+		lookup = table.lookupByKey(1, new Object[]{"two"}, new int[]{2});
+		Assertions.assertArrayEquals(new long[]{3, 4}, lookup.getRowIds(), "The pending insert should be matched");
+		values = new int[2];
+		lookup.getColumns().getIntColumnByIndex(1, values);
+		Assertions.assertArrayEquals(new int[]{22, 5}, values, "The pending insert should be projected");
+		lookup.getColumns().close();
+		connection.rollback();
+		connection.executeUpdate("DROP TABLE testkeys;");
+	}
+
+	@Test
+	@DisplayName("Test deleting and updating rows by their row ids")
+	void testTableDeleteAndUpdateRows() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testrowids (k int PRIMARY KEY, v varchar(16), d decimal(5,2));");
+		MonetDBTable table = connection.getMonetDBTable("testrowids");
+		table.appendColumns(new Object[]{new int[]{1, 2, 3, 4, 5}, new String[]{"a", "b", "c", "d", "e"},
+				new long[]{100, 200, 300, 400, 500}});
+
+		Assertions.assertEquals(2, table.deleteRows(new long[]{3, 1, 3}), "Each row should be deleted once");
+		Assertions.assertEquals(3, table.getNumberOfRows(), "The deleted rows should not be visible");
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> table.deleteRows(new long[]{1}));
+
+		Assertions.assertEquals(2, table.updateColumn(2, new long[]{4, 0}, new String[]{"dd", "aa"}),
+				"The number of rows updated is wrong");
+		Assertions.assertEquals(1, table.updateColumn(2, new long[]{4, 4}, new String[]{"x", "dd"}),
+				"A repeated row should be updated once, with its last value");
+		table.updateColumn(3, new long[]{2}, new BigDecimal[]{new BigDecimal("3.33")});
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> table.updateColumn(1, new long[]{0}, new int[]{9}));
+
+		QueryResultSet qrs = connection.executeQuery("SELECT v, d FROM testrowids ORDER BY k;");
+		String[] values = new String[3];
+		qrs.getStringColumnByIndex(1, values);
+		Assertions.assertArrayEquals(new String[]{"aa", "c", "dd"}, values, "The updated values are wrong");
+		Assertions.assertEquals(new BigDecimal("3.33"), qrs.getDecimalByColumnIndexAndRow(2, 2), "The decimal was not updated");
+		qrs.close();
+		connection.executeUpdate("DROP TABLE testrowids;");
+	}
+
 	@Test
 	@DisplayName("Test appending basic types into a table (Also testing foreign characters)")
 	void testAppendBasic() throws MonetDBEmbeddedException {
@@ -693,6 +993,132 @@ public class RegularAPITests extends MonetDBJavaLiteTesting {
 		connection.executeUpdate("DROP TABLE test5;");
 	}
 
+	@Test
+	@DisplayName("Test appending rows with a table appender")
+	void testTableAppender() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testappender (a int, b varchar(32), c decimal(8,2), d date);");
+		MonetDBTable testappender = connection.getMonetDBTable("sys", "testappender");
+
+		try (TableAppender appender = testappender.createAppender(2)) {
+			for (int i = 0; i < 4; i++) {
+				appender.appendInt(i).appendString("row" + i).appendLong(i * 100L + 1).appendInt(16801 + i).endRow();
+			}
+			Assertions.assertEquals(4, appender.getAppendedRows(), "The full chunks should have been flushed");
+			appender.appendRow(null, "last", new BigDecimal("2.555"), LocalDate.of(2000, 2, 29));
+			Assertions.assertEquals(1, appender.getBufferedRows(), "The last row should be buffered");
+			try {
+				appender.appendString("wrong");
+				Assertions.fail("The ArrayStoreException should be thrown");
+			} catch (ArrayStoreException ex) {
+				//the first column is an int
+			}
+		}
+
+		QueryResultSet qrs = connection.executeQuery("SELECT * FROM testappender;");
+		int numberOfRows = qrs.getNumberOfRows();
+		Assertions.assertEquals(5, numberOfRows, "The number of rows should be 5, got " + numberOfRows + " instead");
+
+		String[] array2 = new String[numberOfRows];
+		qrs.getStringColumnByIndex(2, array2);
+		Assertions.assertArrayEquals(new String[]{"row0", "row1", "row2", "row3", "last"}, array2,
+				"Strings not correctly appended");
+
+		BigDecimal[] array3 = new BigDecimal[numberOfRows];
+		qrs.getDecimalColumnByIndex(3, array3);
+		Assertions.assertArrayEquals(new BigDecimal[]{new BigDecimal("0.01"), new BigDecimal("1.01"),
+				new BigDecimal("2.01"), new BigDecimal("3.01"), new BigDecimal("2.56")}, array3,
+				"Decimals not correctly appended");
+		Assertions.assertTrue(NullMappings.checkIntIsNull(qrs.getIntegerByColumnIndexAndRow(1, 5)),
+				"The first column of the last row should be null");
+		qrs.close();
+		connection.executeUpdate("DROP TABLE testappender;");
+	}
+
+	@Test
+	@DisplayName("Test appending from several producers with an ingestion service")
+	void testIngestionService() throws Exception {
+		connection.executeUpdate("CREATE TABLE testingestion (a int, b varchar(32));");
+		MonetDBTable testingestion = connection.getMonetDBTable("sys", "testingestion");
+
+		try (TableIngestionService service = testingestion.createIngestionService(64, 1000)) {
+			Thread[] producers = new Thread[4];
+			for (int i = 0; i < producers.length; i++) {
+				final int producer = i;
+				producers[i] = new Thread(() -> {
+					try {
+						for (int j = 0; j < 50; j++) {
+							service.submit(new Object[]{new int[]{producer, producer}, new String[]{"p" + producer, null}});
+						}
+					} catch (Exception ex) {
+						throw new RuntimeException(ex);
+					}
+				});
+				producers[i].start();
+			}
+			for (Thread producer : producers) {
+				producer.join();
+			}
+			service.flush();
+			Assertions.assertEquals(400, service.getAppendedRows(), "All the submitted rows should be appended");
+			try {
+				service.offer(new Object[]{new int[65], new String[65]});
+				Assertions.fail("The ArrayStoreException should be thrown");
+			} catch (ArrayStoreException ex) {
+				//the batch is larger than the capacity
+			}
+		}
+
+		QueryResultSet qrs = connection.executeQuery("SELECT COUNT(*), COUNT(b), SUM(a) FROM testingestion;");
+		Assertions.assertEquals(400, qrs.getLongByColumnIndexAndRow(1, 1), "The number of rows should be 400");
+		Assertions.assertEquals(200, qrs.getLongByColumnIndexAndRow(2, 1), "The number of non null strings should be 200");
+		Assertions.assertEquals(600, qrs.getLongByColumnIndexAndRow(3, 1), "The sum of the producers ids should be 600");
+		qrs.close();
+		connection.executeUpdate("DROP TABLE testingestion;");
+	}
+
+	@Test
+	@DisplayName("Test appending unscaled decimals into a table")
+	void testAppendUnscaledDecimals() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testunscaled (a decimal(4,2), b decimal(18,3));");
+		MonetDBTable testunscaled = connection.getMonetDBTable("sys", "testunscaled");
+
+		long[] append1 = new long[]{160L, -1232L, NullMappings.getLongNullConstant(), 9999L};
+		long[] append2 = new long[]{12345L, 12355L, -12345L, NullMappings.getLongNullConstant()};
+		testunscaled.appendColumns(new Object[]{append1, append2}, new int[]{2, 4});
+
+		QueryResultSet qrs = connection.executeQuery("SELECT * FROM testunscaled;");
+		int numberOfRows = qrs.getNumberOfRows();
+		Assertions.assertEquals(4, numberOfRows, "The number of rows should be 4, got " + numberOfRows + " instead");
+
+		BigDecimal[] array1 = new BigDecimal[numberOfRows];
+		qrs.getDecimalColumnByIndex(1, array1);
+		Assertions.assertArrayEquals(new BigDecimal[]{new BigDecimal("1.60"), new BigDecimal("-12.32"), null,
+				new BigDecimal("99.99")}, array1, "Unscaled decimals not correctly appended");
+
+		BigDecimal[] array2 = new BigDecimal[numberOfRows];
+		qrs.getDecimalColumnByIndex(2, array2);
+		Assertions.assertArrayEquals(new BigDecimal[]{new BigDecimal("1.234"), new BigDecimal("1.236"),
+				new BigDecimal("-1.234"), null}, array2, "Unscaled decimals not correctly rescaled");
+		qrs.close();
+
+		try {
+			testunscaled.appendColumns(new Object[]{new long[]{10000L}, new long[]{1L}});
+			Assertions.fail("The MonetDBEmbeddedException should be thrown");
+		} catch (MonetDBEmbeddedException ex) {
+			//the decimal does not fit the column's precision
+		}
+
+		testunscaled.appendColumns(new Object[]{new long[]{6000000000000000000L, -6000000000000000000L,
+				4000000000000000000L}, new long[]{1L, 2L, 3L}}, new int[]{21, 3});
+		qrs = connection.executeQuery("SELECT a FROM testunscaled WHERE b < 0.01 ORDER BY b;");
+		BigDecimal[] array3 = new BigDecimal[3];
+		qrs.getDecimalColumnByIndex(1, array3);
+		Assertions.assertArrayEquals(new BigDecimal[]{new BigDecimal("0.01"), new BigDecimal("-0.01"),
+				new BigDecimal("0.00")}, array3, "Decimals 19 digits finer than the column not correctly rounded");
+		qrs.close();
+		connection.executeUpdate("DROP TABLE testunscaled;");
+	}
+
 	@Test
 	@Disabled("Who is brave enough to deal with timezones?")
 	@DisplayName("Test appending dates into a table")
@@ -778,6 +1204,48 @@ public class RegularAPITests extends MonetDBJavaLiteTesting {
 		connection.executeUpdate("DROP TABLE test6;");
 	}
 
+	@Test
+	@DisplayName("Test appending dates into a table from epoch primitives")
+	void testAppendEpochDates() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testepochs (a date, b time, c timestamp);");
+		MonetDBTable testepochs = connection.getMonetDBTable("sys", "testepochs");
+
+		int[] append1 = new int[]{0, 16801, -1, 11016, NullMappings.getIntNullConstant()};
+		long[] append2 = new long[]{0L, 83447000000L, 86399000000L, 36647000000L, NullMappings.getLongNullConstant()};
+		long[] append3 = new long[]{0L, 1478249984000000L, -1L, 951782400000000L, NullMappings.getLongNullConstant()};
+		Object[] appends = new Object[]{append1, append2, append3};
+		testepochs.appendColumns(appends);
+
+		QueryResultSet qrs = connection.executeQuery("SELECT CAST(a AS clob), CAST(b AS clob), CAST(c AS clob) FROM testepochs;");
+		int numberOfRows = qrs.getNumberOfRows();
+		Assertions.assertEquals(5, numberOfRows, "The number of rows should be 5, got " + numberOfRows + " instead");
+
+		String[] array1 = new String[5];
+		qrs.getStringColumnByIndex(1, array1);
+		Assertions.assertArrayEquals(new String[]{"1970-01-01", "2016-01-01", "1969-12-31", "2000-02-29", null},
+				array1, "Epoch days not correctly appended");
+
+		String[] array2 = new String[5];
+		qrs.getStringColumnByIndex(2, array2);
+		Assertions.assertArrayEquals(new String[]{"00:00:00", "23:10:47", "23:59:59", "10:10:47", null},
+				array2, "Micros of the day not correctly appended");
+
+		String[] array3 = new String[5];
+		qrs.getStringColumnByIndex(3, array3);
+		Assertions.assertArrayEquals(new String[]{"1970-01-01 00:00:00.000000", "2016-11-04 08:59:44.000000",
+				"1969-12-31 23:59:59.999999", "2000-02-29 00:00:00.000000", null}, array3,
+				"Epoch micros not correctly appended");
+		qrs.close();
+
+		try {
+			testepochs.appendColumns(new Object[]{new int[]{1}, new long[]{86400000000L}, new long[]{1L}});
+			Assertions.fail("The MonetDBEmbeddedException should be thrown");
+		} catch (MonetDBEmbeddedException ex) {
+			//the time is out of range
+		}
+		connection.executeUpdate("DROP TABLE testepochs;");
+	}
+
 	@Test
 	@DisplayName("Test appending BLOBs into a table")
 	void testAppendBlobs() throws Exception {
@@ -875,6 +1343,317 @@ public class RegularAPITests extends MonetDBJavaLiteTesting {
 		connection.executeUpdate("DROP TABLE testPrepared;");
 	}
 
+	@Test
+	@DisplayName("Test typed parameter binding of prepared statements")
+	void testPreparedStatementTypedParameters() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testTypedParameters (a bigint, b double, c real, d boolean, e clob, f blob);");
+
+		MonetDBEmbeddedPreparedStatement statement1 = connection.prepareStatement("INSERT INTO testTypedParameters VALUES (?, ?, ?, ?, ?, ?);");
+		statement1.setLong(1, Long.MAX_VALUE);
+		statement1.setDouble(2, 0.1);
+		statement1.setFloat(3, 1.1f);
+		statement1.setBoolean(4, true);
+		statement1.setString(5, "it's a \\ test");
+		statement1.setBytes(6, new byte[]{0, 1, -1, 127});
+		Assertions.assertEquals(1, statement1.executeUpdate(), "The insertion should have affected one row");
+
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> statement1.setInt(7, 1));
+		statement1.setNull(1, 0);
+		statement1.setString(5, null);
+		statement1.setBytes(6, null);
+		statement1.executeAndIgnore();
+
+		statement1.clearParameters();
+		Assertions.assertThrows(MonetDBEmbeddedException.class, statement1::executeUpdate);
+		statement1.close();
+
+		QueryResultSet qrs = connection.executeQuery("SELECT a, b, c, d, e, f FROM testTypedParameters ORDER BY a;");
+		Assertions.assertEquals(2, qrs.getNumberOfRows(), "The result set should have two rows");
+		Assertions.assertEquals(Long.MAX_VALUE, qrs.getLongByColumnIndexAndRow(1, 2), "Typed binding not working with Longs");
+		Assertions.assertEquals(0.1, qrs.getDoubleByColumnIndexAndRow(2, 2), "Typed binding not working with Doubles");
+		Assertions.assertEquals(1.1f, qrs.getFloatByColumnIndexAndRow(3, 2), "Typed binding not working with Floats");
+		Assertions.assertTrue(qrs.getBooleanByColumnIndexAndRow(4, 2), "Typed binding not working with Booleans");
+		Assertions.assertEquals("it's a \\ test", qrs.getStringByColumnIndexAndRow(5, 2), "Typed binding not working with Strings");
+		Assertions.assertArrayEquals(new byte[]{0, 1, -1, 127}, qrs.getBlobByColumnIndexAndRow(6, 2),
+				"Typed binding not working with Blobs");
+		Assertions.assertNull(qrs.getStringByColumnIndexAndRow(5, 1), "The string should be null");
+		qrs.close();
+
+		connection.executeUpdate("DROP TABLE testTypedParameters;");
+	}
+
+	@Test
+	@DisplayName("Test native binding of decimal and temporal parameters")
+	void testPreparedStatementTemporalParameters() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testTemporalParameters (a decimal(10,2), b date, c time, d timestamp, e varchar(3), f double);");
+
+		MonetDBEmbeddedPreparedStatement statement1 = connection.prepareStatement("INSERT INTO testTemporalParameters VALUES (?, ?, ?, ?, ?, ?);");
+		statement1.setBigDecimal(1, new BigDecimal("12345678.125"));
+		statement1.setDate(2, Date.valueOf("2019-03-04"));
+		statement1.setTime(3, Time.valueOf("10:11:12"));
+		statement1.setTimestamp(4, Timestamp.valueOf("2019-03-04 10:11:12.345"));
+		statement1.setString(5, "abc");
+		statement1.setDouble(6, Double.POSITIVE_INFINITY);
+		Assertions.assertEquals(1, statement1.executeUpdate(), "The insertion should have affected one row");
+
+		statement1.setDouble(6, Double.NaN);
+		Assertions.assertThrows(MonetDBEmbeddedException.class, statement1::executeUpdate, "NaN must not be bound");
+		statement1.setDouble(6, 1);
+		statement1.setString(5, "abcd");
+		Assertions.assertThrows(MonetDBEmbeddedException.class, statement1::executeUpdate, "The string exceeds the varchar");
+		statement1.setString(5, "xyz");
+		statement1.setString(2, "2020-01-02");
+		Assertions.assertEquals(1, statement1.executeUpdate(), "The prepared statement should be usable after failures");
+		statement1.close();
+
+		QueryResultSet qrs = connection.executeQuery("SELECT a, f FROM testTemporalParameters ORDER BY b;");
+		Assertions.assertEquals(2, qrs.getNumberOfRows(), "The result set should have two rows");
+		Assertions.assertEquals(new BigDecimal("12345678.13"), qrs.getDecimalByColumnIndexAndRow(1, 1), "Binding not working with Decimals");
+		Assertions.assertEquals(Double.POSITIVE_INFINITY, qrs.getDoubleByColumnIndexAndRow(2, 1), "Binding not working with Infinity");
+		qrs.close();
+		Assertions.assertEquals(1, connection.queryForLong("SELECT COUNT(*) FROM testTemporalParameters WHERE b = DATE '2019-03-04' " +
+				"AND c = TIME '10:11:12' AND d = TIMESTAMP '2019-03-04 10:11:12.345';"), "Binding not working with temporals");
+		Assertions.assertEquals(1, connection.queryForLong("SELECT COUNT(*) FROM testTemporalParameters WHERE b = DATE '2020-01-02';"),
+				"Binding not working with parsed Dates");
+
+		connection.executeUpdate("DROP TABLE testTemporalParameters;");
+	}
+
+	@Test
+	@DisplayName("Test batch execution of prepared statements")
+	void testPreparedStatementBatch() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testPreparedBatch (a int, b clob, c decimal(5,2));");
+
+		MonetDBEmbeddedPreparedStatement statement1 = connection.prepareStatement("INSERT INTO testPreparedBatch VALUES (?, ?, ?);");
+		int[] counts = statement1.executeBatch(new Object[]{new int[]{1, 2, NullMappings.getIntNullConstant()},
+				new String[]{"one", "it's two", null}, new Object[]{new BigDecimal("1.25"), null, 3}});
+		Assertions.assertArrayEquals(new int[]{1, 1, 1}, counts, "Each row should have inserted one row");
+
+		try {
+			statement1.executeBatch(new Object[]{new int[]{4, 5}, new String[]{"four", "five"},
+					new Object[]{BigDecimal.ONE, new BigDecimal("100000")}});
+			Assertions.fail("The MonetDBEmbeddedException should be thrown");
+		} catch (MonetDBEmbeddedException ex) {
+			//the second decimal exceeds the precision, so no row is inserted
+		}
+		statement1.close();
+
+		MonetDBEmbeddedPreparedStatement statement2 = connection.prepareStatement("UPDATE testPreparedBatch SET b=? WHERE a=?;");
+		counts = statement2.executeBatch(new Object[]{new String[]{"uno", "none"}, new long[]{1, 10}});
+		Assertions.assertArrayEquals(new int[]{1, 0}, counts, "The update counts are not the expected ones");
+		statement2.close();
+
+		QueryResultSet qrs = connection.executeQuery("SELECT a, b, c FROM testPreparedBatch ORDER BY a;");
+		Assertions.assertEquals(3, qrs.getNumberOfRows(), "The failed batch should have been rolled back");
+		String[] array1 = new String[3];
+		qrs.getStringColumnByIndex(2, array1);
+		Assertions.assertArrayEquals(new String[]{null, "uno", "it's two"}, array1, "Batch not working with Strings");
+		Assertions.assertEquals(new BigDecimal("1.25"), qrs.getDecimalByColumnIndexAndRow(3, 2), "Batch not working with Objects");
+		qrs.close();
+
+		connection.executeUpdate("DROP TABLE testPreparedBatch;");
+	}
+
+	@Test
+	@DisplayName("Test prepared statements with array parameters as IN lists")
+	void testPreparedStatementArrays() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testPreparedArrays (id bigint, v int);");
+		connection.executeUpdate("INSERT INTO testPreparedArrays VALUES (1, 10), (2, 20), (3, 30), (4, 40);");
+
+		MonetDBEmbeddedPreparedStatement statement = connection.prepareStatement("SELECT SUM(v) FROM testPreparedArrays WHERE id IN (?[BIGINT]) AND v > ?;");
+		Assertions.assertEquals(1, statement.getNumberOfArrayParameters(), "There should be one array parameter");
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> statement.setArray(1, new int[]{1}));
+		statement.setArray(1, new long[]{1, 3, 4, 7});
+		statement.setInt(1, 15);
+		QueryResultSet qrs = statement.executeQuery();
+		Assertions.assertEquals(70, qrs.getLongByColumnIndexAndRow(1, 1), "The array should filter the rows");
+		qrs.close();
+
+		statement.setArray(1, new long[]{2});
+		qrs = statement.executeQuery();
+		Assertions.assertEquals(20, qrs.getLongByColumnIndexAndRow(1, 1), "The array values should be replaced");
+		qrs.close();
+		statement.close();
+
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> connection.prepareStatement("SELECT * FROM testPreparedArrays WHERE id IN (?[TEXT]);"));
+
+		MonetDBEmbeddedPreparedStatement quoted = connection.prepareStatement("SELECT COUNT(*) AS \"n?[TEXT]\" FROM testPreparedArrays /* ?[TEXT] */ WHERE id IN (?[BIGINT]) -- ?[TEXT]\n AND 'it\\'s ?[TEXT]' <> '';");
+		Assertions.assertEquals(1, quoted.getNumberOfArrayParameters(), "The quoted and commented text should be left as it is");
+		quoted.setArray(1, new long[]{1, 2});
+		qrs = quoted.executeQuery();
+		Assertions.assertEquals(2, qrs.getLongByColumnIndexAndRow(1, 1), "The array should filter the rows");
+		qrs.close();
+		quoted.close();
+		connection.executeUpdate("DROP TABLE testPreparedArrays;");
+	}
+
+	@Test
+	@DisplayName("Test asynchronous queries")
+	void testAsyncQueries() throws MonetDBEmbeddedException, InterruptedException, ExecutionException {
+		connection.executeUpdate("CREATE TABLE testAsync (a int);");
+		CompletableFuture<Integer> update = connection.executeUpdateAsync("INSERT INTO testAsync VALUES (1), (2), (3)");
+		CompletableFuture<QueryResultSet> query = connection.executeQueryAsync("SELECT SUM(a) FROM testAsync");
+		Assertions.assertEquals(3, (int) update.get(), "The insertion should have affected three rows");
+		QueryResultSet qrs = query.get(); //submitted later, so it sees the insertion
+		Assertions.assertEquals(6, qrs.getLongByColumnIndexAndRow(1, 1), "The sum should be 6");
+		qrs.close();
+
+		try {
+			connection.executeQueryAsync("SELECT * FROM testAsyncMissing").get();
+			Assertions.fail("The ExecutionException should be thrown");
+		} catch (ExecutionException ex) {
+			Assertions.assertTrue(ex.getCause() instanceof MonetDBEmbeddedException, "The cause should be a MonetDBEmbeddedException");
+		}
+		connection.executeUpdate("DROP TABLE testAsync;");
+	}
+
+	@Test
+	@DisplayName("Test query timeouts and cancellation")
+	void testQueryTimeoutAndCancel() throws MonetDBEmbeddedException {
+		String heavyQuery = "SELECT COUNT(*) FROM sys.generate_series(0, 20000000) a WHERE a.value % 7 = 3;";
+		connection.setQueryTimeout(1);
+		Assertions.assertEquals(1, connection.getQueryTimeout(), "The query timeout was not set");
+		Assertions.assertThrows(MonetDBEmbeddedCancelledException.class, () -> connection.executeQuery(heavyQuery));
+		connection.setQueryTimeout(0);
+
+		connection.cancel(); //nothing running, the next query must not be affected
+		QueryResultSet qrs = connection.executeQuery("SELECT COUNT(*) FROM sys.generate_series(0, 100) a;");
+		Assertions.assertEquals(100, qrs.getLongByColumnIndexAndRow(1, 1), "The query after a cancel should run normally");
+		qrs.close();
+	}
+
+	@Test
+	@DisplayName("Test the connection pool")
+	void testConnectionPool() throws MonetDBEmbeddedException {
+		MonetDBEmbeddedDatabase.setConnectionPoolOptions(2, 0);
+		MonetDBEmbeddedConnection pooled1 = MonetDBEmbeddedDatabase.getPooledConnection();
+		String defaultSchema = pooled1.getSchema();
+		pooled1.setAutoCommit(false);
+		pooled1.executeUpdate("CREATE SCHEMA testpoolschema;");
+		pooled1.setSchema("testpoolschema");
+		pooled1.close();
+		Assertions.assertTrue(pooled1.isClosed(), "The pooled connection should be closed");
+		Assertions.assertEquals(1, MonetDBEmbeddedDatabase.getNumberOfIdleConnections(), "The context should be in the pool");
+
+		MonetDBEmbeddedConnection pooled2 = MonetDBEmbeddedDatabase.getPooledConnection();
+		Assertions.assertEquals(0, MonetDBEmbeddedDatabase.getNumberOfIdleConnections(), "The context should have been reused");
+		Assertions.assertEquals(defaultSchema, pooled2.getSchema(), "The schema should have been reset");
+		Assertions.assertTrue(pooled2.getAutoCommit(), "The autocommit mode should have been reset");
+		QueryResultSet qrs = pooled2.executeQuery("SELECT COUNT(*) FROM sys.schemas WHERE name='testpoolschema';");
+		Assertions.assertEquals(0, qrs.getLongByColumnIndexAndRow(1, 1), "The pending transaction should have been rolled back");
+		qrs.close();
+		pooled2.close();
+
+		MonetDBEmbeddedDatabase.setConnectionPoolOptions(0, 0);
+		Assertions.assertEquals(0, MonetDBEmbeddedDatabase.getNumberOfIdleConnections(), "The idle contexts should have been evicted");
+	}
+
+	@Test
+	@DisplayName("Test the execution of SQL scripts")
+	void testExecuteScript() throws MonetDBEmbeddedException {
+		int[] counts = connection.executeScript("CREATE TABLE testscript (a int, b text);\n" +
+				"-- the rows\n" +
+				"INSERT INTO testscript VALUES (1, 'one;'), (2, 'two');\n" +
+				"UPDATE testscript SET a = a + 10; /* all of them; */\n", true);
+		Assertions.assertArrayEquals(new int[]{-2, 2, 2}, counts, "The update counts are wrong");
+
+		MonetDBEmbeddedException ex = Assertions.assertThrows(MonetDBEmbeddedException.class,
+				() -> connection.executeBatch(new String[]{"INSERT INTO testscript VALUES (3, 'three')",
+						"INSERT INTO testscriptmissing VALUES (4)"}, true));
+		Assertions.assertTrue(ex.getMessage().startsWith("Statement 2:"), "The failing statement should be reported");
+		QueryResultSet qrs = connection.executeQuery("SELECT COUNT(*) FROM testscript;");
+		Assertions.assertEquals(2, qrs.getLongByColumnIndexAndRow(1, 1), "The transaction should have been rolled back");
+		qrs.close();
+
+		counts = connection.executeBatch(new String[]{"DELETE FROM testscript", "DROP TABLE testscript"});
+		Assertions.assertArrayEquals(new int[]{2, -2}, counts, "The update counts are wrong");
+	}
+
+	@Test
+	@DisplayName("Test the scalar query fast paths")
+	void testScalarQueries() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testscalar (a int, b decimal(8,2), c varchar(16));");
+		connection.executeUpdate("INSERT INTO testscalar VALUES (1, 1.50, 'one'), (2, 2.25, null);");
+		Assertions.assertEquals(2, connection.queryForLong("SELECT COUNT(*) FROM testscalar"), "The count is wrong");
+		Assertions.assertEquals(3.75, connection.queryForDouble("SELECT SUM(b) FROM testscalar"), 0.0001, "The sum is wrong");
+		Assertions.assertEquals(2, connection.queryForLong("SELECT MAX(b) FROM testscalar"), "The decimal should be truncated");
+		Assertions.assertEquals("one", connection.queryForString("SELECT c FROM testscalar WHERE a = 1"), "The string is wrong");
+		Assertions.assertEquals("2.25", connection.queryForString("SELECT b FROM testscalar WHERE a = 2"), "The decimal string is wrong");
+		Assertions.assertNull(connection.queryForString("SELECT c FROM testscalar WHERE a = 2"), "The value should be null");
+		Assertions.assertTrue(NullMappings.checkLongIsNull(connection.queryForLong("SELECT MAX(a) FROM testscalar WHERE a > 5")), "The value should be null");
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> connection.queryForLong("SELECT a FROM testscalar WHERE a > 5"));
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> connection.queryForLong("SELECT c FROM testscalar"));
+		connection.executeUpdate("DROP TABLE testscalar;");
+	}
+
+	@Test
+	@DisplayName("Test the table statistics")
+	void testTableStatistics() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE teststatistics (a int, b varchar(16));");
+		MonetDBTable table = connection.getMonetDBTable("teststatistics");
+		table.appendColumns(new Object[]{new int[]{1, 2, 3, 4}, new String[]{"d", null, "b", "a"}});
+
+		Assertions.assertEquals(4, table.getNumberOfRows(), "The number of rows is wrong");
+		MonetDBTableStatistics statistics = table.getTableStatistics();
+		Assertions.assertEquals(4, statistics.getNumberOfRows(), "The number of rows is wrong");
+		Assertions.assertEquals(0, statistics.getNumberOfDeletedRows(), "There should be no deleted rows");
+		Assertions.assertEquals(2, statistics.getNumberOfColumns(), "The number of columns is wrong");
+		if (statistics.areColumnPropertiesKnown(1) && statistics.isSorted(1) && statistics.getNilCount(1) == 0) {
+			Assertions.assertEquals("1", statistics.getMinimum(1), "The minimum is wrong");
+			Assertions.assertEquals("4", statistics.getMaximum(1), "The maximum is wrong");
+		}
+		Assertions.assertNotEquals(0, statistics.getNilCount(2), "The second column has a null");
+
+		connection.executeUpdate("DELETE FROM teststatistics WHERE a = 2;");
+		statistics = table.getTableStatistics();
+		Assertions.assertEquals(3, statistics.getNumberOfRows(), "The deleted row should not be counted");
+		Assertions.assertEquals(3, table.getNumberOfRows(), "The deleted row should not be counted");
+		Assertions.assertFalse(statistics.areColumnPropertiesKnown(1), "The deletes hide the column properties");
+		Assertions.assertThrows(ArrayIndexOutOfBoundsException.class, () -> table.getTableStatistics().getNilCount(3));
+		connection.executeUpdate("DROP TABLE teststatistics;");
+	}
+
+	@Test
+	@DisplayName("Test the plan cache of a connection")
+	void testPlanCache() throws MonetDBEmbeddedException {
+		MonetDBEmbeddedConnection cached = MonetDBEmbeddedDatabase.createConnection();
+		cached.setPlanCacheSize(2);
+		cached.executeUpdate("CREATE TABLE testplancache (a int, b varchar(32));");
+		for (int i = 0; i < 10; i++) {
+			Assertions.assertEquals(1, cached.executeUpdate("INSERT INTO testplancache VALUES (" + i + ", 'row''" + i + "');"), "One row should be inserted");
+		}
+		Assertions.assertEquals(1, cached.getNumberOfCachedPlans(), "The inserts should share the same plan");
+
+		QueryResultSet qrs = cached.executeQuery("SELECT b FROM testplancache WHERE a = 7;");
+		Assertions.assertEquals("row'7", qrs.getStringByColumnIndexAndRow(1, 1), "The literals should be bound");
+		qrs.close();
+		qrs = cached.executeQuery("SELECT b FROM testplancache WHERE a = -1 OR b = 'row''3';");
+		Assertions.assertEquals(1, qrs.getNumberOfRows(), "The negative and string literals should be bound");
+		qrs.close();
+		Assertions.assertEquals(2, cached.getNumberOfCachedPlans(), "The least recently used plan should be evicted");
+
+		cached.executeUpdate("ALTER TABLE testplancache ADD COLUMN c int;");
+		Assertions.assertEquals(0, cached.getNumberOfCachedPlans(), "The DDL should invalidate the plans");
+		qrs = cached.executeQuery("SELECT * FROM testplancache WHERE a = 1;");
+		Assertions.assertEquals(3, qrs.getNumberOfColumns(), "The plan should see the new column");
+		qrs.close();
+
+		cached.executeUpdate("CREATE TABLE testplancachetypes (d decimal(10,2), s varchar(3));");
+		cached.executeUpdate("INSERT INTO testplancachetypes VALUES (1.23, 'abc');");
+		qrs = cached.executeQuery("SELECT COUNT(*) FROM testplancachetypes WHERE d = 1.234;");
+		Assertions.assertEquals(0, qrs.getLongByColumnIndexAndRow(1, 1), "The decimal should not be rounded to the parameter scale");
+		qrs.close();
+		qrs = cached.executeQuery("SELECT COUNT(*) FROM testplancachetypes WHERE s = 'abcd';");
+		Assertions.assertEquals(0, qrs.getLongByColumnIndexAndRow(1, 1), "The string should not fail against the parameter length");
+		qrs.close();
+		cached.executeUpdate("DROP TABLE testplancachetypes;");
+
+		cached.executeUpdate("DROP TABLE testplancache;");
+		cached.setPlanCacheSize(0);
+		Assertions.assertEquals(0, cached.getPlanCacheSize(), "The plan cache should be disabled");
+		cached.close();
+	}
+
 	@Test
 	@DisplayName("Test regular expressions (we removed the pcre dependency from MonetDBLite recently)")
 	void testRegexes() throws MonetDBEmbeddedException {
@@ -957,6 +1736,147 @@ public class RegularAPITests extends MonetDBJavaLiteTesting {
 		Assertions.assertEquals(-2, rows2, "The deletion should have affected no rows");
 	}
 
+	@Test
+	@DisplayName("Test the CSV bulk load from an InputStream")
+	void testCopyIntoFromStream() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testCSVStream (a TEXT, b INT, c real);");
+		String csvToImport = "a;b;c\n\"first\";1;2.5\nNULL;NULL;-1\n\"third;with separator\";3;NULL\n";
+		InputStream in = new ByteArrayInputStream(csvToImport.getBytes(StandardCharsets.UTF_8));
+		CopyOptions options = new CopyOptions().setColumnSeparator(";").setNullString("NULL").setSkipRecords(1)
+				.setBufferSize(7); //force several reads from the stream
+		long rows = connection.copyInto("sys", "testCSVStream", in, options);
+		Assertions.assertEquals(3, rows, "The number of rows loaded should be 3, got " + rows + " instead");
+
+		QueryResultSet qrs = connection.executeQuery("SELECT a, b FROM testCSVStream;");
+		String[] array1 = new String[3];
+		qrs.getStringColumnByIndex(1, array1);
+		Assertions.assertArrayEquals(new String[]{"first", null, "third;with separator"}, array1,
+				"CSV stream not working with Strings");
+		int[] array2 = new int[3];
+		qrs.getIntColumnByIndex(2, array2);
+		Assertions.assertArrayEquals(new int[]{1, NullMappings.getIntNullConstant(), 3}, array2,
+				"CSV stream not working with Integers");
+		qrs.close();
+
+		try {
+			connection.copyInto("sys", "testCSVStream",
+					new ByteArrayInputStream("\"bad\";notanumber;1\n".getBytes(StandardCharsets.UTF_8)), options.setSkipRecords(0));
+			Assertions.fail("The MonetDBEmbeddedException should be thrown");
+		} catch (MonetDBEmbeddedException ex) {
+			//the second column is not an integer
+		}
+		connection.executeUpdate("DROP TABLE testCSVStream;");
+	}
+
+	@Test
+	@DisplayName("Test binary imports from ByteBuffers")
+	void testCopyBinaryIntoFromBuffers() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testBinaryBuffers (a INT, b TEXT, c DOUBLE);");
+		int[] data1 = {137, -89, 82, 0, NullMappings.getIntNullConstant()};
+		ByteBuffer column1 = ByteBuffer.allocateDirect(data1.length * 4).order(ByteOrder.nativeOrder());
+		column1.asIntBuffer().put(data1);
+		ByteBuffer column2 = ByteBuffer.wrap("a\nbinary\nimport\ntest\n\n".getBytes(StandardCharsets.UTF_8));
+		double[] data3 = {1.5, -2.25, 0.0, 1e10, -0.5};
+		ByteBuffer column3 = ByteBuffer.allocate(data3.length * 8).order(ByteOrder.BIG_ENDIAN); //swapped if needed
+		column3.asDoubleBuffer().put(data3);
+
+		long rows = connection.copyBinaryInto("sys", "testBinaryBuffers", new ByteBuffer[]{column1, column2, column3});
+		Assertions.assertEquals(5, rows, "The number of rows loaded should be 5, got " + rows + " instead");
+
+		QueryResultSet qrs = connection.executeQuery("SELECT a, b, c FROM testBinaryBuffers;");
+		int[] array1 = new int[5];
+		qrs.getIntColumnByIndex(1, array1);
+		Assertions.assertArrayEquals(data1, array1, "Binary buffers not working with Integers");
+		String[] array2 = new String[5];
+		qrs.getStringColumnByIndex(2, array2);
+		Assertions.assertArrayEquals(new String[]{"a", "binary", "import", "test", ""}, array2,
+				"Binary buffers not working with Strings");
+		double[] array3 = new double[5];
+		qrs.getDoubleColumnByIndex(3, array3);
+		Assertions.assertArrayEquals(data3, array3, "Binary buffers not working with Doubles");
+		qrs.close();
+
+		try {
+			connection.copyBinaryInto("sys", "testBinaryBuffers", new ByteBuffer[]{ByteBuffer.allocate(6),
+					ByteBuffer.wrap("a\nb\n".getBytes(StandardCharsets.UTF_8)), ByteBuffer.allocate(16)});
+			Assertions.fail("The MonetDBEmbeddedException should be thrown");
+		} catch (MonetDBEmbeddedException ex) {
+			//the integer image is not a multiple of 4 bytes
+		}
+		connection.executeUpdate("DROP TABLE testBinaryBuffers;");
+	}
+
+	@Test
+	@DisplayName("Test joining Java columns registered as a view with a table")
+	void testRegisterView() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testviewjoin (id BIGINT, name TEXT);");
+		connection.executeUpdate("INSERT INTO testviewjoin VALUES (1, 'one'), (2, 'two'), (3, 'three');");
+		LongBuffer ids = ByteBuffer.allocateDirect(4 * 8).order(ByteOrder.nativeOrder()).asLongBuffer();
+		ids.put(new long[]{3, 1, 4, 1}).flip();
+		connection.registerView("appdata", new String[]{"id", "weight"}, new Object[]{ids, new double[]{0.5, 1, 2, 4}});
+
+		QueryResultSet qrs = connection.executeQuery("SELECT t.name, SUM(a.weight) FROM testviewjoin t JOIN appdata a ON t.id = a.id GROUP BY t.name ORDER BY t.name;");
+		Assertions.assertEquals(2, qrs.getNumberOfRows(), "The view should join with the table");
+		String[] names = new String[2];
+		qrs.getStringColumnByIndex(1, names);
+		Assertions.assertArrayEquals(new String[]{"one", "three"}, names, "The joined rows are wrong");
+		double[] weights = new double[2];
+		qrs.getDoubleColumnByIndex(2, weights);
+		Assertions.assertArrayEquals(new double[]{5, 0.5}, weights, "The view values are wrong");
+		qrs.close();
+
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> connection.executeUpdate("UPDATE appdata SET id = 0;"),
+				"The view should be read-only");
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> connection.executeUpdate("INSERT INTO appdata VALUES (5, 1);"),
+				"The view should be read-only");
+		Assertions.assertEquals(3, ids.get(0), "The buffer should not be changed by the query");
+
+		Assertions.assertThrows(IllegalArgumentException.class, () -> connection.registerView("bad",
+				new Object[]{ByteBuffer.allocate(8).asLongBuffer()}));
+		connection.unregisterView("appdata");
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> connection.executeQuery("SELECT * FROM appdata;"));
+		connection.executeUpdate("DROP TABLE testviewjoin;");
+	}
+
+	@Test
+	@DisplayName("Test the materialization of a result set into a table")
+	void testMaterializeResultSet() throws MonetDBEmbeddedException {
+		connection.executeUpdate("CREATE TABLE testmaterialize (a INT, b VARCHAR(8), c DECIMAL(6,2));");
+		connection.executeUpdate("INSERT INTO testmaterialize VALUES (1, 'one', 1.5), (2, NULL, 2.25), (3, 'three', NULL);");
+		QueryResultSet qrs = connection.executeQuery("SELECT CAST(a * 10 AS INT) AS ten, b, c FROM testmaterialize WHERE a > 1;");
+		qrs.materializeAs(null, "stage1", true);
+		qrs.materializeAs(null, "testmaterialized", false);
+		Assertions.assertThrows(MonetDBEmbeddedException.class, () -> qrs.materializeAs("sys", "stage2", true));
+
+		connection.executeUpdate("UPDATE tmp.stage1 SET ten = 0;");
+		int[] tens = new int[2];
+		qrs.getIntColumnByIndex(1, tens);
+		Assertions.assertArrayEquals(new int[]{20, 30}, tens, "The result set should not see the table changes");
+		qrs.close();
+
+		QueryResultSet stage = connection.executeQuery("SELECT ten, b, c FROM testmaterialized ORDER BY ten;");
+		Assertions.assertEquals(2, stage.getNumberOfRows(), "The table should have the result rows");
+		stage.getIntColumnByIndex(1, tens);
+		Assertions.assertArrayEquals(new int[]{20, 30}, tens, "The materialized values are wrong");
+		String[] strings = new String[2];
+		stage.getStringColumnByIndex(2, strings);
+		Assertions.assertArrayEquals(new String[]{null, "three"}, strings, "The materialized strings are wrong");
+		BigDecimal[] decimals = new BigDecimal[2];
+		stage.getDecimalColumnByIndex(3, decimals);
+		Assertions.assertArrayEquals(new BigDecimal[]{new BigDecimal("2.25"), null}, decimals, "The materialized decimals are wrong");
+		String[] types = new String[3];
+		stage.getColumnTypes(types);
+		Assertions.assertArrayEquals(new String[]{"int", "varchar", "decimal"}, types, "The column types are wrong");
+		stage.close();
+
+		QueryResultSet temp = connection.executeQuery("SELECT COUNT(*) FROM tmp.stage1 WHERE ten = 0;");
+		Assertions.assertEquals(2L, temp.getLongByColumnIndexAndRow(1, 1), "The temporary table should have the rows");
+		temp.close();
+		connection.executeUpdate("DROP TABLE tmp.stage1;");
+		connection.executeUpdate("DROP TABLE testmaterialized;");
+		connection.executeUpdate("DROP TABLE testmaterialize;");
+	}
+
 	@Test
 	@DisplayName("Test binary imports")
 	void testBinaryImport() throws IOException, MonetDBEmbeddedException {
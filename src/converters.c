@@ -191,11 +191,7 @@ FETCHING_LEVEL_FOUR(Blob, jbyteArray, GET_BAT_BLOB, CHECK_NULL_BLOB, BAT_TO_JBLO
 		if (inputConverted == NULL) { \
 			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL); \
 		} else { \
-			if(isCopy == JNI_FALSE) { \
-				memcpy(inputConverted, array + first, size * INTERNAL_SIZE); \
-			} else { \
-				(*env)->Set##ARRAY_FUNCTION_NAME##ArrayRegion(env, input, first, size, array); \
-			} \
+			memcpy(inputConverted, array + first, size * INTERNAL_SIZE); \
 			(*env)->ReleasePrimitiveArrayCritical(env, input, inputConverted, 0); \
 		} \
 	}
@@ -409,7 +405,7 @@ BATCH_LEVEL_THREE(lng, lng)
 		ONE_CAST nvalue; \
 		TWO_CAST value; \
 		if (b->tnonil && !b->tnil) { \
-			for (p = first, q = (BUN) size; p < q; p++) { \
+			for (p = (BUN) first, q = (BUN) first + (BUN) size; p < q; p++) { \
 				GET_ATOM \
 				CONVERT_ATOM \
 				(*env)->SetObjectArrayElement(env, input, i, value); \
@@ -417,7 +413,7 @@ BATCH_LEVEL_THREE(lng, lng)
 				(*env)->DeleteLocalRef(env, value); \
 			} \
 		} else { \
-			for (p = (BUN) first, q = (BUN) size; p < q; p++) { \
+			for (p = (BUN) first, q = (BUN) first + (BUN) size; p < q; p++) { \
 				GET_ATOM \
 				if (CHECK_NOT_NULL) { \
 					CONVERT_ATOM \
@@ -552,6 +548,120 @@ CONVERSION_LEVEL_TWO(Date, date, JDATE_TO_BAT)
 CONVERSION_LEVEL_TWO(Time, daytime, JTIME_TO_BAT)
 CONVERSION_LEVEL_TWO(Timestamp, timestamp, JTIMESTAMP_TO_BAT)
 
+/* The same temporal types from primitive epoch arrays, so no upcall per row */
+
+#ifndef YEAR_MIN
+#define YEAR_MIN        (-4712)
+#endif
+#ifndef YEAR_MAX
+#define YEAR_MAX        (YEAR_MIN + (1 << 21) / 12 - 1)
+#endif
+
+/* Proleptic Gregorian civil date from days since 1970-01-01 (H. Hinnant's days_from_civil inverse) */
+date epochDaysToDate(lng days) {
+	lng z = days + 719468, era, doe, yoe, doy, mp, y;
+	int m, d;
+
+	era = (z >= 0 ? z : z - 146096) / 146097;
+	doe = z - era * 146097;
+	yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	y = yoe + era * 400;
+	doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	mp = (5 * doy + 2) / 153;
+	d = (int) (doy - (153 * mp + 2) / 5 + 1);
+	m = (int) (mp < 10 ? mp + 3 : mp - 9);
+	if (m <= 2)
+		y++;
+	if (y < YEAR_MIN || y > YEAR_MAX) /* date_create does not validate */
+		return date_nil;
+	return date_create((int) y, m, d);
+}
+
+timestamp epochMicrosToTimestamp(lng micros) {
+	lng days = micros / EPOCH_DAY_USEC;
+	date nday;
+
+	if (micros % EPOCH_DAY_USEC < 0)
+		days--;
+	if (is_date_nil(nday = epochDaysToDate(days)))
+		return timestamp_nil;
+	return timestamp_create(nday, (daytime) (micros - days * EPOCH_DAY_USEC));
+}
+
+#define EPOCH_DAYS_TO_BAT        if (is_date_nil(*p = epochDaysToDate((lng) value))) \
+									 goto invalid;
+
+#define MICROS_OF_DAY_TO_BAT     if (value < 0 || value >= EPOCH_DAY_USEC) \
+									 goto invalid; \
+								 *p = (daytime) value;
+
+#define EPOCH_MICROS_TO_BAT      if (is_timestamp_nil(*p = epochMicrosToTimestamp((lng) value))) \
+									 goto invalid;
+
+#define CONVERSION_LEVEL_FIVE(NAME, BAT_CAST, JAVA_CAST, COPY_METHOD, CONVERT_TO_BAT) \
+	void store##NAME##Column(JNIEnv *env, BAT** b, JAVA_CAST##Array data, size_t cnt, jint localtype) { \
+		BAT *aux = COLnew(0, localtype, cnt, TRANSIENT); \
+		BAT_CAST *p, prev = BAT_CAST##_nil; \
+		JAVA_CAST *values, value; \
+		size_t i; \
+		if (!aux) { \
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL); \
+			*b = NULL; \
+			return; \
+		} \
+		if (!(values = (*env)->Get##COPY_METHOD##ArrayElements(env, data, NULL))) { \
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL); \
+			BBPreclaim(aux); \
+			*b = NULL; \
+			return; \
+		} \
+		aux->tnil = 0; \
+		aux->tnonil = 1; \
+		aux->tkey = 0; \
+		aux->tsorted = 1; \
+		aux->trevsorted = 1; \
+		p = (BAT_CAST *) Tloc(aux, 0); \
+		for(i = 0; i < cnt; i++, p++) { \
+			if ((value = values[i]) == JAVA_CAST##_nil) { \
+				aux->tnil = 1; \
+				aux->tnonil = 0; \
+				*p = BAT_CAST##_nil; \
+			} else { \
+				CONVERT_TO_BAT \
+			} \
+			if (i > 0) { \
+				if (*p > prev && aux->trevsorted) { \
+					aux->trevsorted = 0; \
+				} else if (*p < prev && aux->tsorted) { \
+					aux->tsorted = 0; \
+				} \
+			} \
+			prev = *p; \
+		} \
+		(*env)->Release##COPY_METHOD##ArrayElements(env, data, values, JNI_ABORT); \
+		BATsetcount(aux, cnt); \
+		BATsettrivprop(aux); \
+		BBPkeepref(aux->batCacheid); \
+		*b = aux; \
+		return; \
+invalid: \
+		(*env)->Release##COPY_METHOD##ArrayElements(env, data, values, JNI_ABORT); \
+		BBPreclaim(aux); \
+		*b = NULL; \
+		{ \
+			char msg[128]; \
+			snprintf(msg, sizeof(msg), "The value " LLFMT " at row " SZFMT " is out of range for a " #BAT_CAST, (lng) value, i + 1); \
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), msg); \
+		} \
+	}
+
+#define jint_nil  ((jint) int_nil)
+#define jlong_nil ((jlong) lng_nil)
+
+CONVERSION_LEVEL_FIVE(DateFromEpochDays, date, jint, Int, EPOCH_DAYS_TO_BAT)
+CONVERSION_LEVEL_FIVE(TimeFromMicros, daytime, jlong, Long, MICROS_OF_DAY_TO_BAT)
+CONVERSION_LEVEL_FIVE(TimestampFromEpochMicros, timestamp, jlong, Long, EPOCH_MICROS_TO_BAT)
+
 void storeOidColumn(JNIEnv *env, BAT** b, jobjectArray data, size_t cnt, jint localtype) {
 	BAT *aux = COLnew(0, localtype, cnt, TRANSIENT);
 	size_t slen = sizeof(oid);
@@ -674,6 +784,151 @@ CONVERSION_LEVEL_THREE(sht)
 CONVERSION_LEVEL_THREE(int)
 CONVERSION_LEVEL_THREE(lng)
 
+/* Unscaled fixed point longs are rescaled with integer arithmetic only */
+
+static const lng decimalPowers[19] = {1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL,
+	100000000LL, 1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL, 100000000000000LL,
+	1000000000000000LL, 10000000000000000LL, 100000000000000000LL, 1000000000000000000LL};
+
+/* The half of 10^19, which fits a long unlike 10^19 itself */
+static const lng decimalHalfMax = 5000000000000000000LL;
+
+/* The rounding modes follow the java.math.BigDecimal ROUND_* constants */
+static const char* rescaleDecimal(lng value, int shift, jint roundingMode, lng *res) {
+	lng q, r, absr, d;
+	int half, sign = value < 0 ? -1 : 1, increment;
+
+	if (shift >= 0) {
+		if (shift > 18) {
+			if (value != 0)
+				return "overflows";
+			*res = 0;
+			return NULL;
+		}
+		d = decimalPowers[shift];
+		if (value > LLONG_MAX / d || value < -LLONG_MAX / d)
+			return "overflows";
+		*res = value * d;
+		return NULL;
+	}
+	shift = -shift;
+	if (shift > 19) { /* the remainder is always less than half of the divisor */
+		q = 0;
+		r = value;
+		half = -1;
+	} else if (shift == 19) { /* the divisor overflows, but its half still fits */
+		q = 0;
+		r = value;
+		half = (value > decimalHalfMax || value < -decimalHalfMax) - (value < decimalHalfMax && value > -decimalHalfMax);
+	} else {
+		d = decimalPowers[shift];
+		q = value / d;
+		r = value % d;
+		absr = r < 0 ? -r : r;
+		half = (2 * absr > d) - (2 * absr < d);
+	}
+	if (r == 0) {
+		*res = q;
+		return NULL;
+	}
+	switch (roundingMode) {
+		case 0: /* ROUND_UP */
+			increment = 1;
+			break;
+		case 1: /* ROUND_DOWN */
+			increment = 0;
+			break;
+		case 2: /* ROUND_CEILING */
+			increment = sign > 0;
+			break;
+		case 3: /* ROUND_FLOOR */
+			increment = sign < 0;
+			break;
+		case 4: /* ROUND_HALF_UP */
+			increment = half >= 0;
+			break;
+		case 5: /* ROUND_HALF_DOWN */
+			increment = half > 0;
+			break;
+		case 6: /* ROUND_HALF_EVEN */
+			increment = half > 0 || (half == 0 && (q & 1));
+			break;
+		default: /* ROUND_UNNECESSARY */
+			return "requires rounding";
+	}
+	*res = increment ? q + sign : q;
+	return NULL;
+}
+
+#define CONVERSION_LEVEL_SIX(BAT_CAST) \
+	void storeDecimal##BAT_CAST##FromUnscaledColumn(JNIEnv *env, BAT** b, jlongArray data, size_t cnt, jint localtype, jint digits, jint scale, jint inputScale, jint roundingMode) { \
+		BAT *aux = COLnew(0, localtype, cnt, TRANSIENT); \
+		BAT_CAST *p, prev = BAT_CAST##_nil; \
+		jlong *values; \
+		lng next, limit = digits < 19 ? decimalPowers[digits] : LLONG_MAX; \
+		const char *msg = NULL; \
+		size_t i; \
+		if (!aux) { \
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL); \
+			*b = NULL; \
+			return; \
+		} \
+		if (!(values = (*env)->GetLongArrayElements(env, data, NULL))) { \
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL); \
+			BBPreclaim(aux); \
+			*b = NULL; \
+			return; \
+		} \
+		aux->tnil = 0; \
+		aux->tnonil = 1; \
+		aux->tkey = 0; \
+		aux->tsorted = 1; \
+		aux->trevsorted = 1; \
+		p = (BAT_CAST *) Tloc(aux, 0); \
+		for(i = 0; i < cnt; i++, p++) { \
+			if (is_lng_nil(values[i])) { \
+				aux->tnil = 1; \
+				aux->tnonil = 0; \
+				*p = BAT_CAST##_nil; \
+			} else { \
+				if ((msg = rescaleDecimal((lng) values[i], scale - inputScale, roundingMode, &next)) != NULL) \
+					break; \
+				if (next >= limit || next <= -limit) { \
+					msg = "does not fit the column's precision"; \
+					break; \
+				} \
+				*p = (BAT_CAST) next; \
+			} \
+			if (i > 0) { \
+				if (*p > prev && aux->trevsorted) { \
+					aux->trevsorted = 0; \
+				} else if (*p < prev && aux->tsorted) { \
+					aux->tsorted = 0; \
+				} \
+			} \
+			prev = *p; \
+		} \
+		if (msg) { \
+			char buf[128]; \
+			snprintf(buf, sizeof(buf), "The decimal " LLFMT " at row " SZFMT " %s", (lng) values[i], i + 1, msg); \
+			(*env)->ReleaseLongArrayElements(env, data, values, JNI_ABORT); \
+			BBPreclaim(aux); \
+			*b = NULL; \
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), buf); \
+			return; \
+		} \
+		(*env)->ReleaseLongArrayElements(env, data, values, JNI_ABORT); \
+		BATsetcount(aux, cnt); \
+		BATsettrivprop(aux); \
+		BBPkeepref(aux->batCacheid); \
+		*b = aux; \
+	}
+
+CONVERSION_LEVEL_SIX(bte)
+CONVERSION_LEVEL_SIX(sht)
+CONVERSION_LEVEL_SIX(int)
+CONVERSION_LEVEL_SIX(lng)
+
 /* Put in the BAT's heap */
 
 #define JSTRING_TO_BAT      if ((nvalue = (*env)->GetStringUTFChars(env, value, 0)) == NULL) { \
@@ -12,6 +12,7 @@
 #include "monetdb_config.h"
 #include "jni.h"
 #include "gdk.h"
+#include "mtime.h"
 
 /* --  Get just a single value -- */
 
@@ -83,12 +84,24 @@ java_export void storeDoubleColumn(JNIEnv* env, BAT** b, jdoubleArray input, siz
 java_export void storeDateColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype);
 java_export void storeTimeColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype);
 java_export void storeTimestampColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype);
+java_export void storeDateFromEpochDaysColumn(JNIEnv* env, BAT** b, jintArray input, size_t cnt, jint localtype);
+java_export void storeTimeFromMicrosColumn(JNIEnv* env, BAT** b, jlongArray input, size_t cnt, jint localtype);
+java_export void storeTimestampFromEpochMicrosColumn(JNIEnv* env, BAT** b, jlongArray input, size_t cnt, jint localtype);
 java_export void storeOidColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype);
 
+/* Days since 1970-01-01 and microseconds since 1970-01-01 00:00:00 to MonetDB temporals, nil when out of range */
+#define EPOCH_DAY_USEC  86400000000LL
+java_export date epochDaysToDate(lng days);
+java_export timestamp epochMicrosToTimestamp(lng micros);
+
 java_export void storeDecimalbteColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype, jint scale, jint roundingMode);
 java_export void storeDecimalshtColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype, jint scale, jint roundingMode);
 java_export void storeDecimalintColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype, jint scale, jint roundingMode);
 java_export void storeDecimallngColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype, jint scale, jint roundingMode);
+java_export void storeDecimalbteFromUnscaledColumn(JNIEnv* env, BAT** b, jlongArray input, size_t cnt, jint localtype, jint digits, jint scale, jint inputScale, jint roundingMode);
+java_export void storeDecimalshtFromUnscaledColumn(JNIEnv* env, BAT** b, jlongArray input, size_t cnt, jint localtype, jint digits, jint scale, jint inputScale, jint roundingMode);
+java_export void storeDecimalintFromUnscaledColumn(JNIEnv* env, BAT** b, jlongArray input, size_t cnt, jint localtype, jint digits, jint scale, jint inputScale, jint roundingMode);
+java_export void storeDecimallngFromUnscaledColumn(JNIEnv* env, BAT** b, jlongArray input, size_t cnt, jint localtype, jint digits, jint scale, jint inputScale, jint roundingMode);
 
 java_export void storeStringColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype);
 java_export void storeBlobColumn(JNIEnv* env, BAT** b, jobjectArray input, size_t cnt, jint localtype);
@@ -14,6 +14,7 @@
 /* Embedded database environment Classes */
 static jmethodID monetDBEmbeddedDatabaseConstructorID = NULL;
 static jclass monetDBEmbeddedExceptionClassID = NULL;
+static jclass monetDBEmbeddedCancelledExceptionClassID = NULL;
 static jclass monetDBEmbeddedConnectionClassID = NULL;
 static jmethodID monetDBEmbeddedConnectionConstructorID = NULL;
 static jclass jDBCEmbeddedConnectionClassID = NULL;
@@ -100,18 +101,20 @@ static jfieldID getConnectionID = NULL;
 static jfieldID getConnectionLongID = NULL;
 static jfieldID getSchemaID = NULL;
 static jfieldID getTableID = NULL;
+static jfieldID tableDescriptorPointerID = NULL;
 
 static jmethodID bigDecimalToStringID = NULL;
 static jmethodID setBigDecimalScaleID = NULL;
 static jmethodID dateToLongID = NULL;
 static jmethodID timeToLongID = NULL;
 static jmethodID timestampToLongID = NULL;
+static jmethodID inputStreamReadID = NULL;
 
 int initializeIDS(JNIEnv *env) {
 	/* Embedded database environment Classes */
 
 	jobject tempLocalRef;
-	jclass embeddedDataBlockResponseClass, monetDBEmbeddedDatabaseClass, tableClass;
+	jclass embeddedDataBlockResponseClass, monetDBEmbeddedDatabaseClass, tableClass, inputStreamClass;
 
 	monetDBEmbeddedDatabaseClass = (*env)->FindClass(env, "nl/cwi/monetdb/embedded/env/MonetDBEmbeddedDatabase");
 
@@ -126,6 +129,13 @@ int initializeIDS(JNIEnv *env) {
 		return 0;
 	}
 
+	tempLocalRef = (jobject) (*env)->FindClass(env, "nl/cwi/monetdb/embedded/env/MonetDBEmbeddedCancelledException");
+	monetDBEmbeddedCancelledExceptionClassID = (jclass) (*env)->NewGlobalRef(env, tempLocalRef);
+	(*env)->DeleteLocalRef(env, tempLocalRef);
+	if(!tempLocalRef || !monetDBEmbeddedCancelledExceptionClassID) {
+		return 0;
+	}
+
 	tempLocalRef = (jobject) (*env)->FindClass(env, "nl/cwi/monetdb/embedded/env/MonetDBEmbeddedConnection");
 	monetDBEmbeddedConnectionClassID = (jclass) (*env)->NewGlobalRef(env, tempLocalRef);
 	(*env)->DeleteLocalRef(env, tempLocalRef);
@@ -449,6 +459,7 @@ int initializeIDS(JNIEnv *env) {
 	getConnectionLongID = (*env)->GetFieldID(env, monetDBEmbeddedConnectionClassID, "connectionPointer", "J");
 	getSchemaID = (*env)->GetFieldID(env, tableClass, "tableSchema", "Ljava/lang/String;");
 	getTableID = (*env)->GetFieldID(env, tableClass, "tableName", "Ljava/lang/String;");
+	tableDescriptorPointerID = (*env)->GetFieldID(env, tableClass, "descriptorPointer", "J");
 	(*env)->DeleteLocalRef(env, tableClass);
 
 	bigDecimalToStringID = (*env)->GetMethodID(env, bigDecimalClassID, "toPlainString", "()Ljava/lang/String;");
@@ -457,6 +468,13 @@ int initializeIDS(JNIEnv *env) {
 	timeToLongID = (*env)->GetMethodID(env, timeClassID, "getTime", "()J");
 	timestampToLongID = (*env)->GetMethodID(env, timestampClassID, "getTime", "()J");
 
+	inputStreamClass = (*env)->FindClass(env, "java/io/InputStream");
+	if(!inputStreamClass) {
+		return 0;
+	}
+	inputStreamReadID = (*env)->GetMethodID(env, inputStreamClass, "read", "([BII)I");
+	(*env)->DeleteLocalRef(env, inputStreamClass);
+
 	return 1;
 }
 
@@ -466,6 +484,10 @@ void releaseIDS(JNIEnv *env) {
 		(*env)->DeleteGlobalRef(env, monetDBEmbeddedExceptionClassID);
 		monetDBEmbeddedExceptionClassID = NULL;
 	}
+	if(monetDBEmbeddedCancelledExceptionClassID) {
+		(*env)->DeleteGlobalRef(env, monetDBEmbeddedCancelledExceptionClassID);
+		monetDBEmbeddedCancelledExceptionClassID = NULL;
+	}
 	if(jDBCEmbeddedConnectionClassID) {
 		(*env)->DeleteGlobalRef(env, jDBCEmbeddedConnectionClassID);
 		jDBCEmbeddedConnectionClassID = NULL;
@@ -621,6 +643,10 @@ jclass getMonetDBEmbeddedExceptionClassID(void) {
 	return monetDBEmbeddedExceptionClassID;
 }
 
+jclass getMonetDBEmbeddedCancelledExceptionClassID(void) {
+	return monetDBEmbeddedCancelledExceptionClassID;
+}
+
 jclass getMonetDBEmbeddedConnectionClassID(void) {
 	return monetDBEmbeddedConnectionClassID;
 }
@@ -911,6 +937,10 @@ jfieldID getGetTableID(void) {
 	return getTableID;
 }
 
+jfieldID getTableDescriptorPointerID(void) {
+	return tableDescriptorPointerID;
+}
+
 jmethodID getBigDecimalToStringID(void) {
 	return bigDecimalToStringID;
 }
@@ -930,3 +960,7 @@ jmethodID getTimeToLongID(void) {
 jmethodID getTimestampToLongID(void) {
 	return timestampToLongID;
 }
+
+jmethodID getInputStreamReadID(void) {
+	return inputStreamReadID;
+}
@@ -19,6 +19,7 @@ java_export void releaseIDS(JNIEnv *env);
 
 java_export jmethodID getMonetDBEmbeddedDatabaseConstructorID(void);
 java_export jclass getMonetDBEmbeddedExceptionClassID(void);
+java_export jclass getMonetDBEmbeddedCancelledExceptionClassID(void);
 java_export jclass getMonetDBEmbeddedConnectionClassID(void);
 java_export jmethodID getMonetDBEmbeddedConnectionConstructorID(void);
 java_export jclass getJDBCEmbeddedConnectionClassID(void);
@@ -100,6 +101,7 @@ java_export jfieldID getGetConnectionID(void);
 java_export jfieldID getGetConnectionLongID(void);
 java_export jfieldID getGetSchemaID(void);
 java_export jfieldID getGetTableID(void);
+java_export jfieldID getTableDescriptorPointerID(void);
 java_export jfieldID getStructPointerID(void);
 
 java_export jmethodID getBigDecimalToStringID(void);
@@ -107,5 +109,6 @@ java_export jmethodID getSetBigDecimalScaleID(void);
 java_export jmethodID getDateToLongID(void);
 java_export jmethodID getTimeToLongID(void);
 java_export jmethodID getTimestampToLongID(void);
+java_export jmethodID getInputStreamReadID(void);
 
 #endif //SRC_JAVAIDS_H
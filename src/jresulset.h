@@ -25,9 +25,13 @@ typedef struct {
 	monetdb_result *output;
 	BAT** bats;
 	res_col** cols;
+	int fromScan; /* the output and columns were built natively, by a table scan or a bound plan, not by monetdb_query */
 } JResultSet;
 
 java_export char* createResultSet(monetdb_connection conn, JResultSet** res, monetdb_result* output);
+java_export char* createScanResultSet(monetdb_connection conn, JResultSet** res, const char *tableName,
+									  sql_column **columns, BAT **bats, size_t numberOfColumns, size_t numberOfRows);
+java_export char* createTableResultSet(monetdb_connection conn, JResultSet** res, res_table *table);
 java_export void freeResultSet(JResultSet* thisResultSet);
 
 #endif //MONETDBLITE_JRESULTSET_H
@@ -13,6 +13,7 @@
 #include "gdk.h"
 #include "mal.h"
 #include "res_table.h"
+#include "sql_querytype.h"
 #include "mal_exception.h"
 
 char*
@@ -72,6 +73,91 @@ cleanup:
 	return msg;
 }
 
+/* Wraps the BATs of a table scan as a result set, taking their references */
+char*
+createScanResultSet(monetdb_connection conn, JResultSet** res, const char *tableName, sql_column **columns, BAT **bats,
+					size_t numberOfColumns, size_t numberOfRows)
+{
+	JResultSet *thisResultSet;
+	size_t i;
+
+	if (!(*res = thisResultSet = (JResultSet*) GDKzalloc(sizeof(JResultSet))))
+		goto fail;
+	thisResultSet->conn = conn;
+	thisResultSet->fromScan = 1;
+	if (!(thisResultSet->output = (monetdb_result*) GDKzalloc(sizeof(monetdb_result))) ||
+		!(thisResultSet->bats = (BAT**) GDKzalloc(sizeof(BAT*) * numberOfColumns)) ||
+		!(thisResultSet->cols = (res_col**) GDKzalloc(sizeof(res_col*) * numberOfColumns)))
+		goto fail;
+	thisResultSet->output->nrows = numberOfRows;
+	thisResultSet->output->ncols = numberOfColumns;
+	for (i = 0; i < numberOfColumns; i++) {
+		res_col *col = (res_col*) GDKzalloc(sizeof(res_col));
+		if (!(thisResultSet->cols[i] = col) || !(col->tn = GDKstrdup(tableName)) ||
+			!(col->name = GDKstrdup(columns[i]->base.name)))
+			goto fail;
+		col->type = columns[i]->type;
+		col->b = bats[i]->batCacheid;
+		col->mtype = bats[i]->ttype;
+		thisResultSet->bats[i] = bats[i];
+		bats[i] = NULL;
+	}
+	return MAL_SUCCEED;
+fail:
+	freeResultSet(thisResultSet);
+	*res = NULL;
+	return createException(MAL, "embedded", MAL_MALLOC_FAIL);
+}
+
+/* Wraps the first result table of a natively executed plan as a result set, fixing its BATs. A scalar column is
+ * stored in a new single row BAT */
+char*
+createTableResultSet(monetdb_connection conn, JResultSet** res, res_table *table)
+{
+	JResultSet *thisResultSet;
+	size_t i, numberOfColumns = (size_t) table->nr_cols;
+	char *msg = NULL;
+
+	if (!(*res = thisResultSet = (JResultSet*) GDKzalloc(sizeof(JResultSet))))
+		goto fail;
+	thisResultSet->conn = conn;
+	thisResultSet->fromScan = 1;
+	if (!(thisResultSet->output = (monetdb_result*) GDKzalloc(sizeof(monetdb_result))) ||
+		!(thisResultSet->bats = (BAT**) GDKzalloc(sizeof(BAT*) * (numberOfColumns + 1))) ||
+		!(thisResultSet->cols = (res_col**) GDKzalloc(sizeof(res_col*) * (numberOfColumns + 1))))
+		goto fail;
+	thisResultSet->output->type = Q_TABLE;
+	thisResultSet->output->ncols = numberOfColumns;
+	for (i = 0; i < numberOfColumns; i++) {
+		res_col *from = &table->cols[i], *col = (res_col*) GDKzalloc(sizeof(res_col));
+		BAT *b;
+
+		if (!(thisResultSet->cols[i] = col) || !(col->tn = GDKstrdup(from->tn)) || !(col->name = GDKstrdup(from->name)))
+			goto fail;
+		col->type = from->type;
+		col->mtype = from->mtype;
+		if (from->b) {
+			if (!(b = BATdescriptor(from->b))) {
+				msg = createException(MAL, "embedded", RUNTIME_OBJECT_MISSING);
+				goto fail;
+			}
+		} else if (!(b = COLnew(0, from->mtype, 1, TRANSIENT))) {
+			goto fail;
+		} else if (BUNappend(b, from->p, FALSE) != GDK_SUCCEED) {
+			BBPreclaim(b);
+			goto fail;
+		}
+		thisResultSet->bats[i] = b;
+		col->b = b->batCacheid;
+	}
+	thisResultSet->output->nrows = numberOfColumns > 0 ? BATcount(thisResultSet->bats[0]) : 0;
+	return MAL_SUCCEED;
+fail:
+	freeResultSet(thisResultSet);
+	*res = NULL;
+	return msg ? msg : createException(MAL, "embedded", MAL_MALLOC_FAIL);
+}
+
 void
 freeResultSet(JResultSet* thisResultSet)
 {
@@ -84,16 +170,32 @@ freeResultSet(JResultSet* thisResultSet)
 			if(thisResultSet->output) {
 				numberOfColumns = thisResultSet->output->ncols;
 				for (i = 0; i < numberOfColumns; i++)
-					BBPunfix(dearBats[i]->batCacheid);
+					if(dearBats[i])
+						BBPunfix(dearBats[i]->batCacheid);
 			}
 			GDKfree(dearBats);
 			thisResultSet->bats = NULL;
 		}
 		if(thisResultSet->cols) {
+			if(thisResultSet->fromScan && thisResultSet->output) {
+				for (i = 0; i < thisResultSet->output->ncols; i++) {
+					res_col *col = thisResultSet->cols[i];
+					if(col) {
+						if(col->tn)
+							GDKfree(col->tn);
+						if(col->name)
+							GDKfree(col->name);
+						GDKfree(col);
+					}
+				}
+			}
 			GDKfree(thisResultSet->cols);
 			thisResultSet->cols = NULL;
 		}
-		if(thisResultSet->output) {
+		if(thisResultSet->output && thisResultSet->fromScan) {
+			GDKfree(thisResultSet->output);
+			thisResultSet->output = NULL;
+		} else if(thisResultSet->output) {
 			char* other;
 			if((other = monetdb_cleanup_result(thisResultSet->conn, thisResultSet->output)) != MAL_SUCCEED)
 				freeException(other);
@@ -15,7 +15,23 @@
 #include "jresulset.h"
 #include "res_table.h"
 #include "mal_type.h"
+#include "mal_client.h"
 #include "sql_querytype.h"
+#include "sql_scenario.h"
+#include "sql_result.h"
+#include "sql_decimal.h"
+#include "sql_storage.h"
+#include "sql_mvc.h"
+#include "sql_qc.h"
+#include "sql_atom.h"
+#include "sql_semantic.h"
+#include "sql_gencode.h"
+#include "mal_instruction.h"
+#include "mal_resolve.h"
+#include "blob.h"
+#include "converters.h"
+#include "stream.h"
+#include <math.h>
 
 JNIEXPORT jboolean JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_getAutoCommitInternal
 	(JNIEnv *env, jobject jconnection, jlong connectionPointer) {
@@ -49,33 +65,27 @@ JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnectio
 	}
 }
 
-static int executeQuery(JNIEnv *env, jlong connectionPointer, jstring query, jboolean execute, monetdb_result **output,
-						int *query_type, lng *lastId, lng *rowCount, int *prepareID) {
-	const char *query_string_tmp;
+/* Queries aborted by the client's query timeout, either expired or forced by a cancel, get a distinct exception */
+static jclass getQueryExceptionClassID(const char *err) {
+	if (strstr(err, "HYT00") || strstr(err, "aborted due to timeout"))
+		return getMonetDBEmbeddedCancelledExceptionClassID();
+	return getMonetDBEmbeddedExceptionClassID();
+}
+
+static int executeQueryString(JNIEnv *env, jlong connectionPointer, char *query, monetdb_result **output,
+							  int *query_type, lng *lastId, lng *rowCount, int *prepareID) {
 	char* err = NULL;
 	int foundExc = 0, i = 0;
 
-	(void) execute;
-	if(connectionPointer == 0) {
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "Connection already closed?");
-		return 1;
-	}
-	query_string_tmp = (*env)->GetStringUTFChars(env, query, NULL);
-	if(query_string_tmp == NULL) {
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
-		return 2;
-	}
 	// Execute the query
-	err = monetdb_query((monetdb_connection) connectionPointer, (char*) query_string_tmp, output,
-						rowCount, prepareID);
-	(*env)->ReleaseStringUTFChars(env, query, query_string_tmp);
+	err = monetdb_query((monetdb_connection) connectionPointer, query, output, rowCount, prepareID);
 	if (err) {
 		while(err[i] && !foundExc) {
 			if(err[i] == '!')
 				foundExc = 1;
 			i++;
 		}
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err + (foundExc ? i : 0));
+		(*env)->ThrowNew(env, getQueryExceptionClassID(err), err + (foundExc ? i : 0));
 		freeException(err);
 		return 3;
 	}
@@ -88,29 +98,34 @@ static int executeQuery(JNIEnv *env, jlong connectionPointer, jstring query, jbo
 	return 0;
 }
 
-static jobject generateQueryResultSet(JNIEnv *env, jobject jconnection, jlong connectionPointer, monetdb_result *output,
-									  int query_type, int prepareID) {
-	size_t i, numberOfColumns;
-	jobject result = NULL;
-	jintArray typesIDs;
-	jint* copy = NULL;
-	JResultSet* thisResultSet = NULL;
-	char* err = NULL;
-	monetdb_connection conn = (monetdb_connection) connectionPointer;
+static int executeQuery(JNIEnv *env, jlong connectionPointer, jstring query, jboolean execute, monetdb_result **output,
+						int *query_type, lng *lastId, lng *rowCount, int *prepareID) {
+	const char *query_string_tmp;
+	int res;
 
-	// Check if we had results, otherwise we send an exception
-	if (output && (query_type == Q_TABLE || query_type == Q_PREPARE || query_type == Q_BLOCK) && output->ncols > 0) {
-		numberOfColumns = output->ncols;
-	} else {
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "There query returned no results?");
-		return result;
+	(void) execute;
+	if(connectionPointer == 0) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "Connection already closed?");
+		return 1;
 	}
-
-	if((err = createResultSet(conn, &thisResultSet, output)) != MAL_SUCCEED) {
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
-		freeException(err);
+	query_string_tmp = (*env)->GetStringUTFChars(env, query, NULL);
+	if(query_string_tmp == NULL) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
+		return 2;
 	}
-	copy = GDKmalloc(sizeof(jint) * numberOfColumns);
+	res = executeQueryString(env, connectionPointer, (char*) query_string_tmp, output, query_type, lastId, rowCount,
+							 prepareID);
+	(*env)->ReleaseStringUTFChars(env, query, query_string_tmp);
+	return res;
+}
+
+/* Creates the Java result set of a JResultSet, which is freed if it fails */
+static jobject wrapResultSet(JNIEnv *env, jobject jconnection, JResultSet *thisResultSet, int prepareID) {
+	size_t i, numberOfColumns = thisResultSet->output->ncols;
+	jobject result = NULL;
+	jintArray typesIDs;
+	jint* copy = GDKmalloc(sizeof(jint) * numberOfColumns);
+
 	typesIDs = (*env)->NewIntArray(env, (jsize) numberOfColumns);
 	if(copy == NULL || typesIDs == NULL) {
 		if(copy)
@@ -121,14 +136,7 @@ static jobject generateQueryResultSet(JNIEnv *env, jobject jconnection, jlong co
 	}
 
 	for (i = 0; i < numberOfColumns; i++) {
-		res_col* col = NULL;
-		char* nextSQLName, *err;
-		if((err = monetdb_result_fetch_rawcol(conn, &col, output, i)) != MAL_SUCCEED) {
-			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
-			freeException(err);
-			break;
-		}
-		nextSQLName = col->type.type->sqlname;
+		char* nextSQLName = thisResultSet->cols[i]->type.type->sqlname;
 		if(strncmp(nextSQLName, "boolean", 7) == 0) {
 			copy[i] = 1;
 		} else if(strncmp(nextSQLName, "tinyint", 7) == 0) {
@@ -159,6 +167,7 @@ static jobject generateQueryResultSet(JNIEnv *env, jobject jconnection, jlong co
 			copy[i] = 14;
 		} else {
 			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "Unknown MonetDB type");
+			break;
 		}
 	}
 
@@ -169,19 +178,39 @@ static jobject generateQueryResultSet(JNIEnv *env, jobject jconnection, jlong co
 		if (prepareID) {
 			//public PreparedQueryResultSet(MonetDBEmbeddedConnection connection, long structPointer, int numberOfColumns, int numberOfRows, int[] typesIDs, int preparedID)
 			result = (*env)->NewObject(env, getPreparedQueryResultSetClassID(), getPreparedQueryResultSetClassConstructorID(), jconnection,
-									   (jlong) thisResultSet, numberOfColumns, (jint) output->nrows, typesIDs, prepareID);
+									   (jlong) thisResultSet, numberOfColumns, (jint) thisResultSet->output->nrows, typesIDs, prepareID);
 		} else {
 			//QueryResultSet(MonetDBEmbeddedConnection connection, long structPointer, int numberOfColumns, int numberOfRows, int[] typesIDs)
 			result = (*env)->NewObject(env, getQueryResultSetID(), getQueryResultSetConstructorID(), jconnection,
-									   (jlong) thisResultSet, numberOfColumns, (jint) output->nrows, typesIDs);
+									   (jlong) thisResultSet, numberOfColumns, (jint) thisResultSet->output->nrows, typesIDs);
 		}
-		if (result == NULL)
+		if (result == NULL) {
+			freeResultSet(thisResultSet);
 			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
+		}
 	}
 	GDKfree(copy);
 	return result;
 }
 
+static jobject generateQueryResultSet(JNIEnv *env, jobject jconnection, jlong connectionPointer, monetdb_result *output,
+									  int query_type, int prepareID) {
+	JResultSet* thisResultSet = NULL;
+	char* err = NULL;
+
+	// Check if we had results, otherwise we send an exception
+	if (!output || (query_type != Q_TABLE && query_type != Q_PREPARE && query_type != Q_BLOCK) || output->ncols == 0) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "There query returned no results?");
+		return NULL;
+	}
+	if((err = createResultSet((monetdb_connection) connectionPointer, &thisResultSet, output)) != MAL_SUCCEED) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+		return NULL;
+	}
+	return wrapResultSet(env, jconnection, thisResultSet, prepareID);
+}
+
 JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_sendUpdateInternal
 	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring query, jboolean execute) {
 	monetdb_result *output = NULL;
@@ -223,6 +252,175 @@ JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnec
 	}
 }
 
+/* Runs a query and fetches the first column of its result, for the scalar queries */
+static int executeScalarQuery(JNIEnv *env, jlong connectionPointer, jstring query, monetdb_result **output,
+							  res_col **col, BAT **b) {
+	int query_type = Q_TABLE;
+	char *err;
+
+	if (executeQuery(env, connectionPointer, query, JNI_TRUE, output, &query_type, NULL, NULL, NULL))
+		return 1;
+	if (!*output || (query_type != Q_TABLE && query_type != Q_BLOCK) || (*output)->ncols == 0) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "The query did not produce a result set");
+	} else if ((*output)->nrows == 0) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "The query returned no rows");
+	} else if ((err = monetdb_result_fetch_rawcol((monetdb_connection) connectionPointer, col, *output, 0)) != MAL_SUCCEED) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+	} else if (!(*b = BATdescriptor((*col)->b))) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "Could not find the result BAT");
+	} else {
+		return 0;
+	}
+	if (*output && (err = monetdb_cleanup_result((monetdb_connection) connectionPointer, *output)) != MAL_SUCCEED)
+		freeException(err);
+	*output = NULL;
+	return 1;
+}
+
+static void releaseScalarQuery(jlong connectionPointer, monetdb_result *output, BAT *b) {
+	char *err;
+	BBPunfix(b->batCacheid);
+	if ((err = monetdb_cleanup_result((monetdb_connection) connectionPointer, output)) != MAL_SUCCEED)
+		freeException(err);
+}
+
+/* Reads the first value of a numeric column, applying the decimal scale, and tells if it is null */
+static int getScalarNumber(JNIEnv *env, res_col *col, BAT *b, lng *lvalue, dbl *dvalue, int *isNull) {
+	const void *p = Tloc(b, 0);
+	int isDecimal = col->type.type->eclass == EC_DEC;
+	lng divisor = 1;
+	unsigned int i;
+
+	*isNull = 0;
+	switch (ATOMbasetype(b->ttype)) {
+		case TYPE_bte:
+			*isNull = is_bte_nil(*(const bte*) p); /* also covers booleans */
+			*lvalue = *(const bte*) p;
+			*dvalue = (dbl) *lvalue;
+			break;
+		case TYPE_sht:
+			*isNull = is_sht_nil(*(const sht*) p);
+			*lvalue = *(const sht*) p;
+			*dvalue = (dbl) *lvalue;
+			break;
+		case TYPE_int:
+			*isNull = is_int_nil(*(const int*) p);
+			*lvalue = *(const int*) p;
+			*dvalue = (dbl) *lvalue;
+			break;
+		case TYPE_lng:
+			*isNull = is_lng_nil(*(const lng*) p);
+			*lvalue = *(const lng*) p;
+			*dvalue = (dbl) *lvalue;
+			break;
+		case TYPE_oid:
+			*isNull = is_oid_nil(*(const oid*) p);
+			*lvalue = (lng) *(const oid*) p;
+			*dvalue = (dbl) *lvalue;
+			break;
+		case TYPE_flt:
+			*isNull = is_flt_nil(*(const flt*) p);
+			*dvalue = *(const flt*) p;
+			*lvalue = (lng) *dvalue;
+			return 0;
+		case TYPE_dbl:
+			*isNull = is_dbl_nil(*(const dbl*) p);
+			*dvalue = *(const dbl*) p;
+			*lvalue = (lng) *dvalue;
+			return 0;
+		default:
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "The query result is not numeric");
+			return 1;
+	}
+	if (isDecimal && !*isNull) {
+		for (i = 0; i < col->type.scale; i++)
+			divisor *= 10;
+		*dvalue = (dbl) *lvalue / (dbl) divisor;
+		*lvalue /= divisor;
+	}
+	return 0;
+}
+
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_queryForLongInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring query) {
+	monetdb_result *output = NULL;
+	res_col *col = NULL;
+	BAT *b = NULL;
+	lng lvalue = lng_nil;
+	dbl dvalue;
+	int isNull;
+
+	(void) jconnection;
+	if (executeScalarQuery(env, connectionPointer, query, &output, &col, &b))
+		return lvalue;
+	if (!getScalarNumber(env, col, b, &lvalue, &dvalue, &isNull) && isNull)
+		lvalue = lng_nil;
+	releaseScalarQuery(connectionPointer, output, b);
+	return (jlong) lvalue;
+}
+
+JNIEXPORT jdouble JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_queryForDoubleInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring query) {
+	monetdb_result *output = NULL;
+	res_col *col = NULL;
+	BAT *b = NULL;
+	lng lvalue;
+	dbl dvalue = dbl_nil;
+	int isNull;
+
+	(void) jconnection;
+	if (executeScalarQuery(env, connectionPointer, query, &output, &col, &b))
+		return dvalue;
+	if (!getScalarNumber(env, col, b, &lvalue, &dvalue, &isNull) && isNull)
+		dvalue = dbl_nil;
+	releaseScalarQuery(connectionPointer, output, b);
+	return (jdouble) dvalue;
+}
+
+JNIEXPORT jstring JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_queryForStringInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring query) {
+	monetdb_result *output = NULL;
+	res_col *col = NULL;
+	BAT *b = NULL;
+	BATiter bi;
+	const void *p;
+	char *value = NULL;
+	jstring result = NULL;
+
+	(void) jconnection;
+	if (executeScalarQuery(env, connectionPointer, query, &output, &col, &b))
+		return NULL;
+	bi = bat_iterator(b);
+	p = BUNtail(bi, 0);
+	if (ATOMcmp(b->ttype, p, ATOMnilptr(b->ttype)) != 0) {
+		if (b->ttype == TYPE_str) {
+			result = (*env)->NewStringUTF(env, (const char*) p);
+		} else {
+			if (col->type.type->eclass == EC_DEC) {
+				lng lvalue = 0;
+				switch (ATOMbasetype(b->ttype)) {
+					case TYPE_bte: lvalue = *(const bte*) p; break;
+					case TYPE_sht: lvalue = *(const sht*) p; break;
+					case TYPE_int: lvalue = *(const int*) p; break;
+					default: lvalue = *(const lng*) p; break;
+				}
+				value = decimal_to_str(lvalue, &col->type);
+			} else {
+				value = ATOMformat(b->ttype, p);
+			}
+			if (value) {
+				result = (*env)->NewStringUTF(env, value);
+				GDKfree(value);
+			}
+		}
+		if (!result)
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
+	}
+	releaseScalarQuery(connectionPointer, output, b);
+	return result;
+}
+
 JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_prepareStatementInternal
 	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring query, jboolean execute) {
 	int query_type = Q_PREPARE, res, prepareID;
@@ -242,20 +440,23 @@ JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnec
 	}
 }
 
-JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executePrepareStatementInternal
-	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring query, jboolean execute) {
-	int query_type = Q_PREPARE, res;
-	lng rowCount;
-	monetdb_result *output = NULL;
-	jobject resultSet = NULL, result;
+static jobject newExecResultSet(JNIEnv *env, jboolean retStatus, jobject resultSet, jint returnValue) {
+	//public ExecResultSet(boolean status, QueryResultSet resultSet, int numberOfRows)
+	jobject result = (*env)->NewObject(env, getExecResultSetClassID(), getExecResultSetClassConstructorID(), retStatus,
+									   resultSet, returnValue);
+	if (result == NULL)
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
+	return result;
+}
+
+static jobject generateExecResultSet(JNIEnv *env, jobject jconnection, jlong connectionPointer, monetdb_result *output,
+									 int query_type, lng rowCount) {
+	jobject resultSet = NULL;
 	jint returnValue = -1;
 	jboolean retStatus = JNI_FALSE;
 	char* other;
 
-	res = executeQuery(env, connectionPointer, query, execute, &output, &query_type, NULL, &rowCount, NULL);
-	if (res) {
-		return NULL;
-	} else if(query_type == Q_TABLE || query_type == Q_BLOCK || query_type == Q_PREPARE) {
+	if(query_type == Q_TABLE || query_type == Q_BLOCK || query_type == Q_PREPARE) {
 		retStatus = JNI_TRUE;
 		resultSet = generateQueryResultSet(env, jconnection, connectionPointer, output, query_type, 0);
 	} else {
@@ -267,11 +468,18 @@ JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnec
 		if (output && (other = monetdb_cleanup_result((monetdb_connection) connectionPointer, output)) != MAL_SUCCEED)
 			freeException(other);
 	}
-	//public ExecResultSet(boolean status, QueryResultSet resultSet, int numberOfRows)
-	result = (*env)->NewObject(env, getExecResultSetClassID(), getExecResultSetClassConstructorID(), retStatus, resultSet, returnValue);
-	if (result == NULL)
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
-	return result;
+	return newExecResultSet(env, retStatus, resultSet, returnValue);
+}
+
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executePrepareStatementInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring query, jboolean execute) {
+	int query_type = Q_PREPARE;
+	lng rowCount;
+	monetdb_result *output = NULL;
+
+	if (executeQuery(env, connectionPointer, query, execute, &output, &query_type, NULL, &rowCount, NULL))
+		return NULL;
+	return generateExecResultSet(env, jconnection, connectionPointer, output, query_type, rowCount);
 }
 
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executePrepareStatementAndIgnoreInternal
@@ -285,6 +493,694 @@ JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnectio
 		freeException(other);
 }
 
+/* The kinds of the prepared statement parameters, the same as in MonetDBEmbeddedPreparedStatement */
+#define PARAM_UNSET      0
+#define PARAM_NULL       1
+#define PARAM_BOOLEAN    2
+#define PARAM_LONG       3
+#define PARAM_REAL       4
+#define PARAM_DOUBLE     5
+#define PARAM_STRING     6
+#define PARAM_BLOB       7
+#define PARAM_DECIMAL    8
+#define PARAM_DATE       9
+#define PARAM_TIME       10
+#define PARAM_TIMESTAMP  11
+
+static void throwQueryException(JNIEnv *env, char *err) {
+	int i = 0, foundExc = 0;
+
+	while(err[i] && !foundExc) {
+		if(err[i] == '!')
+			foundExc = 1;
+		i++;
+	}
+	(*env)->ThrowNew(env, getQueryExceptionClassID(err), err + (foundExc ? i : 0));
+	freeException(err);
+}
+
+/* Creates a non-null atom of the parameter type, copying a fixed size value or pointing to a sql allocated one */
+static atom* createNativeAtom(mvc *m, sql_subtype *pt, void *value) {
+	atom *a = atom_general(m->sa, pt, NULL);
+
+	if (a) {
+		if (VALset(&a->data, pt->type->localtype, value) == NULL)
+			return NULL;
+		a->isnull = 0;
+	}
+	return a;
+}
+
+/* Dates, times and timestamps bind to a parameter of their own type, or to the part of it the parameter holds */
+static char* createTemporalAtom(mvc *m, sql_subtype *pt, int index, jbyte kind, lng value, atom **a) {
+	int localtype = pt->type->localtype;
+	date d;
+	daytime t;
+	timestamp ts;
+
+	if (kind == PARAM_DATE) {
+		if (is_date_nil(d = epochDaysToDate(value)))
+			goto range;
+		if (localtype == TYPE_date) {
+			*a = createNativeAtom(m, pt, &d);
+			return MAL_SUCCEED;
+		} else if (localtype == TYPE_timestamp) {
+			ts = timestamp_create(d, 0);
+			*a = createNativeAtom(m, pt, &ts);
+			return MAL_SUCCEED;
+		}
+	} else if (kind == PARAM_TIME) {
+		if (value < 0 || value >= EPOCH_DAY_USEC)
+			goto range;
+		if (localtype == TYPE_daytime) {
+			t = (daytime) value;
+			*a = createNativeAtom(m, pt, &t);
+			return MAL_SUCCEED;
+		}
+	} else {
+		if (is_timestamp_nil(ts = epochMicrosToTimestamp(value)))
+			goto range;
+		if (localtype == TYPE_timestamp) {
+			*a = createNativeAtom(m, pt, &ts);
+			return MAL_SUCCEED;
+		} else if (localtype == TYPE_date) {
+			d = timestamp_date(ts);
+			*a = createNativeAtom(m, pt, &d);
+			return MAL_SUCCEED;
+		} else if (localtype == TYPE_daytime) {
+			t = timestamp_daytime(ts);
+			*a = createNativeAtom(m, pt, &t);
+			return MAL_SUCCEED;
+		}
+	}
+	return createException(SQL, "embedded.execute", "Cannot bind a temporal value to parameter %d of type %s", index + 1,
+						   pt->type->sqlname);
+range:
+	return createException(SQL, "embedded.execute", "The temporal value of parameter %d is out of range", index + 1);
+}
+
+/* Binds a typed parameter slot as the next argument of a cached plan, backend_call casts it to the parameter type */
+static char* bindParameter(JNIEnv *env, mvc *m, sql_subtype *pt, int index, jbyte kind, jlong lvalue, jdouble dvalue,
+						   jobject ovalue) {
+	int localtype = pt->type->localtype;
+	sql_subtype tpe;
+	atom *a = NULL;
+	char *err = MAL_SUCCEED;
+
+	switch (kind) {
+		case PARAM_NULL:
+			a = atom_general(m->sa, pt, NULL);
+			break;
+		case PARAM_BOOLEAN:
+			a = atom_bool(m->sa, lvalue ? 1 : 0);
+			break;
+		case PARAM_LONG:
+			sql_find_subtype(&tpe, "bigint", 64, 0);
+			a = atom_int(m->sa, &tpe, (lng) lvalue);
+			break;
+		case PARAM_REAL:
+		case PARAM_DOUBLE:
+			if (isnan(dvalue)) /* NaN is the nil of the floating-point types, so it would silently become a null */
+				return createException(SQL, "embedded.execute", "Parameter %d is NaN, which MonetDB does not store", index + 1);
+			if (kind == PARAM_REAL)
+				sql_find_subtype(&tpe, "real", 24, 0);
+			else
+				sql_find_subtype(&tpe, "double", 53, 0);
+			a = atom_float(m->sa, &tpe, (double) dvalue);
+			break;
+		case PARAM_STRING: {
+			const char *str = (*env)->GetStringUTFChars(env, (jstring) ovalue, NULL);
+			char *copy;
+
+			if (!str)
+				return createException(MAL, "embedded.execute", MAL_MALLOC_FAIL);
+			if (localtype == TYPE_str) {
+				/* a clob, so the cast to the parameter checks the length of a char or varchar */
+				sql_find_subtype(&tpe, "clob", 0, 0);
+				if ((copy = sa_strdup(m->sa, str)) != NULL)
+					a = atom_string(m->sa, &tpe, copy);
+			} else if (!(a = atom_general(m->sa, pt, str))) {
+				err = createException(SQL, "embedded.execute", "Cannot convert the string of parameter %d to %s",
+									  index + 1, pt->type->sqlname);
+			}
+			(*env)->ReleaseStringUTFChars(env, (jstring) ovalue, str);
+		} break;
+		case PARAM_BLOB: {
+			jsize len = (*env)->GetArrayLength(env, (jbyteArray) ovalue);
+			blob *value;
+
+			if (localtype != ATOMindex("blob"))
+				return createException(SQL, "embedded.execute", "Cannot bind a blob to parameter %d of type %s",
+									   index + 1, pt->type->sqlname);
+			if ((value = sa_alloc(m->sa, blobsize((size_t) len))) != NULL) {
+				value->nitems = (size_t) len;
+				(*env)->GetByteArrayRegion(env, (jbyteArray) ovalue, 0, len, (jbyte*) value->data);
+				a = createNativeAtom(m, pt, value);
+			}
+		} break;
+		case PARAM_DECIMAL: {
+			/* the unscaled value, already at the scale of the parameter */
+			lng limit = 1;
+			unsigned int i;
+
+			if (pt->type->eclass != EC_DEC)
+				return createException(SQL, "embedded.execute", "Cannot bind a decimal to parameter %d of type %s",
+									   index + 1, pt->type->sqlname);
+			for (i = 0; i < pt->digits && i < 18; i++)
+				limit *= 10;
+			if (pt->digits <= 18 && (lvalue >= limit || lvalue <= -limit))
+				return createException(SQL, "embedded.execute", "The value of parameter %d does not fit in decimal(%u,%u)",
+									   index + 1, pt->digits, pt->scale);
+			a = atom_int(m->sa, pt, (lng) lvalue);
+		} break;
+		case PARAM_DATE:
+		case PARAM_TIME:
+		case PARAM_TIMESTAMP:
+			err = createTemporalAtom(m, pt, index, kind, (lng) lvalue, &a);
+			break;
+		case PARAM_UNSET:
+			return createException(SQL, "embedded.execute", "Parameter %d is not set", index + 1);
+		default:
+			return createException(MAL, "embedded.execute", "Unknown parameter kind %d", (int) kind);
+	}
+	if (err)
+		return err;
+	if (!a)
+		return createException(MAL, "embedded.execute", MAL_MALLOC_FAIL);
+	sql_add_arg(m, a);
+	return MAL_SUCCEED;
+}
+
+/* Starts the client's transaction and finds a cached plan, the same lookup an EXEC statement does */
+static char* findPrepared(Client c, jint prepareID, int nparams, mvc **m, backend **be, cq **q) {
+	char *err;
+
+	if ((err = getSQLContext(c, NULL, m, be)) != MAL_SUCCEED)
+		return err;
+	if ((err = SQLtrans(*m)) != MAL_SUCCEED)
+		return err;
+	if (!(*m)->sa && !((*m)->sa = sa_create()))
+		return createException(MAL, "embedded.execute", MAL_MALLOC_FAIL);
+	if (!(*q = qc_find((*m)->qc, (int) prepareID)))
+		return createException(SQL, "embedded.execute", "No prepared statement with id: %d", (int) prepareID);
+	if ((*q)->paramlen != nparams)
+		return createException(SQL, "embedded.execute", "Wrong number of arguments for prepared statement %d: expected %d, got %d",
+							   (int) prepareID, (*q)->paramlen, nparams);
+	return MAL_SUCCEED;
+}
+
+/* Generates the call of a cached plan with the bound arguments, which SQLengine then runs without any parsing */
+static char* callPrepared(Client c, mvc *m, backend *be, cq *q) {
+	MalBlkPtr mb = c->curprg->def;
+	char *err = MAL_SUCCEED;
+
+	m->emode = m_execute;
+	m->type = q->type;
+	m->rowcnt = -1;
+	be->q = q;
+	if (backend_call(be, c, q) < 0 || *m->errstr) {
+		err = createException(SQL, "embedded.execute", "%s", *m->errstr ? m->errstr : MAL_MALLOC_FAIL);
+		*m->errstr = 0;
+	} else {
+		q->count++;
+		pushEndInstruction(mb);
+		chkTypes(c->usermodule, mb, TRUE);
+		if (mb->errors)
+			err = createException(SQL, "embedded.execute", "%s", mb->errors);
+	}
+	if (err) {
+		MSresetInstructions(mb, 1);
+		sqlcleanup(m, 0);
+		be->q = NULL;
+		m->emode = m_normal;
+	}
+	return err;
+}
+
+/* Runs the generated call, the failure of a started statement aborts the transaction as in any other query */
+static char* runPrepared(Client c, mvc *m, backend *be) {
+	char *err = SQLengine(c);
+
+	if (err)
+		m->session->status = -1;
+	be->q = NULL;
+	m->emode = m_normal;
+	return err;
+}
+
+static void releasePreparedResults(mvc *m) {
+	if (m->results) {
+		res_tables_destroy(m->results);
+		m->results = NULL;
+	}
+}
+
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executePreparedInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jint prepareID, jbyteArray kinds, jlongArray longValues,
+	 jdoubleArray doubleValues, jobjectArray objectValues, jboolean ignoreResult) {
+	Client c = (Client) connectionPointer;
+	jsize nparams = (*env)->GetArrayLength(env, kinds), i;
+	jbyte *jkinds = NULL;
+	jlong *jlongs = NULL;
+	jdouble *jdoubles = NULL;
+	JResultSet *thisResultSet = NULL;
+	jobject resultSet = NULL;
+	jint returnValue = -1;
+	mvc *m = NULL;
+	backend *be = NULL;
+	cq *q = NULL;
+	char *err = NULL, *other;
+
+	if(connectionPointer == 0) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "Connection already closed?");
+		return NULL;
+	}
+	if (!(jkinds = (*env)->GetByteArrayElements(env, kinds, NULL)) ||
+		!(jlongs = (*env)->GetLongArrayElements(env, longValues, NULL)) ||
+		!(jdoubles = (*env)->GetDoubleArrayElements(env, doubleValues, NULL))) {
+		err = createException(MAL, "embedded.execute", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	if ((err = findPrepared(c, prepareID, (int) nparams, &m, &be, &q)) != MAL_SUCCEED)
+		goto cleanup;
+	for (i = 0; i < nparams && !err; i++) {
+		jobject next = (*env)->GetObjectArrayElement(env, objectValues, i);
+		err = bindParameter(env, m, q->params + i, (int) i, jkinds[i], jlongs[i], jdoubles[i], next);
+		if (next)
+			(*env)->DeleteLocalRef(env, next);
+	}
+	if (err) {
+		sql_destroy_args(m);
+		goto cleanup;
+	}
+	if ((err = callPrepared(c, m, be, q)) != MAL_SUCCEED || (err = runPrepared(c, m, be)) != MAL_SUCCEED)
+		goto cleanup;
+	if (m->results && !ignoreResult) {
+		err = createTableResultSet((monetdb_connection) c, &thisResultSet, m->results);
+	} else if (q->type == Q_UPDATE) {
+		returnValue = (jint) m->rowcnt;
+	} else if (q->type == Q_SCHEMA) {
+		returnValue = -2;
+	}
+
+cleanup:
+	if (m) {
+		releasePreparedResults(m);
+		if ((other = SQLautocommit(m)) != MAL_SUCCEED) {
+			if (err)
+				freeException(other);
+			else
+				err = other;
+		}
+	}
+	if (jkinds)
+		(*env)->ReleaseByteArrayElements(env, kinds, jkinds, JNI_ABORT);
+	if (jlongs)
+		(*env)->ReleaseLongArrayElements(env, longValues, jlongs, JNI_ABORT);
+	if (jdoubles)
+		(*env)->ReleaseDoubleArrayElements(env, doubleValues, jdoubles, JNI_ABORT);
+	if (err) {
+		if (thisResultSet)
+			freeResultSet(thisResultSet);
+		throwQueryException(env, err);
+		return NULL;
+	} else if (ignoreResult) {
+		return NULL;
+	} else if (thisResultSet && !(resultSet = wrapResultSet(env, jconnection, thisResultSet, 0))) {
+		return NULL;
+	}
+	return newExecResultSet(env, resultSet ? JNI_TRUE : JNI_FALSE, resultSet, returnValue);
+}
+
+/* The Java array types of the batch parameter columns, the same as in MonetDBEmbeddedPreparedStatement */
+#define BATCH_BOOLEAN  0
+#define BATCH_BYTE     1
+#define BATCH_SHORT    2
+#define BATCH_INT      3
+#define BATCH_LONG     4
+#define BATCH_FLOAT    5
+#define BATCH_DOUBLE   6
+#define BATCH_STRING   7
+#define BATCH_BLOB     8
+#define BATCH_TYPED    9
+
+/* A column of typed parameter slots, the kinds, long, double and object values arrays of the Java side */
+typedef struct {
+	jbyteArray kinds;
+	jlongArray longValues;
+	jdoubleArray doubleValues;
+	jobjectArray objectValues;
+	jbyte *jkinds;
+	jlong *jlongs;
+	jdouble *jdoubles;
+} TypedColumn;
+
+static char* executeStatement(monetdb_connection conn, char *query) {
+	monetdb_result *output = NULL;
+	char *err = monetdb_query(conn, query, &output, NULL, NULL), *other;
+	if (output && (other = monetdb_cleanup_result(conn, output)) != MAL_SUCCEED)
+		freeException(other);
+	return err;
+}
+
+/* Gets the parameter kind and value of a batch column at a row */
+static jbyte getBatchParameter(JNIEnv *env, jbyte type, void *elements, jobject column, jsize row, jlong *lvalue,
+							   jdouble *dvalue, jobject *ovalue) {
+	switch (type) {
+		case BATCH_BOOLEAN:
+			*lvalue = ((jboolean*) elements)[row] == JNI_TRUE;
+			return PARAM_BOOLEAN;
+		case BATCH_BYTE:
+			*lvalue = ((jbyte*) elements)[row];
+			return is_bte_nil((bte) *lvalue) ? PARAM_NULL : PARAM_LONG;
+		case BATCH_SHORT:
+			*lvalue = ((jshort*) elements)[row];
+			return is_sht_nil((sht) *lvalue) ? PARAM_NULL : PARAM_LONG;
+		case BATCH_INT:
+			*lvalue = ((jint*) elements)[row];
+			return is_int_nil((int) *lvalue) ? PARAM_NULL : PARAM_LONG;
+		case BATCH_LONG:
+			*lvalue = ((jlong*) elements)[row];
+			return is_lng_nil((lng) *lvalue) ? PARAM_NULL : PARAM_LONG;
+		case BATCH_FLOAT:
+			*dvalue = ((jfloat*) elements)[row];
+			return is_flt_nil((flt) *dvalue) ? PARAM_NULL : PARAM_REAL;
+		case BATCH_DOUBLE:
+			*dvalue = ((jdouble*) elements)[row];
+			return is_dbl_nil((dbl) *dvalue) ? PARAM_NULL : PARAM_DOUBLE;
+		case BATCH_TYPED: {
+			TypedColumn *typed = (TypedColumn*) elements;
+			jbyte kind = typed->jkinds[row];
+
+			*lvalue = typed->jlongs[row];
+			*dvalue = typed->jdoubles[row];
+			if (kind == PARAM_STRING || kind == PARAM_BLOB)
+				*ovalue = (*env)->GetObjectArrayElement(env, typed->objectValues, row);
+			return kind;
+		}
+		default:
+			*ovalue = (*env)->GetObjectArrayElement(env, (jobjectArray) column, row);
+			if (!*ovalue)
+				return PARAM_NULL;
+			return type == BATCH_STRING ? PARAM_STRING : PARAM_BLOB;
+	}
+}
+
+static void releaseTypedColumn(JNIEnv *env, TypedColumn *typed) {
+	if (typed->jkinds)
+		(*env)->ReleaseByteArrayElements(env, typed->kinds, typed->jkinds, JNI_ABORT);
+	if (typed->jlongs)
+		(*env)->ReleaseLongArrayElements(env, typed->longValues, typed->jlongs, JNI_ABORT);
+	if (typed->jdoubles)
+		(*env)->ReleaseDoubleArrayElements(env, typed->doubleValues, typed->jdoubles, JNI_ABORT);
+	if (typed->kinds)
+		(*env)->DeleteLocalRef(env, typed->kinds);
+	if (typed->longValues)
+		(*env)->DeleteLocalRef(env, typed->longValues);
+	if (typed->doubleValues)
+		(*env)->DeleteLocalRef(env, typed->doubleValues);
+	if (typed->objectValues)
+		(*env)->DeleteLocalRef(env, typed->objectValues);
+	GDKfree(typed);
+}
+
+/* Pins the typed slots of an Object[] {kinds, longValues, doubleValues, objectValues} column */
+static TypedColumn* getTypedColumn(JNIEnv *env, jobjectArray column) {
+	TypedColumn *typed = GDKzalloc(sizeof(TypedColumn));
+
+	if (!typed)
+		return NULL;
+	typed->kinds = (jbyteArray) (*env)->GetObjectArrayElement(env, column, 0);
+	typed->longValues = (jlongArray) (*env)->GetObjectArrayElement(env, column, 1);
+	typed->doubleValues = (jdoubleArray) (*env)->GetObjectArrayElement(env, column, 2);
+	typed->objectValues = (jobjectArray) (*env)->GetObjectArrayElement(env, column, 3);
+	if (!typed->kinds || !typed->longValues || !typed->doubleValues || !typed->objectValues ||
+		!(typed->jkinds = (*env)->GetByteArrayElements(env, typed->kinds, NULL)) ||
+		!(typed->jlongs = (*env)->GetLongArrayElements(env, typed->longValues, NULL)) ||
+		!(typed->jdoubles = (*env)->GetDoubleArrayElements(env, typed->doubleValues, NULL))) {
+		releaseTypedColumn(env, typed);
+		return NULL;
+	}
+	return typed;
+}
+
+static void* getBatchElements(JNIEnv *env, jbyte type, jobject column) {
+	switch (type) {
+		case BATCH_BOOLEAN:
+			return (*env)->GetBooleanArrayElements(env, (jbooleanArray) column, NULL);
+		case BATCH_BYTE:
+			return (*env)->GetByteArrayElements(env, (jbyteArray) column, NULL);
+		case BATCH_SHORT:
+			return (*env)->GetShortArrayElements(env, (jshortArray) column, NULL);
+		case BATCH_INT:
+			return (*env)->GetIntArrayElements(env, (jintArray) column, NULL);
+		case BATCH_LONG:
+			return (*env)->GetLongArrayElements(env, (jlongArray) column, NULL);
+		case BATCH_FLOAT:
+			return (*env)->GetFloatArrayElements(env, (jfloatArray) column, NULL);
+		case BATCH_DOUBLE:
+			return (*env)->GetDoubleArrayElements(env, (jdoubleArray) column, NULL);
+		case BATCH_TYPED:
+			return getTypedColumn(env, (jobjectArray) column);
+		default:
+			return column; /* object arrays are read element by element */
+	}
+}
+
+static void releaseBatchElements(JNIEnv *env, jbyte type, jobject column, void *elements) {
+	switch (type) {
+		case BATCH_BOOLEAN:
+			(*env)->ReleaseBooleanArrayElements(env, (jbooleanArray) column, elements, JNI_ABORT);
+			break;
+		case BATCH_BYTE:
+			(*env)->ReleaseByteArrayElements(env, (jbyteArray) column, elements, JNI_ABORT);
+			break;
+		case BATCH_SHORT:
+			(*env)->ReleaseShortArrayElements(env, (jshortArray) column, elements, JNI_ABORT);
+			break;
+		case BATCH_INT:
+			(*env)->ReleaseIntArrayElements(env, (jintArray) column, elements, JNI_ABORT);
+			break;
+		case BATCH_LONG:
+			(*env)->ReleaseLongArrayElements(env, (jlongArray) column, elements, JNI_ABORT);
+			break;
+		case BATCH_FLOAT:
+			(*env)->ReleaseFloatArrayElements(env, (jfloatArray) column, elements, JNI_ABORT);
+			break;
+		case BATCH_DOUBLE:
+			(*env)->ReleaseDoubleArrayElements(env, (jdoubleArray) column, elements, JNI_ABORT);
+			break;
+		case BATCH_TYPED:
+			releaseTypedColumn(env, (TypedColumn*) elements);
+			break;
+		default:
+			break;
+	}
+}
+
+JNIEXPORT jintArray JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executeBatchInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jint prepareID, jobjectArray columns,
+	 jbyteArray columnTypes, jint rows) {
+	Client c = (Client) connectionPointer;
+	jsize ncols = (*env)->GetArrayLength(env, columns), i, row = 0, failedRow = 0;
+	jbyte *jtypes = NULL;
+	jobject *jcolumns = NULL;
+	void **elements = NULL;
+	jint *counts = NULL;
+	jintArray result = NULL;
+	mvc *m = NULL;
+	backend *be = NULL;
+	cq *q = NULL;
+	char *err = NULL, *other;
+	int autoCommit = 0;
+
+	(void) jconnection;
+	if(connectionPointer == 0) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "Connection already closed?");
+		return NULL;
+	}
+	if (!(jtypes = (*env)->GetByteArrayElements(env, columnTypes, NULL)) ||
+		!(jcolumns = GDKzalloc(sizeof(jobject) * (ncols + 1))) || !(elements = GDKzalloc(sizeof(void*) * (ncols + 1))) ||
+		!(counts = GDKmalloc(sizeof(jint) * (rows + 1)))) {
+		err = createException(MAL, "embedded.executeBatch", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	for (i = 0; i < ncols; i++) {
+		jcolumns[i] = (*env)->GetObjectArrayElement(env, columns, i);
+		if (!(elements[i] = getBatchElements(env, jtypes[i], jcolumns[i]))) {
+			err = createException(MAL, "embedded.executeBatch", MAL_MALLOC_FAIL);
+			goto cleanup;
+		}
+	}
+	if ((err = findPrepared(c, prepareID, (int) ncols, &m, &be, &q)) != MAL_SUCCEED)
+		goto cleanup;
+
+	/* all the rows run in a single transaction, or in the client's one, which a failing row aborts */
+	autoCommit = m->session->auto_commit;
+	m->session->auto_commit = 0;
+	for (row = 0; row < rows && !err; row++) {
+		for (i = 0; i < ncols && !err; i++) {
+			jlong lvalue = 0;
+			jdouble dvalue = 0;
+			jobject ovalue = NULL;
+			jbyte kind = getBatchParameter(env, jtypes[i], elements[i], jcolumns[i], row, &lvalue, &dvalue, &ovalue);
+
+			err = bindParameter(env, m, q->params + i, (int) i, kind, lvalue, dvalue, ovalue);
+			if (ovalue)
+				(*env)->DeleteLocalRef(env, ovalue);
+		}
+		if (err) {
+			sql_destroy_args(m);
+		} else if ((err = callPrepared(c, m, be, q)) == MAL_SUCCEED && (err = runPrepared(c, m, be)) == MAL_SUCCEED) {
+			counts[row] = q->type == Q_UPDATE ? (jint) m->rowcnt : (q->type == Q_SCHEMA ? -2 : -1);
+		}
+		releasePreparedResults(m);
+	}
+	if (err) {
+		failedRow = row; /* one-based, as the loop incremented it */
+		m->session->status = -1;
+	}
+	m->session->auto_commit = autoCommit;
+	if (!err) {
+		if (!(result = (*env)->NewIntArray(env, rows))) {
+			err = createException(MAL, "embedded.executeBatch", MAL_MALLOC_FAIL);
+		} else {
+			(*env)->SetIntArrayRegion(env, result, 0, rows, counts);
+		}
+	}
+
+cleanup:
+	if (m && (other = SQLautocommit(m)) != MAL_SUCCEED) {
+		if (err)
+			freeException(other);
+		else
+			err = other;
+	}
+	if (elements) {
+		for (i = 0; i < ncols; i++) {
+			if (elements[i])
+				releaseBatchElements(env, jtypes[i], jcolumns[i], elements[i]);
+			if (jcolumns[i])
+				(*env)->DeleteLocalRef(env, jcolumns[i]);
+		}
+		GDKfree(elements);
+	}
+	if (jcolumns)
+		GDKfree(jcolumns);
+	if (jtypes)
+		(*env)->ReleaseByteArrayElements(env, columnTypes, jtypes, JNI_ABORT);
+	if (counts)
+		GDKfree(counts);
+	if (err) {
+		char *msg;
+		int foundExc = 0, j = 0;
+
+		while(err[j] && !foundExc) {
+			if(err[j] == '!')
+				foundExc = 1;
+			j++;
+		}
+		if (failedRow > 0 && (msg = GDKmalloc(strlen(err) + 64)) != NULL) {
+			sprintf(msg, "Batch row %d: %s", (int) failedRow, err + (foundExc ? j : 0));
+			(*env)->ThrowNew(env, getQueryExceptionClassID(err), msg);
+			GDKfree(msg);
+			freeException(err);
+		} else {
+			throwQueryException(env, err);
+		}
+		return NULL;
+	}
+	return result;
+}
+
+JNIEXPORT jintArray JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executeScriptInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jobjectArray statements, jboolean transactional) {
+	monetdb_connection conn = (monetdb_connection) connectionPointer;
+	jsize nstatements = (*env)->GetArrayLength(env, statements), i = 0, failedStatement = 0;
+	jint *counts = NULL;
+	jintArray result = NULL;
+	char *err = NULL, *other;
+	int foundExc = 0, j = 0, autoCommit = 0, inTransaction = 0;
+
+	(void) jconnection;
+	if(connectionPointer == 0) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "Connection already closed?");
+		return NULL;
+	}
+	if (!(counts = GDKmalloc(sizeof(jint) * (nstatements + 1)))) {
+		err = createException(MAL, "embedded.executeScript", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	if (transactional) {
+		if ((err = monetdb_get_autocommit(conn, &autoCommit)) != MAL_SUCCEED)
+			goto cleanup;
+		if (autoCommit) {
+			if ((err = executeStatement(conn, "START TRANSACTION;")) != MAL_SUCCEED)
+				goto cleanup;
+			inTransaction = 1;
+		}
+	}
+	for (i = 0; i < nstatements && !err; i++) {
+		monetdb_result *output = NULL;
+		lng rowCount = -1;
+		jstring next = (jstring) (*env)->GetObjectArrayElement(env, statements, i);
+		const char *query = next ? (*env)->GetStringUTFChars(env, next, NULL) : NULL;
+
+		if (!query) {
+			err = createException(MAL, "embedded.executeScript", MAL_MALLOC_FAIL);
+		} else {
+			if ((err = monetdb_query(conn, (char*) query, &output, &rowCount, NULL)) == MAL_SUCCEED) {
+				counts[i] = (output && output->type == Q_UPDATE) ? (jint) rowCount :
+							((output && output->type == Q_SCHEMA) ? -2 : -1);
+			}
+			(*env)->ReleaseStringUTFChars(env, next, query);
+		}
+		if (next)
+			(*env)->DeleteLocalRef(env, next);
+		if (output && (other = monetdb_cleanup_result(conn, output)) != MAL_SUCCEED)
+			freeException(other);
+	}
+	if (err)
+		failedStatement = i; /* one-based, as the loop incremented it */
+	if (inTransaction) {
+		if (err) {
+			if ((other = executeStatement(conn, "ROLLBACK;")) != MAL_SUCCEED)
+				freeException(other);
+		} else {
+			err = executeStatement(conn, "COMMIT;");
+		}
+	}
+	if (!err) {
+		if (!(result = (*env)->NewIntArray(env, nstatements))) {
+			err = createException(MAL, "embedded.executeScript", MAL_MALLOC_FAIL);
+		} else {
+			(*env)->SetIntArrayRegion(env, result, 0, nstatements, counts);
+		}
+	}
+
+cleanup:
+	if (counts)
+		GDKfree(counts);
+	if (err) {
+		char *msg = err;
+		while(err[j] && !foundExc) {
+			if(err[j] == '!')
+				foundExc = 1;
+			j++;
+		}
+		if (failedStatement > 0 && (msg = GDKmalloc(strlen(err) + 64)) != NULL) {
+			sprintf(msg, "Statement %d: %s", (int) failedStatement, err + (foundExc ? j : 0));
+			(*env)->ThrowNew(env, getQueryExceptionClassID(err), msg);
+			GDKfree(msg);
+		} else {
+			(*env)->ThrowNew(env, getQueryExceptionClassID(err), err + (foundExc ? j : 0));
+		}
+		freeException(err);
+		return NULL;
+	}
+	return result;
+}
+
 JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_getMonetDBTableInternal
 	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring tableSchema, jstring tableName) {
 	const char *schema_name_tmp, *table_name_tmp;
@@ -316,6 +1212,473 @@ JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnec
 	return result;
 }
 
+/* A MonetDB stream reading from a java.io.InputStream through a Java byte array */
+typedef struct {
+	JNIEnv *env;
+	jobject input;
+	jbyteArray buffer;
+	jsize bufferSize;
+} JInputStream;
+
+static ssize_t readJInputStream(void *restrict priv, void *restrict buf, size_t elmsize, size_t cnt) {
+	JInputStream *in = (JInputStream *) priv;
+	JNIEnv *env = in->env;
+	size_t total = elmsize * cnt, done = 0;
+	jint next;
+
+	while (done < total) {
+		jsize toRead = (jsize) (total - done < (size_t) in->bufferSize ? total - done : (size_t) in->bufferSize);
+		next = (*env)->CallIntMethod(env, in->input, getInputStreamReadID(), in->buffer, 0, toRead);
+		if ((*env)->ExceptionCheck(env) == JNI_TRUE)
+			return -1;
+		if (next < 0) //end of the stream
+			break;
+		(*env)->GetByteArrayRegion(env, in->buffer, 0, next, (jbyte*) buf + done);
+		done += (size_t) next;
+		if (next < toRead) //don't block on a partial read
+			break;
+	}
+	return (ssize_t) (done / elmsize);
+}
+
+static void closeJInputStream(void *priv) {
+	(void) priv; //the Java side owns the InputStream
+}
+
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_copyIntoInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring tableSchema, jstring tableName, jobject input,
+	 jbyteArray buffer, jstring columnSeparator, jstring recordSeparator, jstring quote, jstring nullString,
+	 jlong records, jlong offset, jboolean locked, jboolean bestEffort) {
+	monetdb_connection conn = (monetdb_connection) connectionPointer;
+	const char *schema_name_tmp = NULL, *table_name_tmp = NULL, *sep = NULL, *rsep = NULL, *ssep = NULL, *ns = NULL;
+	char *err = NULL, *other;
+	int foundExc = 0, i = 0, ncols = 0;
+	sql_table *table;
+	mvc *m = NULL;
+	stream *s = NULL;
+	bstream *bs = NULL;
+	BAT **bats = NULL;
+	bat *ids = NULL;
+	jlong rows = 0;
+	JInputStream in = {env, input, buffer, (*env)->GetArrayLength(env, buffer)};
+	node *n;
+
+	(void) jconnection;
+	if (!(schema_name_tmp = (*env)->GetStringUTFChars(env, tableSchema, NULL)) ||
+		!(table_name_tmp = (*env)->GetStringUTFChars(env, tableName, NULL)) ||
+		!(sep = (*env)->GetStringUTFChars(env, columnSeparator, NULL)) ||
+		!(rsep = (*env)->GetStringUTFChars(env, recordSeparator, NULL)) ||
+		!(ssep = (*env)->GetStringUTFChars(env, quote, NULL)) ||
+		!(ns = (*env)->GetStringUTFChars(env, nullString, NULL))) {
+		err = createException(MAL, "embedded.copyInto", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	if ((err = monetdb_get_table(conn, &table, schema_name_tmp, table_name_tmp)) != MAL_SUCCEED)
+		goto cleanup;
+	if ((err = getSQLContext((Client) conn, NULL, &m, NULL)) != MAL_SUCCEED)
+		goto cleanup;
+	if ((err = SQLtrans(m)) != MAL_SUCCEED)
+		goto cleanup;
+	if (!(s = callback_stream(&in, readJInputStream, closeJInputStream, NULL, "java.io.InputStream")) ||
+		!(bs = bstream_create(s, 128 * 8192))) {
+		if (s)
+			close_stream(s);
+		err = createException(MAL, "embedded.copyInto", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	ncols = table->columns.set->cnt;
+	err = mvc_import_table((Client) conn, &bats, m, bs, table, sep, rsep, ssep, ns, records, offset,
+						   locked == JNI_TRUE, bestEffort == JNI_TRUE, false);
+	bstream_destroy(bs);
+	if (err || (*env)->ExceptionCheck(env) == JNI_TRUE) //if the InputStream failed, its exception is thrown
+		goto cleanup;
+	if (!bats) {
+		err = createException(SQL, "embedded.copyInto", "Failed to import table '%s', %s", table->base.name, m->errstr);
+		goto cleanup;
+	}
+	if (!(ids = GDKzalloc(ncols * sizeof(bat)))) {
+		err = createException(MAL, "embedded.copyInto", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	for (n = table->columns.set->h; n; n = n->next) {
+		sql_column *col = n->data;
+		ids[col->colnr] = bats[col->colnr]->batCacheid;
+	}
+	rows = (jlong) BATcount(bats[0]);
+	err = monetdb_append(conn, table->s->base.name, table->base.name, ids, ncols);
+
+cleanup:
+	if (bats) {
+		for (int j = 0; j < ncols; j++) {
+			if (bats[j])
+				BBPunfix(bats[j]->batCacheid);
+		}
+		GDKfree(bats);
+	}
+	if (ids)
+		GDKfree(ids);
+	if ((err || (*env)->ExceptionCheck(env) == JNI_TRUE) && m && (other = SQLautocommit(m)) != MAL_SUCCEED)
+		freeException(other); //end the failed transaction in auto-commit mode
+	if (schema_name_tmp)
+		(*env)->ReleaseStringUTFChars(env, tableSchema, schema_name_tmp);
+	if (table_name_tmp)
+		(*env)->ReleaseStringUTFChars(env, tableName, table_name_tmp);
+	if (sep)
+		(*env)->ReleaseStringUTFChars(env, columnSeparator, sep);
+	if (rsep)
+		(*env)->ReleaseStringUTFChars(env, recordSeparator, rsep);
+	if (ssep)
+		(*env)->ReleaseStringUTFChars(env, quote, ssep);
+	if (ns)
+		(*env)->ReleaseStringUTFChars(env, nullString, ns);
+	if (err) {
+		if ((*env)->ExceptionCheck(env) == JNI_FALSE) {
+			while(err[i] && !foundExc) {
+				if(err[i] == '!')
+					foundExc = 1;
+				i++;
+			}
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err + (foundExc ? i : 0));
+		}
+		freeException(err);
+		return -1;
+	}
+	return rows;
+}
+
+/* Creates a BAT from a column image in the COPY BINARY format */
+static char* binaryColumnToBAT(BAT **b, sql_column *col, const char *data, size_t length, int swap, BUN *count) {
+	int localtype = col->type.type->localtype;
+	size_t width = (size_t) ATOMsize(localtype), i;
+	BAT *aux;
+
+	if (ATOMstorage(localtype) == TYPE_str) { /* UTF-8 strings, each one terminated by a newline */
+		const char *next = data, *end = data + length, *nl;
+		size_t bufsize = 1024, len;
+		char *buf = GDKmalloc(bufsize);
+
+		if (!buf || !(aux = COLnew(0, localtype, 0, TRANSIENT))) {
+			GDKfree(buf);
+			return createException(MAL, "embedded.copyBinaryInto", MAL_MALLOC_FAIL);
+		}
+		while (next < end) {
+			if (!(nl = memchr(next, '\n', end - next)))
+				nl = end; /* the last newline is optional */
+			len = (size_t) (nl - next);
+			if (len >= bufsize) {
+				GDKfree(buf);
+				bufsize = len + 1;
+				if (!(buf = GDKmalloc(bufsize))) {
+					BBPreclaim(aux);
+					return createException(MAL, "embedded.copyBinaryInto", MAL_MALLOC_FAIL);
+				}
+			}
+			memcpy(buf, next, len);
+			buf[len] = '\0';
+			if (BUNappend(aux, buf, false) != GDK_SUCCEED) {
+				GDKfree(buf);
+				BBPreclaim(aux);
+				return createException(MAL, "embedded.copyBinaryInto", MAL_MALLOC_FAIL);
+			}
+			next = nl + 1;
+		}
+		GDKfree(buf);
+	} else if (ATOMvarsized(localtype)) {
+		return createException(MAL, "embedded.copyBinaryInto", "The column %s of type %s is not supported in binary imports",
+							   col->base.name, col->type.type->sqlname);
+	} else {
+		if (length % width != 0)
+			return createException(MAL, "embedded.copyBinaryInto", "The column image size of %s is not a multiple of %zu bytes",
+								   col->base.name, width);
+		if (!(aux = COLnew(0, localtype, (BUN) (length / width), TRANSIENT)))
+			return createException(MAL, "embedded.copyBinaryInto", MAL_MALLOC_FAIL);
+		memcpy(Tloc(aux, 0), data, length);
+		if (swap && width > 1) {
+			char *p = (char *) Tloc(aux, 0), t;
+			for (i = 0; i < length; i += width) {
+				for (size_t j = 0; j < width / 2; j++) {
+					t = p[i + j];
+					p[i + j] = p[i + width - 1 - j];
+					p[i + width - 1 - j] = t;
+				}
+			}
+		}
+		BATsetcount(aux, (BUN) (length / width));
+		aux->tnil = 0;
+		aux->tnonil = 0;
+		aux->tkey = 0;
+		aux->tsorted = 0;
+		aux->trevsorted = 0;
+		BATsettrivprop(aux);
+	}
+	*count = BATcount(aux);
+	*b = aux;
+	return MAL_SUCCEED;
+}
+
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_copyBinaryIntoInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring tableSchema, jstring tableName,
+	 jobjectArray columns, jintArray offsets, jintArray lengths, jbooleanArray swaps) {
+	monetdb_connection conn = (monetdb_connection) connectionPointer;
+	const char *schema_name_tmp = NULL, *table_name_tmp = NULL;
+	char *err = NULL;
+	int foundExc = 0, i = 0, ncols = 0;
+	sql_table *table;
+	BAT **bats = NULL;
+	bat *ids = NULL;
+	BUN count, rows = 0;
+	jint *joffsets = NULL, *jlengths = NULL;
+	jboolean *jswaps = NULL;
+	node *n;
+
+	(void) jconnection;
+	if (!(schema_name_tmp = (*env)->GetStringUTFChars(env, tableSchema, NULL)) ||
+		!(table_name_tmp = (*env)->GetStringUTFChars(env, tableName, NULL)) ||
+		!(joffsets = (*env)->GetIntArrayElements(env, offsets, NULL)) ||
+		!(jlengths = (*env)->GetIntArrayElements(env, lengths, NULL)) ||
+		!(jswaps = (*env)->GetBooleanArrayElements(env, swaps, NULL))) {
+		err = createException(MAL, "embedded.copyBinaryInto", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	if ((err = monetdb_get_table(conn, &table, schema_name_tmp, table_name_tmp)) != MAL_SUCCEED)
+		goto cleanup;
+	ncols = table->columns.set->cnt;
+	if ((*env)->GetArrayLength(env, columns) != ncols) {
+		err = createException(MAL, "embedded.copyBinaryInto", "The number of columns between the input and the table is not consistent");
+		goto cleanup;
+	}
+	if (!(bats = GDKzalloc(ncols * sizeof(BAT*))) || !(ids = GDKzalloc(ncols * sizeof(bat)))) {
+		err = createException(MAL, "embedded.copyBinaryInto", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+
+	for (n = table->columns.set->h; n && !err; n = n->next) {
+		sql_column *col = n->data;
+		int colnr = col->colnr;
+		jobject next = (*env)->GetObjectArrayElement(env, columns, colnr);
+		int isArray = (*env)->IsInstanceOf(env, next, getByteArrayClassID()) == JNI_TRUE;
+		char *data = isArray ? (*env)->GetPrimitiveArrayCritical(env, (jbyteArray) next, NULL) :
+							   (*env)->GetDirectBufferAddress(env, next);
+
+		if (!data) {
+			err = createException(MAL, "embedded.copyBinaryInto", "The column %d must be a direct ByteBuffer or have a backing array", colnr + 1);
+		} else {
+			err = binaryColumnToBAT(&bats[colnr], col, data + joffsets[colnr], (size_t) jlengths[colnr],
+									jswaps[colnr] == JNI_TRUE, &count);
+			if (isArray)
+				(*env)->ReleasePrimitiveArrayCritical(env, (jbyteArray) next, data, JNI_ABORT);
+		}
+		(*env)->DeleteLocalRef(env, next);
+		if (!err) {
+			if (n != table->columns.set->h && count != rows)
+				err = createException(MAL, "embedded.copyBinaryInto", "The row sizes between columns are not consistent");
+			rows = count;
+			ids[colnr] = bats[colnr]->batCacheid;
+		}
+	}
+	if (!err)
+		err = monetdb_append(conn, table->s->base.name, table->base.name, ids, ncols);
+
+cleanup:
+	if (bats) {
+		for (int j = 0; j < ncols; j++) {
+			if (bats[j])
+				BBPunfix(bats[j]->batCacheid);
+		}
+		GDKfree(bats);
+	}
+	if (ids)
+		GDKfree(ids);
+	if (schema_name_tmp)
+		(*env)->ReleaseStringUTFChars(env, tableSchema, schema_name_tmp);
+	if (table_name_tmp)
+		(*env)->ReleaseStringUTFChars(env, tableName, table_name_tmp);
+	if (joffsets)
+		(*env)->ReleaseIntArrayElements(env, offsets, joffsets, JNI_ABORT);
+	if (jlengths)
+		(*env)->ReleaseIntArrayElements(env, lengths, jlengths, JNI_ABORT);
+	if (jswaps)
+		(*env)->ReleaseBooleanArrayElements(env, swaps, jswaps, JNI_ABORT);
+	if (err) {
+		while(err[i] && !foundExc) {
+			if(err[i] == '!')
+				foundExc = 1;
+			i++;
+		}
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err + (foundExc ? i : 0));
+		freeException(err);
+		return -1;
+	}
+	return (jlong) rows;
+}
+
+/* Wraps a direct buffer into a BAT whose heap is not owned by GDK, or copies a primitive array into a new BAT */
+static char* viewColumnToBAT(JNIEnv *env, BAT **b, sql_column *col, jobject column, jint offset, BUN count) {
+	int localtype = col->type.type->localtype;
+	size_t width = (size_t) ATOMsize(localtype);
+	char *data = (*env)->GetDirectBufferAddress(env, column);
+	BAT *aux;
+
+	if (data) {
+		if (!(aux = COLnew(0, localtype, 0, TRANSIENT)))
+			return createException(MAL, "embedded.loadView", MAL_MALLOC_FAIL);
+		/* the buffer's memory is scanned in place, the connection keeps it reachable until the table is dropped */
+		HEAPfree(&aux->theap, 0);
+		aux->theap.base = data + (size_t) offset * width;
+		aux->theap.size = count * width;
+		aux->theap.free = count * width;
+		aux->theap.storage = STORE_NOWN;
+		aux->theap.newstorage = STORE_NOWN;
+		aux->batCapacity = count;
+	} else {
+		if (!(aux = COLnew(0, localtype, count, TRANSIENT)))
+			return createException(MAL, "embedded.loadView", MAL_MALLOC_FAIL);
+		if (!(data = (*env)->GetPrimitiveArrayCritical(env, (jarray) column, NULL))) {
+			BBPreclaim(aux);
+			return createException(MAL, "embedded.loadView", MAL_MALLOC_FAIL);
+		}
+		memcpy(Tloc(aux, 0), data + (size_t) offset * width, count * width);
+		(*env)->ReleasePrimitiveArrayCritical(env, (jarray) column, data, JNI_ABORT);
+	}
+	BATsetcount(aux, count);
+	aux->tnil = 0;
+	aux->tnonil = 0;
+	aux->tkey = 0;
+	aux->tsorted = 0;
+	aux->trevsorted = 0;
+	BATsettrivprop(aux);
+	*b = aux;
+	return MAL_SUCCEED;
+}
+
+/* Sets the access of the temporary table of a view, removing all its rows first if requested, as TRUNCATE does.
+ * A view is kept read-only, as its columns may alias Java memory which DML would write into */
+static char* setViewAccess(monetdb_connection conn, const char *name, sht access, int clear) {
+	mvc *m = NULL;
+	sql_schema *s;
+	sql_table *t;
+	char *err, *other;
+
+	if ((err = getSQLContext((Client) conn, NULL, &m, NULL)) != MAL_SUCCEED || (err = SQLtrans(m)) != MAL_SUCCEED)
+		return err;
+	if (!(s = mvc_bind_schema(m, "tmp")) || !(t = mvc_bind_table(m, s, name))) {
+		err = createException(MAL, "embedded.loadView", "The view %s does not exist", name);
+	} else {
+		if (t->access != access)
+			t = mvc_access(m, t, access);
+		if (clear)
+			store_funcs.clear_table(m->session->tr, t);
+	}
+	if ((other = SQLautocommit(m)) != MAL_SUCCEED) {
+		if (err)
+			freeException(other);
+		else
+			err = other;
+	}
+	return err;
+}
+
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_loadViewInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jstring viewName, jobjectArray columns,
+	 jintArray offsets, jint numberOfRows, jboolean replace) {
+	monetdb_connection conn = (monetdb_connection) connectionPointer;
+	const char *view_name_tmp = NULL;
+	char *err = NULL;
+	int foundExc = 0, i = 0, ncols = 0, loaded = 0;
+	sql_table *table;
+	BAT **bats = NULL;
+	bat *ids = NULL;
+	jint *joffsets = NULL;
+	node *n;
+
+	(void) jconnection;
+	if (!(view_name_tmp = (*env)->GetStringUTFChars(env, viewName, NULL)) ||
+		!(joffsets = (*env)->GetIntArrayElements(env, offsets, NULL))) {
+		err = createException(MAL, "embedded.loadView", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	if ((err = setViewAccess(conn, view_name_tmp, TABLE_WRITABLE, replace)) != MAL_SUCCEED)
+		goto cleanup;
+	loaded = 1;
+	if ((err = monetdb_get_table(conn, &table, "tmp", view_name_tmp)) != MAL_SUCCEED)
+		goto cleanup;
+	ncols = table->columns.set->cnt;
+	if ((*env)->GetArrayLength(env, columns) != ncols) {
+		err = createException(MAL, "embedded.loadView", "The number of columns between the input and the view is not consistent");
+		goto cleanup;
+	}
+	if (!(bats = GDKzalloc(ncols * sizeof(BAT*))) || !(ids = GDKzalloc(ncols * sizeof(bat)))) {
+		err = createException(MAL, "embedded.loadView", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+
+	for (n = table->columns.set->h; n && !err; n = n->next) {
+		sql_column *col = n->data;
+		int colnr = col->colnr;
+		jobject next = (*env)->GetObjectArrayElement(env, columns, colnr);
+
+		if (ATOMvarsized(col->type.type->localtype)) {
+			err = createException(MAL, "embedded.loadView", "The column %s of type %s is not supported in views",
+								  col->base.name, col->type.type->sqlname);
+		} else if ((err = viewColumnToBAT(env, &bats[colnr], col, next, joffsets[colnr], (BUN) numberOfRows)) == MAL_SUCCEED) {
+			ids[colnr] = bats[colnr]->batCacheid;
+		}
+		(*env)->DeleteLocalRef(env, next);
+	}
+	/* the appended BATs of an empty temporary table are taken over by its storage instead of being copied */
+	if (!err)
+		err = monetdb_append(conn, "tmp", view_name_tmp, ids, ncols);
+
+cleanup:
+	if (loaded) {
+		char *other = setViewAccess(conn, view_name_tmp, TABLE_READONLY, 0);
+		if (other && err)
+			freeException(other);
+		else if (other)
+			err = other;
+	}
+	if (bats) {
+		for (int j = 0; j < ncols; j++) {
+			if (bats[j])
+				BBPunfix(bats[j]->batCacheid);
+		}
+		GDKfree(bats);
+	}
+	if (ids)
+		GDKfree(ids);
+	if (view_name_tmp)
+		(*env)->ReleaseStringUTFChars(env, viewName, view_name_tmp);
+	if (joffsets)
+		(*env)->ReleaseIntArrayElements(env, offsets, joffsets, JNI_ABORT);
+	if (err) {
+		while(err[i] && !foundExc) {
+			if(err[i] == '!')
+				foundExc = 1;
+			i++;
+		}
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err + (foundExc ? i : 0));
+		freeException(err);
+	}
+}
+
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_setQueryTimeoutInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer, jlong microseconds) {
+	(void) env;
+	(void) jconnection;
+	if (connectionPointer)
+		((Client) connectionPointer)->qtimeout = (lng) microseconds;
+}
+
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_cancelInternal
+	(JNIEnv *env, jobject jconnection, jlong connectionPointer) {
+	(void) env;
+	(void) jconnection;
+	/* the MAL interpreter checks the timeout between instructions, so a running query aborts at the next one,
+	 * releasing its intermediates */
+	if (connectionPointer)
+		((Client) connectionPointer)->qtimeout = 1;
+}
+
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_closeConnectionInternal
 	(JNIEnv *env, jobject jconnection, jlong connectionPointer) {
 	char *err = NULL;
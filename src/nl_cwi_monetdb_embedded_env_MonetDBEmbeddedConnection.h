@@ -39,6 +39,30 @@ JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnectio
 JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_sendQueryInternal
   (JNIEnv *, jobject, jlong, jstring, jboolean);
 
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    queryForLongInternal
+ * Signature: (JLjava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_queryForLongInternal
+  (JNIEnv *, jobject, jlong, jstring);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    queryForDoubleInternal
+ * Signature: (JLjava/lang/String;)D
+ */
+JNIEXPORT jdouble JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_queryForDoubleInternal
+  (JNIEnv *, jobject, jlong, jstring);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    queryForStringInternal
+ * Signature: (JLjava/lang/String;)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_queryForStringInternal
+  (JNIEnv *, jobject, jlong, jstring);
+
 /*
  * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
  * Method:    prepareStatementInternal
@@ -63,6 +87,30 @@ JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnec
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executePrepareStatementAndIgnoreInternal
   (JNIEnv *, jobject, jlong, jstring, jboolean);
 
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    executePreparedInternal
+ * Signature: (JI[B[J[D[Ljava/lang/Object;Z)Lnl/cwi/monetdb/embedded/resultset/ExecResultSet;
+ */
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executePreparedInternal
+  (JNIEnv *, jobject, jlong, jint, jbyteArray, jlongArray, jdoubleArray, jobjectArray, jboolean);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    executeBatchInternal
+ * Signature: (JI[Ljava/lang/Object;[BI)[I
+ */
+JNIEXPORT jintArray JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executeBatchInternal
+  (JNIEnv *, jobject, jlong, jint, jobjectArray, jbyteArray, jint);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    executeScriptInternal
+ * Signature: (J[Ljava/lang/String;Z)[I
+ */
+JNIEXPORT jintArray JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_executeScriptInternal
+  (JNIEnv *, jobject, jlong, jobjectArray, jboolean);
+
 /*
  * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
  * Method:    getMonetDBTableInternal
@@ -71,6 +119,46 @@ JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnectio
 JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_getMonetDBTableInternal
   (JNIEnv *, jobject, jlong, jstring, jstring);
 
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    copyIntoInternal
+ * Signature: (JLjava/lang/String;Ljava/lang/String;Ljava/io/InputStream;[BLjava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;JJZZ)J
+ */
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_copyIntoInternal
+  (JNIEnv *, jobject, jlong, jstring, jstring, jobject, jbyteArray, jstring, jstring, jstring, jstring, jlong, jlong, jboolean, jboolean);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    copyBinaryIntoInternal
+ * Signature: (JLjava/lang/String;Ljava/lang/String;[Ljava/lang/Object;[I[I[Z)J
+ */
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_copyBinaryIntoInternal
+  (JNIEnv *, jobject, jlong, jstring, jstring, jobjectArray, jintArray, jintArray, jbooleanArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    loadViewInternal
+ * Signature: (JLjava/lang/String;[Ljava/lang/Object;[IIZ)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_loadViewInternal
+  (JNIEnv *, jobject, jlong, jstring, jobjectArray, jintArray, jint, jboolean);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    setQueryTimeoutInternal
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_setQueryTimeoutInternal
+  (JNIEnv *, jobject, jlong, jlong);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
+ * Method:    cancelInternal
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection_cancelInternal
+  (JNIEnv *, jobject, jlong);
+
 /*
  * Class:     nl_cwi_monetdb_embedded_env_MonetDBEmbeddedConnection
  * Method:    closeConnectionInternal
@@ -433,6 +433,60 @@ JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_resultset_QueryResultSet_map
 	}
 }
 
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_resultset_QueryResultSet_materializeAsInternal
+	(JNIEnv *env, jobject queryResultSet, jlong structPointer, jstring schemaName, jstring tableName) {
+	JResultSet* thisResultSet = (JResultSet*) structPointer;
+	size_t i, numberOfColumns = thisResultSet->output->ncols;
+	const char *schema_name_tmp = NULL, *table_name_tmp = NULL;
+	char *err = NULL;
+	int foundExc = 0, j = 0;
+	BAT **views = NULL;
+	bat *ids = NULL;
+	(void) queryResultSet;
+
+	if (!(schema_name_tmp = (*env)->GetStringUTFChars(env, schemaName, NULL)) ||
+		!(table_name_tmp = (*env)->GetStringUTFChars(env, tableName, NULL)) ||
+		!(views = GDKzalloc(numberOfColumns * sizeof(BAT*))) || !(ids = GDKzalloc(numberOfColumns * sizeof(bat)))) {
+		err = createException(MAL, "embedded.materializeAs", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	/* The result's BATs are appended through views on them, so the storage copies them in bulk on the append
+	 * instead of taking them over, as it does with transient BATs on empty tables. The result set keeps reading its
+	 * own BATs while the table gets updated */
+	for (i = 0; i < numberOfColumns; i++) {
+		if (!(views[i] = VIEWcreate(0, thisResultSet->bats[i]))) {
+			err = createException(MAL, "embedded.materializeAs", MAL_MALLOC_FAIL);
+			goto cleanup;
+		}
+		ids[i] = views[i]->batCacheid;
+	}
+	err = monetdb_append(thisResultSet->conn, schema_name_tmp, table_name_tmp, ids, numberOfColumns);
+
+cleanup:
+	if (views) {
+		for (i = 0; i < numberOfColumns; i++) {
+			if (views[i])
+				BBPunfix(views[i]->batCacheid);
+		}
+		GDKfree(views);
+	}
+	if (ids)
+		GDKfree(ids);
+	if (schema_name_tmp)
+		(*env)->ReleaseStringUTFChars(env, schemaName, schema_name_tmp);
+	if (table_name_tmp)
+		(*env)->ReleaseStringUTFChars(env, tableName, table_name_tmp);
+	if (err) {
+		while(err[j] && !foundExc) {
+			if(err[j] == '!')
+				foundExc = 1;
+			j++;
+		}
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err + (foundExc ? j : 0));
+		freeException(err);
+	}
+}
+
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_resultset_QueryResultSet_freeResultSet
 	(JNIEnv *env, jobject queryResultSet, jlong structPointer) {
 	JResultSet* thisResultSet = (JResultSet*) structPointer;
@@ -279,6 +279,14 @@ JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_resultset_QueryResultSet_get
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_resultset_QueryResultSet_mapColumnToObjectByIndexInternal
   (JNIEnv *, jobject, jlong, jint, jint, jobjectArray);
 
+/*
+ * Class:     nl_cwi_monetdb_embedded_resultset_QueryResultSet
+ * Method:    materializeAsInternal
+ * Signature: (JLjava/lang/String;Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_resultset_QueryResultSet_materializeAsInternal
+  (JNIEnv *, jobject, jlong, jstring, jstring);
+
 /*
  * Class:     nl_cwi_monetdb_embedded_resultset_QueryResultSet
  * Method:    freeResultSet
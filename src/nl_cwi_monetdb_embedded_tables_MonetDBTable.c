@@ -12,8 +12,14 @@
 #include "monetdb_embedded.h"
 #include "mal_exception.h"
 #include "res_table.h"
+#include "mal_client.h"
+#include "sql_scenario.h"
+#include "sql_storage.h"
+#include "gdk_logger.h"
+#include "sql_decimal.h"
 #include "converters.h"
 #include "javaids.h"
+#include "jresulset.h"
 
 static char* loadTable(JNIEnv *env, jobject monetDBTable, sql_table** table, int *ncols, jlong* connectionPointer) {
 	char* err = NULL;
@@ -36,166 +42,268 @@ static char* loadTable(JNIEnv *env, jobject monetDBTable, sql_table** table, int
 	return err;
 }
 
-#define LOADTABLEDATA \
-	sql_table* tableData; \
-	int ncols; \
+/* The resolved catalog information of a table, cached on the Java object while the catalog stays the same */
+typedef struct {
+	int schemaNumber; /* the catalog version it was resolved at, or -1 if it must not be reused */
+	char *schema;
+	char *name;
+	int ncols;
+	char **columnNames;
+	char **sqlnames;
+	char **defaults;
+	int *localtypes;
+	jint *digits;
+	jint *scales;
+	jint *javaIndexes;
+	jboolean *nulls;
+} JTableDescriptor;
+
+/* The MonetDB SQL types in the order of the MonetDBToJavaMapping enum values */
+static const char *javaMappingNames[] = {"boolean", "char", "varchar", "clob", "tinyint", "smallint", "int", "bigint",
+	"decimal", "real", "double", "month_interval", "sec_interval", "time", "timetz", "date", "timestamp", "timestamptz",
+	"blob", "oid", NULL};
+
+static jint getJavaMappingIndex(const char *sqlname) {
+	jint i;
+	for (i = 0; javaMappingNames[i]; i++) {
+		if (strcmp(javaMappingNames[i], sqlname) == 0)
+			return i;
+	}
+	return -1;
+}
+
+static void freeTableDescriptor(JTableDescriptor *desc) {
+	int i;
+
+	if (!desc)
+		return;
+	for (i = 0; i < desc->ncols; i++) {
+		if (desc->columnNames && desc->columnNames[i])
+			GDKfree(desc->columnNames[i]);
+		if (desc->sqlnames && desc->sqlnames[i])
+			GDKfree(desc->sqlnames[i]);
+		if (desc->defaults && desc->defaults[i])
+			GDKfree(desc->defaults[i]);
+	}
+	if (desc->schema)
+		GDKfree(desc->schema);
+	if (desc->name)
+		GDKfree(desc->name);
+	if (desc->columnNames)
+		GDKfree(desc->columnNames);
+	if (desc->sqlnames)
+		GDKfree(desc->sqlnames);
+	if (desc->defaults)
+		GDKfree(desc->defaults);
+	if (desc->localtypes)
+		GDKfree(desc->localtypes);
+	if (desc->digits)
+		GDKfree(desc->digits);
+	if (desc->scales)
+		GDKfree(desc->scales);
+	if (desc->javaIndexes)
+		GDKfree(desc->javaIndexes);
+	if (desc->nulls)
+		GDKfree(desc->nulls);
+	GDKfree(desc);
+}
+
+static JTableDescriptor* createTableDescriptor(sql_table *table, int ncols, int schemaNumber) {
+	JTableDescriptor *desc;
+	node *n;
+
+	if (!(desc = GDKzalloc(sizeof(JTableDescriptor))))
+		return NULL;
+	desc->schemaNumber = schemaNumber;
+	desc->ncols = ncols;
+	if (!(desc->schema = GDKstrdup(table->s->base.name)) || !(desc->name = GDKstrdup(table->base.name)) ||
+		!(desc->columnNames = GDKzalloc(ncols * sizeof(char*))) || !(desc->sqlnames = GDKzalloc(ncols * sizeof(char*))) ||
+		!(desc->defaults = GDKzalloc(ncols * sizeof(char*))) || !(desc->localtypes = GDKmalloc(ncols * sizeof(int))) ||
+		!(desc->digits = GDKmalloc(ncols * sizeof(jint))) || !(desc->scales = GDKmalloc(ncols * sizeof(jint))) ||
+		!(desc->javaIndexes = GDKmalloc(ncols * sizeof(jint))) || !(desc->nulls = GDKmalloc(ncols * sizeof(jboolean)))) {
+		freeTableDescriptor(desc);
+		return NULL;
+	}
+	for (n = table->columns.set->h; n; n = n->next) {
+		sql_column *col = n->data;
+		int i = col->colnr;
+		if (!(desc->columnNames[i] = GDKstrdup(col->base.name)) ||
+			!(desc->sqlnames[i] = GDKstrdup(col->type.type->sqlname)) ||
+			(col->def && !(desc->defaults[i] = GDKstrdup(col->def)))) {
+			freeTableDescriptor(desc);
+			return NULL;
+		}
+		desc->localtypes[i] = col->type.type->localtype;
+		desc->digits[i] = (jint) col->type.digits;
+		desc->scales[i] = (jint) col->type.scale;
+		desc->javaIndexes[i] = getJavaMappingIndex(col->type.type->sqlname);
+		desc->nulls[i] = (jboolean) col->null;
+	}
+	return desc;
+}
+
+/* Gets the descriptor cached on the table object, resolving it again only when a schema change was committed since,
+ * or when the current transaction has schema changes of its own, which are invisible to the catalog version */
+static char* getTableDescriptor(JNIEnv *env, jobject monetDBTable, JTableDescriptor **res, jlong *connectionPointer) {
+	JTableDescriptor *cached = (JTableDescriptor*) (*env)->GetLongField(env, monetDBTable, getTableDescriptorPointerID());
+	jobject connection = (*env)->GetObjectField(env, monetDBTable, getGetConnectionID());
+	mvc *m = NULL;
+	sql_table *table;
+	int ncols, schemaNumber;
+	char *err;
+
+	*connectionPointer = (*env)->GetLongField(env, connection, getGetConnectionLongID());
+	(*env)->DeleteLocalRef(env, connection);
+	if ((err = getSQLContext((Client) *connectionPointer, NULL, &m, NULL)) != MAL_SUCCEED)
+		return err;
+	schemaNumber = (m->session->tr && m->session->tr->schema_updates) ? -1 : store_schema_number();
+	if (cached && schemaNumber >= 0 && cached->schemaNumber == schemaNumber) {
+		*res = cached;
+		return MAL_SUCCEED;
+	}
+	if ((err = loadTable(env, monetDBTable, &table, &ncols, connectionPointer)) != MAL_SUCCEED)
+		return err;
+	if (!(*res = createTableDescriptor(table, ncols, schemaNumber)))
+		return createException(MAL, "embedded.getTable", MAL_MALLOC_FAIL);
+	freeTableDescriptor(cached);
+	(*env)->SetLongField(env, monetDBTable, getTableDescriptorPointerID(), (jlong) *res);
+	return MAL_SUCCEED;
+}
+
+#define LOADTABLEDESCRIPTOR \
+	JTableDescriptor *desc; \
 	jlong connectionPointer; \
-	node *n; \
-	char* err = loadTable(env, monetDBTable, &tableData, &ncols, &connectionPointer);
+	int i; \
+	char* err = getTableDescriptor(env, monetDBTable, &desc, &connectionPointer);
 
-#define AFTERLOAD \
+#define AFTERLOAD(RETURN_VALUE) \
 	if (err) { \
 		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err); \
 		freeException(err); \
+		return RETURN_VALUE; \
 	}
 
 JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getNumberOfColumns
 	(JNIEnv *env, jobject monetDBTable) {
-	LOADTABLEDATA
-	AFTERLOAD
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD(0)
 
-	(void) n;
-	if((*env)->ExceptionCheck(env) == JNI_TRUE) {
-		return 0;
-	} else {
-		return ncols;
-	}
+	(void) i;
+	(void) connectionPointer;
+	return desc->ncols;
 }
 
-JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnNamesInternal
-	(JNIEnv *env, jobject monetDBTable, jobjectArray result) {
-	LOADTABLEDATA
-	AFTERLOAD
+static void setStringColumnsMetadata(JNIEnv *env, jobjectArray result, char **values, int ncols) {
+	int i;
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		jstring colname = (*env)->NewStringUTF(env, col->base.name);
-		if (!colname) {
+	for (i = 0; i < ncols; i++) {
+		jstring next = (*env)->NewStringUTF(env, values[i]);
+		if (!next) {
 			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 			return;
 		}
-		(*env)->SetObjectArrayElement(env, result, col->colnr, colname);
-		(*env)->DeleteLocalRef(env, colname);
+		(*env)->SetObjectArrayElement(env, result, i, next);
+		(*env)->DeleteLocalRef(env, next);
 	}
 }
 
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnNamesInternal
+	(JNIEnv *env, jobject monetDBTable, jobjectArray result) {
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD()
+
+	(void) i;
+	(void) connectionPointer;
+	setStringColumnsMetadata(env, result, desc->columnNames, desc->ncols);
+}
+
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnTypesInternal
 	(JNIEnv *env, jobject monetDBTable, jobjectArray result) {
-	LOADTABLEDATA
-	AFTERLOAD
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD()
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		jstring coltype = (*env)->NewStringUTF(env, col->type.type->sqlname);
-		if (!coltype) {
-			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
-			return;
-		}
-		(*env)->SetObjectArrayElement(env, result, col->colnr, coltype);
-		(*env)->DeleteLocalRef(env, coltype);
-	}
+	(void) i;
+	(void) connectionPointer;
+	setStringColumnsMetadata(env, result, desc->sqlnames, desc->ncols);
 }
 
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getMappingsInternal
 	(JNIEnv *env, jobject monetDBTable, jobjectArray result) {
-	LOADTABLEDATA
-	AFTERLOAD
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD()
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		jstring colsqlname = (*env)->NewStringUTF(env, col->type.type->sqlname);
+	(void) connectionPointer;
+	for (i = 0; i < desc->ncols; i++) {
+		jstring colsqlname = (*env)->NewStringUTF(env, desc->sqlnames[i]);
 		if (!colsqlname) {
 			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 			return;
 		}
 		jobject next = (*env)->CallStaticObjectMethod(env, getMappingEnumID(), getGetEnumValueID(), colsqlname);
-		(*env)->SetObjectArrayElement(env, result, col->colnr, next);
+		(*env)->DeleteLocalRef(env, colsqlname);
+		if ((*env)->ExceptionCheck(env) == JNI_TRUE)
+			return;
+		(*env)->SetObjectArrayElement(env, result, i, next);
 		(*env)->DeleteLocalRef(env, next);
 	}
 }
 
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnDigitsInternal
 	(JNIEnv *env, jobject monetDBTable, jintArray result) {
-	LOADTABLEDATA
-	jint* fdigits;
-	AFTERLOAD
-
-	if (!(fdigits = GDKmalloc(ncols * sizeof(jint)))) {
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
-		return;
-	}
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD()
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		fdigits[col->colnr] = col->type.digits;
-	}
-	(*env)->SetIntArrayRegion(env, result, 0, ncols, fdigits);
-	GDKfree(fdigits);
-};
+	(void) i;
+	(void) connectionPointer;
+	(*env)->SetIntArrayRegion(env, result, 0, desc->ncols, desc->digits);
+}
 
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnScalesInternal
 	(JNIEnv *env, jobject monetDBTable, jintArray result) {
-	LOADTABLEDATA
-	jint* fscales;
-	AFTERLOAD
-
-	if (!(fscales = GDKmalloc(ncols * sizeof(jint)))) {
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
-		return;
-	}
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD()
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		fscales[col->colnr] = col->type.scale;
-	}
-	(*env)->SetIntArrayRegion(env, result, 0, ncols, fscales);
-	GDKfree(fscales);
-};
+	(void) i;
+	(void) connectionPointer;
+	(*env)->SetIntArrayRegion(env, result, 0, desc->ncols, desc->scales);
+}
 
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnNullableIndexesInternal
 	(JNIEnv *env, jobject monetDBTable, jbooleanArray result) {
-	LOADTABLEDATA
-	jboolean* fnulls;
-	AFTERLOAD
-
-	if (!(fnulls = GDKmalloc(ncols * sizeof(jboolean)))) {
-		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
-		return;
-	}
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD()
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		fnulls[col->colnr] = (jboolean) col->null;
-	}
-	(*env)->SetBooleanArrayRegion(env, result, 0, ncols, fnulls);
-	GDKfree(fnulls);
+	(void) i;
+	(void) connectionPointer;
+	(*env)->SetBooleanArrayRegion(env, result, 0, desc->ncols, desc->nulls);
 }
 
 JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnDefaultValuesInternal
 	(JNIEnv *env, jobject monetDBTable, jobjectArray result) {
-	LOADTABLEDATA
-	AFTERLOAD
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD()
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		jstring defaultValue = (*env)->NewStringUTF(env, col->def);
-		if (!defaultValue) {
+	(void) connectionPointer;
+	for (i = 0; i < desc->ncols; i++) {
+		jstring defaultValue = (*env)->NewStringUTF(env, desc->defaults[i]);
+		if (!defaultValue && desc->defaults[i]) {
 			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 			return;
 		}
-		(*env)->SetObjectArrayElement(env, result, col->colnr, defaultValue);
-		(*env)->DeleteLocalRef(env, defaultValue);
+		(*env)->SetObjectArrayElement(env, result, i, defaultValue);
+		if (defaultValue)
+			(*env)->DeleteLocalRef(env, defaultValue);
 	}
 }
 
-static jobject getColumnData(JNIEnv *env, sql_column *col) {
+static jobject getColumnData(JNIEnv *env, JTableDescriptor *desc, int i) {
 	jobject res = NULL;
-	jstring sqlname = (*env)->NewStringUTF(env, col->type.type->sqlname);
-	jstring colname = (*env)->NewStringUTF(env, col->base.name);
-	jstring defaultValue = (*env)->NewStringUTF(env, col->def);
+	jstring sqlname = (*env)->NewStringUTF(env, desc->sqlnames[i]);
+	jstring colname = (*env)->NewStringUTF(env, desc->columnNames[i]);
+	jstring defaultValue = (*env)->NewStringUTF(env, desc->defaults[i]);
 
-	if (sqlname && colname  && defaultValue) {
-		res = (*env)->NewObject(env, getMonetDBTableColumnClassID(), getMonetDBTableColumnConstructorID(), sqlname, colname, col->type.digits, col->type.scale, defaultValue, (jboolean) col->null);
+	if (sqlname && colname && (defaultValue || !desc->defaults[i])) {
+		res = (*env)->NewObject(env, getMonetDBTableColumnClassID(), getMonetDBTableColumnConstructorID(), sqlname, colname, desc->digits[i], desc->scales[i], defaultValue, desc->nulls[i]);
 		if (!res)
 			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 	} else {
@@ -212,39 +320,33 @@ static jobject getColumnData(JNIEnv *env, sql_column *col) {
 
 JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnMetadataByIndex
 	(JNIEnv *env, jobject monetDBTable, jint index) {
-	LOADTABLEDATA
-	jobject res = NULL;
-	AFTERLOAD
+	LOADTABLEDESCRIPTOR
+	AFTERLOAD(NULL)
 
+	(void) i;
+	(void) connectionPointer;
 	index--;
-	if(index > -1 && index < ncols) {
-		for (n = tableData->columns.set->h; n; n = n->next) {
-			sql_column *col = n->data;
-			if(col->colnr == index) {
-				res = getColumnData(env, col);
-				break;
-			}
-		}
-	}
-	return res;
+	if(index > -1 && index < desc->ncols)
+		return getColumnData(env, desc, index);
+	return NULL;
 }
 
 JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getColumnMetadataByName
 	(JNIEnv *env, jobject monetDBTable, jstring colname) {
-	LOADTABLEDATA
+	LOADTABLEDESCRIPTOR
 	jobject res = NULL;
 	const char *col_name_tmp;
-	AFTERLOAD
+	AFTERLOAD(NULL)
 
+	(void) connectionPointer;
 	if (!(col_name_tmp = (*env)->GetStringUTFChars(env, colname, NULL))) {
 		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 		return NULL;
 	}
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		if(!strcmp(col_name_tmp, col->base.name)) {
-			res = getColumnData(env, col);
+	for (i = 0; i < desc->ncols; i++) {
+		if(!strcmp(col_name_tmp, desc->columnNames[i])) {
+			res = getColumnData(env, desc, i);
 			break;
 		}
 	}
@@ -254,73 +356,183 @@ JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getCo
 
 JNIEXPORT jobjectArray JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getAllColumnsMetadata
 	(JNIEnv *env, jobject monetDBTable) {
-	LOADTABLEDATA
+	LOADTABLEDESCRIPTOR
 	jobjectArray result;
-	AFTERLOAD
+	AFTERLOAD(NULL)
 
-	if (!(result = (*env)->NewObjectArray(env, ncols, getMonetDBTableColumnClassID(), NULL))) {
+	(void) connectionPointer;
+	if (!(result = (*env)->NewObjectArray(env, desc->ncols, getMonetDBTableColumnClassID(), NULL))) {
 		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 		return NULL;
 	}
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		sql_column *col = n->data;
-		jobject newColumn = getColumnData(env, col);
+	for (i = 0; i < desc->ncols; i++) {
+		jobject newColumn = getColumnData(env, desc, i);
 		if ((*env)->ExceptionCheck(env) == JNI_TRUE) {
 			(*env)->DeleteLocalRef(env, result);
 			return NULL;
 		}
-		(*env)->SetObjectArrayElement(env, result, col->colnr, newColumn);
+		(*env)->SetObjectArrayElement(env, result, i, newColumn);
 		(*env)->DeleteLocalRef(env, newColumn);
 	}
 	return result;
 }
 
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_freeTableDescriptorInternal
+	(JNIEnv *env, jobject monetDBTable) {
+	freeTableDescriptor((JTableDescriptor*) (*env)->GetLongField(env, monetDBTable, getTableDescriptorPointerID()));
+	(*env)->SetLongField(env, monetDBTable, getTableDescriptorPointerID(), 0);
+}
+
 #define CHECK_ARRAY_CLASS(METHOD, ARRAY_CLASS) \
 	if((*env)->IsInstanceOf(env, nextArray, METHOD) == JNI_FALSE) { \
 		err = createException(MAL, "append", "The array at column %d must be a %s array!", nextColumnIndex + 1, ARRAY_CLASS); \
 		break; \
 	}
 
+/* Converts a Java column array into a new BAT of the table column's type */
+static char* storeJavaColumn(JNIEnv *env, JTableDescriptor *desc, int nextColumnIndex, jobject nextArray,
+							 jsize numberOfRows, jint *jscales, jint roundingMode, BAT **res) {
+	int nextMonetDBIndex = desc->localtypes[nextColumnIndex];
+	jint nextJavaIndex = desc->javaIndexes[nextColumnIndex], digits = desc->digits[nextColumnIndex],
+		 scale = desc->scales[nextColumnIndex];
+	BAT* nextBAT = NULL;
+	char *err = MAL_SUCCEED;
+
+	switch(nextJavaIndex) {
+		case 0: //boolean
+			CHECK_ARRAY_CLASS(getByteArrayClassID(), "byte")
+			storeBooleanColumn(env, &nextBAT, (jbyteArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 1: //char
+		case 2: //varchar
+		case 3: //clob
+			CHECK_ARRAY_CLASS(getStringArrayClassID(), "java.lang.String")
+			storeStringColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 4: //tinyint
+			CHECK_ARRAY_CLASS(getByteArrayClassID(), "byte")
+			storeTinyintColumn(env, &nextBAT, (jbyteArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 5: //smallint
+			CHECK_ARRAY_CLASS(getShortArrayClassID(), "short")
+			storeSmallintColumn(env, &nextBAT, (jshortArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 6: //int
+		case 11: //month_interval
+			CHECK_ARRAY_CLASS(getIntegerArrayClassID(), "int")
+			storeIntColumn(env, &nextBAT, (jintArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 7: //bigint
+		case 12: //second_interval
+			CHECK_ARRAY_CLASS(getLongArrayClassID(), "long")
+			storeBigintColumn(env, &nextBAT, (jlongArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 8: //decimal
+			if((*env)->IsInstanceOf(env, nextArray, getLongArrayClassID()) == JNI_TRUE) { //unscaled values
+				jint inputScale = jscales ? jscales[nextColumnIndex] : (jint) scale;
+				if(digits <= 2) {
+					storeDecimalbteFromUnscaledColumn(env, &nextBAT, (jlongArray) nextArray, numberOfRows, nextMonetDBIndex, digits, scale, inputScale, roundingMode);
+				} else if(digits > 2 && digits <= 4) {
+					storeDecimalshtFromUnscaledColumn(env, &nextBAT, (jlongArray) nextArray, numberOfRows, nextMonetDBIndex, digits, scale, inputScale, roundingMode);
+				} else if(digits > 4 && digits <= 8) {
+					storeDecimalintFromUnscaledColumn(env, &nextBAT, (jlongArray) nextArray, numberOfRows, nextMonetDBIndex, digits, scale, inputScale, roundingMode);
+				} else {
+					storeDecimallngFromUnscaledColumn(env, &nextBAT, (jlongArray) nextArray, numberOfRows, nextMonetDBIndex, digits, scale, inputScale, roundingMode);
+				}
+				break;
+			}
+			CHECK_ARRAY_CLASS(getBigDecimalArrayClassID(), "java.math.BigDecimal or long")
+			if(digits <= 2) {
+				storeDecimalbteColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex, scale, roundingMode);
+			} else if(digits > 2 && digits <= 4) {
+				storeDecimalshtColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex, scale, roundingMode);
+			} else if(digits > 4 && digits <= 8) {
+				storeDecimalintColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex, scale, roundingMode);
+			} else {
+				storeDecimallngColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex, scale, roundingMode);
+			}
+			break;
+		case 9: //real
+			CHECK_ARRAY_CLASS(getFloatArrayClassID(), "float")
+			storeRealColumn(env, &nextBAT, (jfloatArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 10: //double
+			CHECK_ARRAY_CLASS(getDoubleArrayClassID(), "double")
+			storeDoubleColumn(env, &nextBAT, (jdoubleArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 13: //time
+		case 14: //timetz
+			if((*env)->IsInstanceOf(env, nextArray, getLongArrayClassID()) == JNI_TRUE) { //micros of the day
+				storeTimeFromMicrosColumn(env, &nextBAT, (jlongArray) nextArray, numberOfRows, nextMonetDBIndex);
+				break;
+			}
+			CHECK_ARRAY_CLASS(getTimeArrayClassID(), "java.sql.Time or long")
+			storeTimeColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 15: //date
+			if((*env)->IsInstanceOf(env, nextArray, getIntegerArrayClassID()) == JNI_TRUE) { //days since epoch
+				storeDateFromEpochDaysColumn(env, &nextBAT, (jintArray) nextArray, numberOfRows, nextMonetDBIndex);
+				break;
+			}
+			CHECK_ARRAY_CLASS(getDateClassArrayID(), "java.sql.Date or int")
+			storeDateColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 16: //timestamp
+		case 17: //timestamptz
+			if((*env)->IsInstanceOf(env, nextArray, getLongArrayClassID()) == JNI_TRUE) { //micros since epoch
+				storeTimestampFromEpochMicrosColumn(env, &nextBAT, (jlongArray) nextArray, numberOfRows, nextMonetDBIndex);
+				break;
+			}
+			CHECK_ARRAY_CLASS(getTimestampArrayClassID(), "java.sql.Timestamp or long")
+			storeTimestampColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 18: //blob
+			CHECK_ARRAY_CLASS(getByteMatrixClassID(), "byte[]")
+			storeBlobColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		case 19: //oid
+			CHECK_ARRAY_CLASS(getStringArrayClassID(), "java.lang.String")
+			storeOidColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
+			break;
+		default:
+			err = createException(MAL, "append", "Unknown Java mapping class");
+	}
+	*res = nextBAT;
+	return err;
+}
+
 JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_appendColumnsInternal
-	(JNIEnv *env, jobject monetDBTable, jobjectArray columnData, jintArray javaIndexes, jint roundingMode) {
-	LOADTABLEDATA
+	(JNIEnv *env, jobject monetDBTable, jobjectArray columnData, jintArray decimalScales, jint roundingMode) {
+	LOADTABLEDESCRIPTOR
 
-	jint *jindexes;
+	jint *jscales = NULL;
 	bat* newdata = NULL;
 	jsize numberOfRows, nextSize;
-	sql_column *col;
-	int nextMonetDBIndex, nextColumnIndex, foundExc = 0, i = 0;
-	jint nextJavaIndex;
+	int nextColumnIndex, ncols, foundExc = 0;
 	BAT* nextBAT;
 	jobject nextArray, columnDataZero;
 
-	AFTERLOAD
+	AFTERLOAD(-1)
 
-	if ((*env)->ExceptionCheck(env) == JNI_TRUE)
-		return -1;
-	if (!(jindexes = (*env)->GetIntArrayElements(env, javaIndexes, NULL))) {
+	ncols = desc->ncols;
+	if (!(columnDataZero = (*env)->GetObjectArrayElement(env, columnData, 0))) {
 		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 		return -1;
 	}
-	if (!(columnDataZero = (*env)->GetObjectArrayElement(env, columnData, 0))) {
-		(*env)->ReleaseIntArrayElements(env, javaIndexes, jindexes, JNI_ABORT);
+	numberOfRows = (*env)->GetArrayLength(env, columnDataZero);
+	if (decimalScales && !(jscales = (*env)->GetIntArrayElements(env, decimalScales, NULL))) {
 		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 		return -1;
 	}
-	numberOfRows = (*env)->GetArrayLength(env, columnDataZero);
 	if (!(newdata = GDKzalloc(ncols * sizeof(bat*)))) {
-		(*env)->ReleaseIntArrayElements(env, javaIndexes, jindexes, JNI_ABORT);
+		if (jscales)
+			(*env)->ReleaseIntArrayElements(env, decimalScales, jscales, JNI_ABORT);
 		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
 		return -1;
 	}
 
-	for (n = tableData->columns.set->h; n; n = n->next) {
-		col = n->data;
-		nextMonetDBIndex = col->type.type->localtype;
-		nextColumnIndex = col->colnr;
-		nextJavaIndex = jindexes[nextColumnIndex];
-
+	for (nextColumnIndex = 0; nextColumnIndex < ncols; nextColumnIndex++) {
 		nextBAT = NULL;
 		nextArray = (*env)->GetObjectArrayElement(env, columnData, nextColumnIndex);
 		nextSize = (*env)->GetArrayLength(env, nextArray);
@@ -329,91 +541,19 @@ JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_appendCo
 			break;
 		}
 
-		switch(nextJavaIndex) {
-			case 0: //boolean
-				CHECK_ARRAY_CLASS(getByteArrayClassID(), "byte")
-				storeBooleanColumn(env, &nextBAT, (jbyteArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 1: //char
-			case 2: //varchar
-			case 3: //clob
-				CHECK_ARRAY_CLASS(getStringArrayClassID(), "java.lang.String")
-				storeStringColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 4: //tinyint
-				CHECK_ARRAY_CLASS(getByteArrayClassID(), "byte")
-				storeTinyintColumn(env, &nextBAT, (jbyteArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 5: //smallint
-				CHECK_ARRAY_CLASS(getShortArrayClassID(), "short")
-				storeSmallintColumn(env, &nextBAT, (jshortArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 6: //int
-			case 11: //month_interval
-				CHECK_ARRAY_CLASS(getIntegerArrayClassID(), "int")
-				storeIntColumn(env, &nextBAT, (jintArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 7: //bigint
-			case 12: //second_interval
-				CHECK_ARRAY_CLASS(getLongArrayClassID(), "long")
-				storeBigintColumn(env, &nextBAT, (jlongArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 8: //decimal
-				CHECK_ARRAY_CLASS(getBigDecimalArrayClassID(), "java.math.BigDecimal")
-				if(col->type.digits <= 2) {
-					storeDecimalbteColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex, col->type.scale, roundingMode);
-				} else if(col->type.digits > 2 && col->type.digits <= 4) {
-					storeDecimalshtColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex, col->type.scale, roundingMode);
-				} else if(col->type.digits > 4 && col->type.digits <= 8) {
-					storeDecimalintColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex, col->type.scale, roundingMode);
-				} else {
-					storeDecimallngColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex, col->type.scale, roundingMode);
-				}
-				break;
-			case 9: //real
-				CHECK_ARRAY_CLASS(getFloatArrayClassID(), "float")
-				storeRealColumn(env, &nextBAT, (jfloatArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 10: //double
-				CHECK_ARRAY_CLASS(getDoubleArrayClassID(), "double")
-				storeDoubleColumn(env, &nextBAT, (jdoubleArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 13: //time
-			case 14: //timetz
-				CHECK_ARRAY_CLASS(getTimeArrayClassID(), "java.sql.Time")
-				storeTimeColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 15: //date
-				CHECK_ARRAY_CLASS(getDateClassArrayID(), "java.sql.Date")
-				storeDateColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 16: //timestamp
-			case 17: //timestamptz
-				CHECK_ARRAY_CLASS(getTimestampArrayClassID(), "java.sql.Timestamp")
-				storeTimestampColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 18: //blob
-				CHECK_ARRAY_CLASS(getByteMatrixClassID(), "byte[]")
-				storeBlobColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			case 19: //oid
-				CHECK_ARRAY_CLASS(getStringArrayClassID(), "java.lang.String")
-				storeOidColumn(env, &nextBAT, (jobjectArray) nextArray, numberOfRows, nextMonetDBIndex);
-				break;
-			default:
-				err = createException(MAL, "append", "Unknown Java mapping class");
-		}
+		err = storeJavaColumn(env, desc, nextColumnIndex, nextArray, numberOfRows, jscales, roundingMode, &nextBAT);
 		(*env)->DeleteLocalRef(env, nextArray);
-		if(!err) {
+		if(!err && nextBAT) {
 			newdata[nextColumnIndex] = nextBAT->batCacheid;
 		} else {
 			break;
 		}
 	}
 
-	if(!err)
-		err = monetdb_append((monetdb_connection) connectionPointer, tableData->s->base.name, tableData->base.name, newdata, ncols);
-	(*env)->ReleaseIntArrayElements(env, javaIndexes, jindexes, JNI_ABORT);
+	if(!err && (*env)->ExceptionCheck(env) == JNI_FALSE)
+		err = monetdb_append((monetdb_connection) connectionPointer, desc->schema, desc->name, newdata, ncols);
+	if (jscales)
+		(*env)->ReleaseIntArrayElements(env, decimalScales, jscales, JNI_ABORT);
 	if (newdata) {
 		for(int j = 0; j < ncols; j++) {
 			if (newdata[j])
@@ -423,6 +563,7 @@ JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_appendCo
 	}
 
 	if (err) {
+		i = 0;
 		while(err[i] && !foundExc) {
 			if(err[i] == '!')
 				foundExc = 1;
@@ -431,7 +572,1874 @@ JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_appendCo
 		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err + (foundExc ? i : 0));
 		freeException(err);
 		return -1;
+	} else if ((*env)->ExceptionCheck(env) == JNI_TRUE) { //a conversion has already thrown
+		return -1;
 	} else {
 		return numberOfRows;
 	}
 }
+
+/* The column property flags of the table statistics, the same as in the Java class */
+#define STATS_KNOWN       1
+#define STATS_SORTED      2
+#define STATS_REVSORTED   4
+#define STATS_KEY         8
+#define STATS_NONIL       16
+
+/* Loads the table in the connection's current transaction, to read its storage directly */
+static char* loadTableTransaction(JNIEnv *env, jobject monetDBTable, sql_table **table, int *ncols, mvc **m) {
+	jlong connectionPointer;
+	char *err;
+
+	if ((err = loadTable(env, monetDBTable, table, ncols, &connectionPointer)) != MAL_SUCCEED)
+		return err;
+	if ((err = getSQLContext((Client) connectionPointer, NULL, m, NULL)) != MAL_SUCCEED)
+		return err;
+	return SQLtrans(*m);
+}
+
+/* The visible rows are the ones stored in the first column, including the transaction's inserts, minus the deletes */
+static lng countVisibleRows(sql_trans *tr, sql_table *table, size_t *deleted) {
+	sql_column *first = table->columns.set->h->data;
+	size_t all = store_funcs.count_col(tr, first, 1);
+
+	*deleted = store_funcs.count_del(tr, table);
+	return all > *deleted ? (lng) (all - *deleted) : 0;
+}
+
+static void endTableTransaction(mvc *m) {
+	char *other;
+	if (m && (other = SQLautocommit(m)) != MAL_SUCCEED)
+		freeException(other);
+}
+
+static jstring formatColumnValue(JNIEnv *env, sql_column *col, int type, const void *p) {
+	char *value = NULL;
+	jstring res = NULL;
+
+	if (ATOMcmp(type, p, ATOMnilptr(type)) == 0)
+		return NULL;
+	if (type == TYPE_str) {
+		res = (*env)->NewStringUTF(env, (const char*) p);
+	} else {
+		if (col->type.type->eclass == EC_DEC) {
+			lng unscaled;
+			switch (ATOMbasetype(type)) {
+				case TYPE_bte: unscaled = *(const bte*) p; break;
+				case TYPE_sht: unscaled = *(const sht*) p; break;
+				case TYPE_int: unscaled = *(const int*) p; break;
+				default: unscaled = *(const lng*) p; break;
+			}
+			value = decimal_to_str(unscaled, &col->type);
+		} else {
+			value = ATOMformat(type, p);
+		}
+		if (value) {
+			res = (*env)->NewStringUTF(env, value);
+			GDKfree(value);
+		}
+	}
+	if (!res)
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
+	return res;
+}
+
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getNumberOfRowsInternal
+	(JNIEnv *env, jobject monetDBTable) {
+	sql_table *tableData;
+	int ncols;
+	mvc *m = NULL;
+	size_t deleted;
+	lng rows = -1;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+	} else {
+		rows = countVisibleRows(m->session->tr, tableData, &deleted);
+	}
+	endTableTransaction(m);
+	return (jlong) rows;
+}
+
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getTableStatisticsInternal
+	(JNIEnv *env, jobject monetDBTable, jlongArray deletedRows, jlongArray nilCounts, jlongArray distinctCounts,
+	 jbyteArray flags, jobjectArray minimums, jobjectArray maximums) {
+	sql_table *tableData;
+	sql_trans *tr;
+	int ncols = 0;
+	mvc *m = NULL;
+	node *n;
+	size_t deleted = 0;
+	lng rows = -1;
+	jlong jdeleted, *nils = NULL, *distincts = NULL;
+	jbyte *jflags = NULL;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err)
+		goto cleanup;
+	if (!(nils = GDKmalloc(sizeof(jlong) * ncols)) || !(distincts = GDKmalloc(sizeof(jlong) * ncols)) ||
+		!(jflags = GDKmalloc(sizeof(jbyte) * ncols))) {
+		err = createException(MAL, "embedded.getTableStatistics", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	tr = m->session->tr;
+	rows = countVisibleRows(tr, tableData, &deleted);
+
+	for (n = tableData->columns.set->h; n; n = n->next) {
+		sql_column *col = n->data;
+		int i = col->colnr;
+		BAT *b;
+		BUN cnt;
+		jstring min = NULL, max = NULL;
+
+		nils[i] = -1;
+		distincts[i] = -1;
+		jflags[i] = 0;
+		/* the properties of the stored column only describe the visible rows without pending deletes or updates */
+		if (deleted > 0 || store_funcs.count_col_upd(tr, col) > 0)
+			continue;
+		if (!(b = store_funcs.bind_col(tr, col, RDONLY))) {
+			err = createException(SQL, "embedded.getTableStatistics", "Cannot access column '%s'", col->base.name);
+			goto cleanup;
+		}
+		cnt = BATcount(b);
+		if ((lng) cnt != rows) { /* the transaction's inserts are kept apart */
+			BBPunfix(b->batCacheid);
+			continue;
+		}
+		jflags[i] = STATS_KNOWN | (b->tsorted ? STATS_SORTED : 0) | (b->trevsorted ? STATS_REVSORTED : 0) |
+					(b->tkey ? STATS_KEY : 0) | (b->tnonil ? STATS_NONIL : 0);
+		if (b->tnonil) {
+			nils[i] = 0;
+			if (b->tkey)
+				distincts[i] = (jlong) cnt;
+		}
+		if (cnt > 0) {
+			BATiter bi = bat_iterator(b);
+			const void *minp = NULL, *maxp = NULL;
+			PROPrec *prop;
+
+			if (b->tnonil && (b->tsorted || b->trevsorted)) {
+				minp = BUNtail(bi, b->tsorted ? 0 : cnt - 1);
+				maxp = BUNtail(bi, b->tsorted ? cnt - 1 : 0);
+			} else { /* only if GDK already computed them */
+				if ((prop = BATgetprop(b, GDK_MIN_VALUE)) != NULL)
+					minp = VALptr(&prop->v);
+				if ((prop = BATgetprop(b, GDK_MAX_VALUE)) != NULL)
+					maxp = VALptr(&prop->v);
+			}
+			if (minp && (min = formatColumnValue(env, col, b->ttype, minp)) != NULL) {
+				(*env)->SetObjectArrayElement(env, minimums, i, min);
+				(*env)->DeleteLocalRef(env, min);
+			}
+			if (maxp && (*env)->ExceptionCheck(env) == JNI_FALSE &&
+				(max = formatColumnValue(env, col, b->ttype, maxp)) != NULL) {
+				(*env)->SetObjectArrayElement(env, maximums, i, max);
+				(*env)->DeleteLocalRef(env, max);
+			}
+		}
+		BBPunfix(b->batCacheid);
+		if ((*env)->ExceptionCheck(env) == JNI_TRUE)
+			goto cleanup;
+	}
+	jdeleted = (jlong) deleted;
+	(*env)->SetLongArrayRegion(env, deletedRows, 0, 1, &jdeleted);
+	(*env)->SetLongArrayRegion(env, nilCounts, 0, ncols, nils);
+	(*env)->SetLongArrayRegion(env, distinctCounts, 0, ncols, distincts);
+	(*env)->SetByteArrayRegion(env, flags, 0, ncols, jflags);
+
+cleanup:
+	endTableTransaction(m);
+	if (nils)
+		GDKfree(nils);
+	if (distincts)
+		GDKfree(distincts);
+	if (jflags)
+		GDKfree(jflags);
+	if (err) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+		return -1;
+	}
+	return (jlong) rows;
+}
+
+/* A snapshot of the projected columns of a table, scanned in batches by iterateTable. The transaction stays open
+ * until the cursor is closed, so the bound BATs are not merged with the deltas meanwhile */
+typedef struct {
+	mvc *m;
+	int autoCommit; /* the auto-commit mode of the session, suspended while the cursor is open */
+	int ncols;
+	sql_column **cols;
+	int *typeIDs;
+	BAT **bats; /* the stored values of each column, with the updates applied */
+	BAT **inserts; /* the values inserted in the transaction of each column, or NULL if none */
+	BAT **gathered; /* the values of each column in a batch not within one BAT, reused between batches */
+	BUN stored; /* the number of stored rows, followed by the inserts */
+	oid *deleted; /* the sorted positions of the deleted rows */
+	BUN ndeleted;
+	oid *positions; /* the positions of the rows in a batch crossing deleted rows */
+	BUN capacity;
+	BUN count;
+} JTableCursor;
+
+/* The same type IDs of the query result sets */
+static int getColumnTypeID(sql_column *col) {
+	const char *name = col->type.type->sqlname;
+	if (strcmp(name, "boolean") == 0)
+		return 1;
+	if (strcmp(name, "tinyint") == 0)
+		return 2;
+	if (strcmp(name, "smallint") == 0)
+		return 3;
+	if (strcmp(name, "int") == 0 || strcmp(name, "month_interval") == 0)
+		return 4;
+	if (strcmp(name, "bigint") == 0 || strcmp(name, "sec_interval") == 0)
+		return 5;
+	if (strcmp(name, "real") == 0)
+		return 6;
+	if (strcmp(name, "double") == 0)
+		return 7;
+	if (strcmp(name, "char") == 0 || strcmp(name, "varchar") == 0 || strcmp(name, "clob") == 0)
+		return 8;
+	if (strcmp(name, "date") == 0)
+		return 9;
+	if (strcmp(name, "timestamp") == 0 || strcmp(name, "timestamptz") == 0)
+		return 10;
+	if (strcmp(name, "time") == 0 || strcmp(name, "timetz") == 0)
+		return 11;
+	if (strcmp(name, "blob") == 0)
+		return 12;
+	if (strcmp(name, "decimal") == 0)
+		return 13;
+	if (strcmp(name, "oid") == 0)
+		return 14;
+	return 0;
+}
+
+static void getColumnBatch(JNIEnv *env, sql_column *col, int typeID, jobjectArray result, jint first, jint size,
+						   BAT *b) {
+	switch(typeID) {
+		case 1:
+			getBooleanColumnAsObject(env, result, first, size, b);
+			break;
+		case 2:
+			getTinyintColumnAsObject(env, result, first, size, b);
+			break;
+		case 3:
+			getSmallintColumnAsObject(env, result, first, size, b);
+			break;
+		case 4:
+			getIntColumnAsObject(env, result, first, size, b);
+			break;
+		case 5:
+			getBigintColumnAsObject(env, result, first, size, b);
+			break;
+		case 6:
+			getRealColumnAsObject(env, result, first, size, b);
+			break;
+		case 7:
+			getDoubleColumnAsObject(env, result, first, size, b);
+			break;
+		case 8:
+			getStringColumn(env, result, first, size, b);
+			break;
+		case 9:
+			getDateColumn(env, result, first, size, b);
+			break;
+		case 10:
+			getTimestampColumn(env, result, first, size, b);
+			break;
+		case 11:
+			getTimeColumn(env, result, first, size, b);
+			break;
+		case 12:
+			getBlobColumn(env, result, first, size, b);
+			break;
+		case 13:
+			if(col->type.digits <= 2) {
+				getDecimalbteColumn(env, result, first, size, b, col->type.scale);
+			} else if(col->type.digits > 2 && col->type.digits <= 4) {
+				getDecimalshtColumn(env, result, first, size, b, col->type.scale);
+			} else if(col->type.digits > 4 && col->type.digits <= 8) {
+				getDecimalintColumn(env, result, first, size, b, col->type.scale);
+			} else {
+				getDecimallngColumn(env, result, first, size, b, col->type.scale);
+			}
+			break;
+		case 14:
+			getOidColumn(env, result, first, size, b);
+			break;
+		default:
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "Unknown MonetDB type");
+	}
+}
+
+static int compareRowIds(const void *a, const void *b) {
+	oid x = *(const oid *) a, y = *(const oid *) b;
+	return x < y ? -1 : x > y;
+}
+
+/* Binds the stored values of a column, with the updates applied, apart from the transaction's inserts, so the stored
+ * BAT shared by the transactions is never copied. The inserts are left NULL when there are none, while the stored BAT
+ * is left to the caller to release on failure */
+static char* bindVisibleColumn(sql_trans *tr, sql_table *table, sql_column *col, const char *call, BAT **stored,
+							   BAT **inserts) {
+	BAT *ins;
+
+	*inserts = NULL;
+	if (!(*stored = store_funcs.bind_col(tr, col, RDONLY)))
+		return createException(SQL, call, "Cannot access column '%s'", col->base.name);
+	if (isTempTable(table)) /* the temporary tables keep everything in the inserts */
+		return MAL_SUCCEED;
+	if (!(ins = store_funcs.bind_col(tr, col, RD_INS)))
+		return createException(SQL, call, "Cannot access column '%s'", col->base.name);
+	if (BATcount(ins) == 0)
+		BBPunfix(ins->batCacheid);
+	else
+		*inserts = ins;
+	return MAL_SUCCEED;
+}
+
+/* Copies the positions of the rows deleted in the transaction, sorted and without duplicates, or NULL if there are
+ * no deletes */
+static char* getSortedDeletes(sql_trans *tr, sql_table *table, BUN all, const char *call, oid **deleted,
+							  BUN *ndeleted) {
+	BAT *dels;
+	BUN i, n = 0;
+	char *err = MAL_SUCCEED;
+
+	*deleted = NULL;
+	*ndeleted = 0;
+	if (!(dels = store_funcs.bind_del(tr, table, RDONLY)))
+		return createException(SQL, call, "Cannot access the deletes of '%s'", table->base.name);
+	if (BATcount(dels) > 0) {
+		BATiter di = bat_iterator(dels);
+
+		if (!(*deleted = GDKmalloc(sizeof(oid) * BATcount(dels)))) {
+			err = createException(MAL, call, MAL_MALLOC_FAIL);
+		} else {
+			for (i = 0; i < BATcount(dels); i++) {
+				oid next = *(const oid*) BUNtail(di, i);
+				if (next < all)
+					(*deleted)[n++] = next;
+			}
+			qsort(*deleted, n, sizeof(oid), compareRowIds);
+			for (i = 0; i < n; i++) {
+				if (*ndeleted == 0 || (*deleted)[*ndeleted - 1] != (*deleted)[i])
+					(*deleted)[(*ndeleted)++] = (*deleted)[i];
+			}
+		}
+	}
+	BBPunfix(dels->batCacheid);
+	return err;
+}
+
+/* Finds the position of the first row id at or after a row id in a sorted list */
+static BUN findRowId(const oid *rows, BUN count, oid row) {
+	BUN lo = 0, hi = count;
+
+	while (lo < hi) {
+		BUN mid = lo + (hi - lo) / 2;
+		if (rows[mid] < row)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/* Tells if a row id is in the sorted deletes */
+static int isDeletedRow(const oid *deleted, BUN ndeleted, oid row) {
+	BUN k = findRowId(deleted, ndeleted, row);
+	return k < ndeleted && deleted[k] == row;
+}
+
+/* The number of deleted rows at or before a position */
+static BUN countDeletedUntil(JTableCursor *cursor, oid position) {
+	BUN low = 0, high = cursor->ndeleted;
+
+	while (low < high) {
+		BUN middle = low + (high - low) / 2;
+		if (cursor->deleted[middle] <= position)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+/* Finds the position of the first row of a batch, skipping the deleted rows before it, and fills the positions of
+ * the batch's rows if it crosses deleted rows. Returns whether the positions are contiguous */
+static int locateCursorBatch(JTableCursor *cursor, BUN first, BUN size, oid *start) {
+	BUN skipped = 0, next, j, n = 0;
+	oid p;
+
+	/* the smallest position preceded by first visible rows, which cannot be deleted itself */
+	while ((next = countDeletedUntil(cursor, (oid) (first + skipped))) != skipped)
+		skipped = next;
+	p = *start = (oid) (first + skipped);
+	if (skipped == cursor->ndeleted || cursor->deleted[skipped] >= p + size)
+		return 1;
+	for (j = skipped; n < size; p++) {
+		if (j < cursor->ndeleted && cursor->deleted[j] == p)
+			j++;
+		else
+			cursor->positions[n++] = p;
+	}
+	return 0;
+}
+
+/* Gets a batch of a column, as a slice of the stored values or of the inserts when contiguous, or else gathered from
+ * both around the deleted rows */
+static char* getCursorColumnSlice(JTableCursor *cursor, int i, oid start, BUN size, int contiguous, BAT **res,
+								  BUN *offset) {
+	BAT *b = cursor->bats[i], *ins = cursor->inserts[i], *gathered = cursor->gathered[i];
+	BATiter bi, ii;
+	BUN j;
+
+	if (contiguous && start + size <= cursor->stored) {
+		*res = b;
+		*offset = start;
+		return MAL_SUCCEED;
+	}
+	if (contiguous && start >= cursor->stored) {
+		*res = ins;
+		*offset = start - cursor->stored;
+		return MAL_SUCCEED;
+	}
+	if (!gathered) {
+		if (!(gathered = cursor->gathered[i] = COLnew(0, b->ttype, cursor->capacity, TRANSIENT)))
+			return createException(MAL, "embedded.iterateTable", MAL_MALLOC_FAIL);
+	} else if (BATclear(gathered, true) != GDK_SUCCEED) {
+		return createException(MAL, "embedded.iterateTable", MAL_MALLOC_FAIL);
+	}
+	bi = bat_iterator(b);
+	ii = ins ? bat_iterator(ins) : bi;
+	for (j = 0; j < size; j++) {
+		oid p = contiguous ? start + j : cursor->positions[j];
+		const void *value = p < cursor->stored ? BUNtail(bi, p) : BUNtail(ii, p - cursor->stored);
+		if (BUNappend(gathered, value, false) != GDK_SUCCEED)
+			return createException(MAL, "embedded.iterateTable", MAL_MALLOC_FAIL);
+	}
+	*res = gathered;
+	*offset = 0;
+	return MAL_SUCCEED;
+}
+
+/* Fills the Java buffer of a column, a primitive array for the numeric types or else an array of objects */
+static void getCursorColumnBatch(JNIEnv *env, sql_column *col, int typeID, jobject result, jint first, jint size,
+								 BAT *b) {
+	switch(typeID) {
+		case 1:
+		case 2:
+			getTinyintColumn(env, (jbyteArray) result, first, size, b);
+			break;
+		case 3:
+			getSmallintColumn(env, (jshortArray) result, first, size, b);
+			break;
+		case 4:
+			getIntColumn(env, (jintArray) result, first, size, b);
+			break;
+		case 5:
+			getBigintColumn(env, (jlongArray) result, first, size, b);
+			break;
+		case 6:
+			getRealColumn(env, (jfloatArray) result, first, size, b);
+			break;
+		case 7:
+			getDoubleColumn(env, (jdoubleArray) result, first, size, b);
+			break;
+		default:
+			getColumnBatch(env, col, typeID, (jobjectArray) result, first, size, b);
+	}
+}
+
+static void freeTableCursor(JTableCursor *cursor) {
+	int i;
+
+	if (!cursor)
+		return;
+	for (i = 0; i < cursor->ncols; i++) {
+		if (cursor->bats && cursor->bats[i])
+			BBPunfix(cursor->bats[i]->batCacheid);
+		if (cursor->inserts && cursor->inserts[i])
+			BBPunfix(cursor->inserts[i]->batCacheid);
+		if (cursor->gathered && cursor->gathered[i])
+			BBPunfix(cursor->gathered[i]->batCacheid);
+	}
+	if (cursor->bats)
+		GDKfree(cursor->bats);
+	if (cursor->inserts)
+		GDKfree(cursor->inserts);
+	if (cursor->gathered)
+		GDKfree(cursor->gathered);
+	if (cursor->cols)
+		GDKfree(cursor->cols);
+	if (cursor->typeIDs)
+		GDKfree(cursor->typeIDs);
+	if (cursor->deleted)
+		GDKfree(cursor->deleted);
+	if (cursor->positions)
+		GDKfree(cursor->positions);
+	GDKfree(cursor);
+}
+
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_openCursorInternal
+	(JNIEnv *env, jobject monetDBTable, jintArray columns, jintArray numberOfRows, jintArray typeIDs) {
+	sql_table *tableData;
+	sql_column **tableColumns = NULL;
+	int ncols = 0, i;
+	mvc *m = NULL;
+	node *n;
+	BUN all = 0;
+	jint *jcolumns = NULL, rows;
+	JTableCursor *cursor = NULL;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err)
+		goto cleanup;
+	if (!(jcolumns = (*env)->GetIntArrayElements(env, columns, NULL)) ||
+		!(tableColumns = GDKzalloc(sizeof(sql_column*) * ncols)) ||
+		!(cursor = GDKzalloc(sizeof(JTableCursor)))) {
+		err = createException(MAL, "embedded.iterateTable", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	for (n = tableData->columns.set->h; n; n = n->next) {
+		sql_column *col = n->data;
+		tableColumns[col->colnr] = col;
+	}
+	cursor->ncols = (int) (*env)->GetArrayLength(env, columns);
+	if (!(cursor->bats = GDKzalloc(sizeof(BAT*) * (cursor->ncols + 1))) ||
+		!(cursor->inserts = GDKzalloc(sizeof(BAT*) * (cursor->ncols + 1))) ||
+		!(cursor->gathered = GDKzalloc(sizeof(BAT*) * (cursor->ncols + 1))) ||
+		!(cursor->cols = GDKzalloc(sizeof(sql_column*) * (cursor->ncols + 1))) ||
+		!(cursor->typeIDs = GDKzalloc(sizeof(int) * (cursor->ncols + 1)))) {
+		err = createException(MAL, "embedded.iterateTable", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	all = store_funcs.count_col(m->session->tr, tableColumns[0], 1);
+	for (i = 0; i < cursor->ncols; i++) {
+		sql_column *col;
+		BUN stored;
+		if (jcolumns[i] < 0 || jcolumns[i] >= ncols) {
+			err = createException(MAL, "embedded.iterateTable", "Column index %d out of bounds", (int) jcolumns[i] + 1);
+			goto cleanup;
+		}
+		col = tableColumns[jcolumns[i]];
+		cursor->cols[i] = col;
+		if (!(cursor->typeIDs[i] = getColumnTypeID(col))) {
+			err = createException(MAL, "embedded.iterateTable", "Unknown MonetDB type");
+			goto cleanup;
+		}
+		if ((err = bindVisibleColumn(m->session->tr, tableData, col, "embedded.iterateTable", &cursor->bats[i],
+									 &cursor->inserts[i])) != MAL_SUCCEED)
+			goto cleanup;
+		stored = BATcount(cursor->bats[i]);
+		if (stored + (cursor->inserts[i] ? BATcount(cursor->inserts[i]) : 0) != all ||
+			(i > 0 && stored != cursor->stored)) {
+			err = createException(MAL, "embedded.iterateTable", "Inconsistent column '%s'", col->base.name);
+			goto cleanup;
+		}
+		cursor->stored = stored;
+	}
+	if ((err = getSortedDeletes(m->session->tr, tableData, all, "embedded.iterateTable", &cursor->deleted, &cursor->ndeleted)) != MAL_SUCCEED)
+		goto cleanup;
+	cursor->count = all - cursor->ndeleted;
+	rows = cursor->count > (BUN) INT_MAX ? INT_MAX : (jint) cursor->count; /* the iteration counts its rows in an int */
+	(*env)->SetIntArrayRegion(env, numberOfRows, 0, 1, &rows);
+	(*env)->SetIntArrayRegion(env, typeIDs, 0, cursor->ncols, cursor->typeIDs);
+	/* the statements run while iterating join the cursor's transaction instead of ending it */
+	cursor->m = m;
+	cursor->autoCommit = m->session->auto_commit;
+	m->session->auto_commit = 0;
+
+cleanup:
+	if (jcolumns)
+		(*env)->ReleaseIntArrayElements(env, columns, jcolumns, JNI_ABORT);
+	if (tableColumns)
+		GDKfree(tableColumns);
+	if (err) {
+		endTableTransaction(m);
+		freeTableCursor(cursor);
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+		return 0;
+	}
+	return (jlong) cursor;
+}
+
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_fetchCursorBatchInternal
+	(JNIEnv *env, jobject monetDBTable, jlong cursorPointer, jint first, jint size, jobjectArray buffers) {
+	JTableCursor *cursor = (JTableCursor*) cursorPointer;
+	char *err = MAL_SUCCEED;
+	int i, contiguous = 1;
+	oid start = (oid) first;
+
+	(void) monetDBTable;
+	if (first < 0 || size < 0 || (BUN) first + (BUN) size > cursor->count) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), "The batch is out of the table bounds");
+		return;
+	}
+	if (size == 0)
+		return;
+	if (cursor->ndeleted) {
+		if ((BUN) size > cursor->capacity) {
+			oid *positions = GDKrealloc(cursor->positions, sizeof(oid) * size);
+			if (!positions) {
+				(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
+				return;
+			}
+			cursor->positions = positions;
+			cursor->capacity = (BUN) size;
+		}
+		contiguous = locateCursorBatch(cursor, (BUN) first, (BUN) size, &start);
+	}
+	for (i = 0; i < cursor->ncols && !err && (*env)->ExceptionCheck(env) == JNI_FALSE; i++) {
+		jobject next = (*env)->GetObjectArrayElement(env, buffers, i);
+		BAT *b;
+		BUN offset;
+
+		if ((err = getCursorColumnSlice(cursor, i, start, (BUN) size, contiguous, &b, &offset)) == MAL_SUCCEED)
+			getCursorColumnBatch(env, cursor->cols[i], cursor->typeIDs[i], next, (jint) offset, size, b);
+		(*env)->DeleteLocalRef(env, next);
+	}
+	if (err) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+	}
+}
+
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_closeCursorInternal
+	(JNIEnv *env, jobject monetDBTable, jlong cursorPointer) {
+	JTableCursor *cursor = (JTableCursor*) cursorPointer;
+	mvc *m;
+
+	(void) env;
+	(void) monetDBTable;
+	if (!cursor)
+		return;
+	m = cursor->m;
+	m->session->auto_commit = cursor->autoCommit;
+	freeTableCursor(cursor);
+	endTableTransaction(m);
+}
+
+/* The kinds of the scan predicates, the same as in the ScanSpec class */
+#define SCAN_RANGE        0
+#define SCAN_EQUALS       1
+#define SCAN_IN           2
+#define SCAN_IS_NULL      3
+#define SCAN_IS_NOT_NULL  4
+
+/* The range bound flags of the scan predicates */
+#define SCAN_LOW_INCLUSIVE   1
+#define SCAN_HIGH_INCLUSIVE  2
+
+/* Parses a predicate value into the column's type, while a null value stands for a missing range bound */
+static char* parseScanValue(JNIEnv *env, jstring input, int type, ptr *res) {
+	const char *value;
+	size_t len = 0;
+	char *err = MAL_SUCCEED;
+
+	*res = NULL;
+	if (!input)
+		return MAL_SUCCEED;
+	if (!(value = (*env)->GetStringUTFChars(env, input, NULL)))
+		return createException(MAL, "embedded.scan", MAL_MALLOC_FAIL);
+	if (type == TYPE_str) {
+		if (!(*res = GDKstrdup(value)))
+			err = createException(MAL, "embedded.scan", MAL_MALLOC_FAIL);
+	} else if (ATOMfromstr(type, res, &len, value) <= 0 || ATOMcmp(type, *res, ATOMnilptr(type)) == 0) {
+		err = createException(MAL, "embedded.scan", "Cannot convert '%s' to the column type", value);
+	}
+	(*env)->ReleaseStringUTFChars(env, input, value);
+	if (err && *res) {
+		GDKfree(*res);
+		*res = NULL;
+	}
+	return err;
+}
+
+/* Selects the candidates of a column matching a predicate */
+/* Selects the rows whose value is in a list with a single hash join against a BAT of the values, instead of one
+ * selection per value */
+static BAT* selectScanIn(BAT *b, BAT *cand, ptr *values, int nvalues) {
+	BAT *list, *r1 = NULL, *r2 = NULL, *sorted = NULL;
+	oid *p;
+	BUN j, n = 0;
+	int i;
+
+	if (!(list = COLnew(0, b->ttype, (BUN) nvalues, TRANSIENT)))
+		return NULL;
+	for (i = 0; i < nvalues; i++) {
+		if (BUNappend(list, values[i], false) != GDK_SUCCEED) {
+			BBPunfix(list->batCacheid);
+			return NULL;
+		}
+	}
+	if (BATjoin(&r1, &r2, b, list, cand, NULL, 0, (BUN) nvalues) != GDK_SUCCEED) {
+		BBPunfix(list->batCacheid);
+		return NULL;
+	}
+	BBPunfix(list->batCacheid);
+	BBPunfix(r2->batCacheid);
+	if (BATtdense(r1) || (r1->tsorted && r1->tkey))
+		return r1;
+	if (BATsort(&sorted, NULL, NULL, r1, NULL, NULL, 0, 0) != GDK_SUCCEED) {
+		BBPunfix(r1->batCacheid);
+		return NULL;
+	}
+	BBPunfix(r1->batCacheid);
+	/* a value listed more than once matches its rows again */
+	p = (oid *) Tloc(sorted, 0);
+	for (j = 0; j < BATcount(sorted); j++) {
+		if (n == 0 || p[n - 1] != p[j])
+			p[n++] = p[j];
+	}
+	BATsetcount(sorted, n);
+	sorted->tsorted = true;
+	sorted->trevsorted = n <= 1;
+	sorted->tkey = true;
+	sorted->tnonil = true;
+	sorted->tnil = false;
+	return sorted;
+}
+
+static BAT* selectScanPredicate(BAT *b, BAT *cand, jint kind, jbyte flags, ptr *values, int nvalues) {
+	BAT *res = NULL;
+
+	switch (kind) {
+		case SCAN_RANGE:
+			if (values[0] && values[1]) {
+				res = BATselect(b, cand, values[0], values[1], flags & SCAN_LOW_INCLUSIVE,
+								(flags & SCAN_HIGH_INCLUSIVE) != 0, 0);
+			} else if (values[0]) {
+				res = BATthetaselect(b, cand, values[0], (flags & SCAN_LOW_INCLUSIVE) ? ">=" : ">");
+			} else {
+				res = BATthetaselect(b, cand, values[1], (flags & SCAN_HIGH_INCLUSIVE) ? "<=" : "<");
+			}
+			break;
+		case SCAN_EQUALS:
+			res = BATselect(b, cand, values[0], NULL, 1, 1, 0);
+			break;
+		case SCAN_IN:
+			if (nvalues == 0)
+				return BATdense(0, 0, 0);
+			if (nvalues == 1) /* the null values are rejected by the Java side */
+				res = BATselect(b, cand, values[0], NULL, 1, 1, 0);
+			else
+				res = selectScanIn(b, cand, values, nvalues);
+			break;
+		case SCAN_IS_NULL:
+			res = BATselect(b, cand, ATOMnilptr(b->ttype), NULL, 1, 1, 0);
+			break;
+		case SCAN_IS_NOT_NULL:
+			res = BATselect(b, cand, ATOMnilptr(b->ttype), NULL, 1, 1, 1);
+			break;
+		default:
+			break;
+	}
+	return res;
+}
+
+/* Gets a candidate row id of a dense or materialized candidate list */
+static oid getCandidate(BAT *cand, BUN j) {
+	return BATtdense(cand) ? cand->tseqbase + j : ((const oid *) Tloc(cand, 0))[j];
+}
+
+/* Sets the count of a new candidate list filled in sorted order */
+static void setSortedCandidates(BAT *cand, BUN count) {
+	BATsetcount(cand, count);
+	cand->tsorted = true;
+	cand->trevsorted = count <= 1;
+	cand->tkey = true;
+	cand->tnonil = true;
+	cand->tnil = false;
+}
+
+/* Concatenates two sorted candidate lists, the second one starting after the first one ends, releasing both */
+static BAT* concatCandidates(BAT *first, BAT *second) {
+	BUN n1 = BATcount(first), n2 = BATcount(second), j;
+	BAT *res;
+	oid *p;
+
+	if (n2 == 0) {
+		BBPunfix(second->batCacheid);
+		return first;
+	}
+	if (n1 == 0) {
+		BBPunfix(first->batCacheid);
+		return second;
+	}
+	if ((res = COLnew(0, TYPE_oid, n1 + n2, TRANSIENT))) {
+		p = (oid *) Tloc(res, 0);
+		for (j = 0; j < n1; j++)
+			p[j] = getCandidate(first, j);
+		for (j = 0; j < n2; j++)
+			p[n1 + j] = getCandidate(second, j);
+		setSortedCandidates(res, n1 + n2);
+	}
+	BBPunfix(first->batCacheid);
+	BBPunfix(second->batCacheid);
+	return res;
+}
+
+/* Leaves the deleted rows out of a sorted candidate list by merging it with the sorted deletes, keeping the list as it
+ * is when none of its rows was deleted, so a dense range is materialized only when it crosses a deleted row */
+static char* removeDeletedRows(BAT **cand, const oid *deleted, BUN ndeleted, const char *call) {
+	BUN n = BATcount(*cand), j, k, count = 0;
+	oid first, next;
+	BAT *res;
+	oid *p;
+
+	if (n == 0 || ndeleted == 0)
+		return MAL_SUCCEED;
+	first = getCandidate(*cand, 0);
+	k = findRowId(deleted, ndeleted, first);
+	if (k == ndeleted || deleted[k] > getCandidate(*cand, n - 1))
+		return MAL_SUCCEED;
+	if (!(res = COLnew(0, TYPE_oid, n, TRANSIENT)))
+		return createException(MAL, call, MAL_MALLOC_FAIL);
+	p = (oid *) Tloc(res, 0);
+	for (j = 0; j < n; j++) {
+		next = getCandidate(*cand, j);
+		while (k < ndeleted && deleted[k] < next)
+			k++;
+		if (k == ndeleted || deleted[k] != next)
+			p[count++] = next;
+	}
+	setSortedCandidates(res, count);
+	BBPunfix((*cand)->batCacheid);
+	*cand = res;
+	return MAL_SUCCEED;
+}
+
+/* Selects the rows matching a predicate in the stored values of a column and in its inserts, which a view numbers
+ * after the stored rows */
+static BAT* selectVisiblePredicate(BAT *b, BAT *ins, BAT *cand, jint kind, jbyte flags, ptr *values, int nvalues) {
+	BAT *res, *view, *more;
+
+	if (!(res = selectScanPredicate(b, cand, kind, flags, values, nvalues)) || !ins)
+		return res;
+	if (!(view = VIEWcreate((oid) BATcount(b), ins))) {
+		BBPunfix(res->batCacheid);
+		return NULL;
+	}
+	more = selectScanPredicate(view, cand, kind, flags, values, nvalues);
+	BBPunfix(view->batCacheid);
+	if (!more) {
+		BBPunfix(res->batCacheid);
+		return NULL;
+	}
+	return concatCandidates(res, more);
+}
+
+/* Projects the candidate rows of a column from its stored values and from its inserts, splitting a sorted candidate
+ * list between both, or else gathering the rows one by one */
+static BAT* projectVisibleColumn(BAT *cand, BAT *b, BAT *ins) {
+	BUN n = BATcount(cand), j;
+	oid stored = (oid) BATcount(b);
+	BAT *res;
+
+	if (!ins)
+		return BATproject(cand, b);
+	if (!(res = COLnew(0, b->ttype, n, TRANSIENT)))
+		return NULL;
+	if (cand->tsorted) {
+		BUN split = SORTfndfirst(cand, &stored);
+		BAT *lower = BATslice(cand, 0, split), *upper = BATslice(cand, split, n), *view = VIEWcreate(stored, ins);
+		BAT *left = lower ? BATproject(lower, b) : NULL, *right = upper && view ? BATproject(upper, view) : NULL;
+
+		if (!left || !right || BATappend(res, left, NULL, false) != GDK_SUCCEED ||
+			BATappend(res, right, NULL, false) != GDK_SUCCEED) {
+			BBPunfix(res->batCacheid);
+			res = NULL;
+		}
+		if (lower)
+			BBPunfix(lower->batCacheid);
+		if (upper)
+			BBPunfix(upper->batCacheid);
+		if (view)
+			BBPunfix(view->batCacheid);
+		if (left)
+			BBPunfix(left->batCacheid);
+		if (right)
+			BBPunfix(right->batCacheid);
+	} else {
+		BATiter bi = bat_iterator(b), ii = bat_iterator(ins);
+		for (j = 0; j < n; j++) {
+			oid p = getCandidate(cand, j);
+			const void *value = p < stored ? BUNtail(bi, p) : BUNtail(ii, p - stored);
+			if (BUNappend(res, value, false) != GDK_SUCCEED) {
+				BBPunfix(res->batCacheid);
+				return NULL;
+			}
+		}
+	}
+	return res;
+}
+
+/* Projects columns of the candidate rows into a new query result set, binding the columns not bound yet */
+static char* projectCandidates(JNIEnv *env, jobject monetDBTable, sql_trans *tr, sql_table *table,
+							   sql_column **tableColumns, BAT **bound, BAT **inserts, int ncols, BAT *cand,
+							   jint *jprojection, int nprojected, const char *call, jobject *result) {
+	sql_column **projected = NULL;
+	BAT **results = NULL;
+	jint *typeIDs = NULL;
+	jintArray jtypeIDs;
+	jobject jconnection = NULL;
+	JResultSet *thisResultSet = NULL;
+	BUN count = BATcount(cand);
+	int i;
+	char *err = MAL_SUCCEED;
+
+	*result = NULL;
+	if (!(projected = GDKzalloc(sizeof(sql_column*) * (nprojected + 1))) ||
+		!(results = GDKzalloc(sizeof(BAT*) * (nprojected + 1))) ||
+		!(typeIDs = GDKmalloc(sizeof(jint) * (nprojected + 1)))) {
+		err = createException(MAL, call, MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	for (i = 0; i < nprojected; i++) {
+		jint next = jprojection[i];
+		if (next < 0 || next >= ncols) {
+			err = createException(MAL, call, "Column index %d out of bounds", (int) next + 1);
+			goto cleanup;
+		}
+		projected[i] = tableColumns[next];
+		if (!(typeIDs[i] = getColumnTypeID(projected[i]))) {
+			err = createException(MAL, call, "Unknown MonetDB type");
+			goto cleanup;
+		}
+		if (!bound[next] && (err = bindVisibleColumn(tr, table, tableColumns[next], call, &bound[next],
+													 &inserts[next])) != MAL_SUCCEED)
+			goto cleanup;
+		if (!(results[i] = projectVisibleColumn(cand, bound[next], inserts[next]))) {
+			err = createException(MAL, call, MAL_MALLOC_FAIL);
+			goto cleanup;
+		}
+	}
+
+	jconnection = (*env)->GetObjectField(env, monetDBTable, getGetConnectionID());
+	if ((err = createScanResultSet((monetdb_connection) (*env)->GetLongField(env, jconnection, getGetConnectionLongID()),
+								   &thisResultSet, table->base.name, projected, results, (size_t) nprojected,
+								   (size_t) count)) != MAL_SUCCEED)
+		goto cleanup;
+	if (!(jtypeIDs = (*env)->NewIntArray(env, (jsize) nprojected))) {
+		freeResultSet(thisResultSet);
+		err = createException(MAL, call, MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	(*env)->SetIntArrayRegion(env, jtypeIDs, 0, (jsize) nprojected, typeIDs);
+	//QueryResultSet(MonetDBEmbeddedConnection connection, long structPointer, int numberOfColumns, int numberOfRows, int[] typesIDs)
+	*result = (*env)->NewObject(env, getQueryResultSetID(), getQueryResultSetConstructorID(), jconnection,
+								(jlong) thisResultSet, (jint) nprojected, (jint) count, jtypeIDs);
+	(*env)->DeleteLocalRef(env, jtypeIDs);
+	if (!*result) {
+		freeResultSet(thisResultSet);
+		err = createException(MAL, call, MAL_MALLOC_FAIL);
+	}
+
+cleanup:
+	if (jconnection)
+		(*env)->DeleteLocalRef(env, jconnection);
+	if (results) {
+		for (i = 0; i < nprojected; i++) {
+			if (results[i])
+				BBPunfix(results[i]->batCacheid);
+		}
+		GDKfree(results);
+	}
+	if (projected)
+		GDKfree(projected);
+	if (typeIDs)
+		GDKfree(typeIDs);
+	return err;
+}
+
+static void throwEmbeddedException(JNIEnv *env, char *err) {
+	int i = 0, foundExc = 0;
+
+	while(err[i] && !foundExc) {
+		if(err[i] == '!')
+			foundExc = 1;
+		i++;
+	}
+	(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err + (foundExc ? i : 0));
+	freeException(err);
+}
+
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_scanInternal
+	(JNIEnv *env, jobject monetDBTable, jintArray projection, jintArray predicateColumns, jintArray predicateKinds,
+	 jbyteArray predicateFlags, jobjectArray predicateValues) {
+	sql_table *tableData;
+	sql_column **tableColumns = NULL;
+	BAT **bound = NULL, **inserts = NULL, *cand = NULL;
+	int ncols = 0, nprojected = 0, npredicates, i, j;
+	jint *jprojection = NULL, *jcolumns = NULL, *jkinds = NULL;
+	jbyte *jflags = NULL;
+	oid *deleted = NULL;
+	BUN all, ndeleted = 0;
+	mvc *m = NULL;
+	node *n;
+	jobject result = NULL;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err)
+		goto cleanup;
+	nprojected = (int) (*env)->GetArrayLength(env, projection);
+	npredicates = (int) (*env)->GetArrayLength(env, predicateColumns);
+	if (!(jprojection = (*env)->GetIntArrayElements(env, projection, NULL)) ||
+		!(jcolumns = (*env)->GetIntArrayElements(env, predicateColumns, NULL)) ||
+		!(jkinds = (*env)->GetIntArrayElements(env, predicateKinds, NULL)) ||
+		!(jflags = (*env)->GetByteArrayElements(env, predicateFlags, NULL)) ||
+		!(tableColumns = GDKzalloc(sizeof(sql_column*) * ncols)) || !(bound = GDKzalloc(sizeof(BAT*) * ncols)) ||
+		!(inserts = GDKzalloc(sizeof(BAT*) * ncols))) {
+		err = createException(MAL, "embedded.scan", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	for (n = tableData->columns.set->h; n; n = n->next) {
+		sql_column *col = n->data;
+		tableColumns[col->colnr] = col;
+	}
+
+	for (i = 0; i < npredicates; i++) {
+		jint next = jcolumns[i];
+		jobjectArray jvalues;
+		ptr *values = NULL;
+		int nvalues = 0;
+		BAT *selected = NULL;
+
+		if (next < 0 || next >= ncols) {
+			err = createException(MAL, "embedded.scan", "Column index %d out of bounds", (int) next + 1);
+			goto cleanup;
+		}
+		if (!bound[next] && (err = bindVisibleColumn(m->session->tr, tableData, tableColumns[next], "embedded.scan",
+													 &bound[next], &inserts[next])) != MAL_SUCCEED)
+			goto cleanup;
+		jvalues = (jobjectArray) (*env)->GetObjectArrayElement(env, predicateValues, i);
+		if (jvalues)
+			nvalues = (int) (*env)->GetArrayLength(env, jvalues);
+		if (!(values = GDKzalloc(sizeof(ptr) * (nvalues + 2)))) {
+			err = createException(MAL, "embedded.scan", MAL_MALLOC_FAIL);
+		} else {
+			for (j = 0; j < nvalues && !err; j++) {
+				jstring nextValue = (jstring) (*env)->GetObjectArrayElement(env, jvalues, j);
+				err = parseScanValue(env, nextValue, bound[next]->ttype, &values[j]);
+				if (nextValue)
+					(*env)->DeleteLocalRef(env, nextValue);
+			}
+			if (!err && !(selected = selectVisiblePredicate(bound[next], inserts[next], cand, jkinds[i], jflags[i],
+															values, nvalues)))
+				err = createException(MAL, "embedded.scan", "Cannot evaluate the predicate on column '%s'", tableColumns[next]->base.name);
+			for (j = 0; j < nvalues; j++) {
+				if (values[j])
+					GDKfree(values[j]);
+			}
+			GDKfree(values);
+		}
+		if (jvalues)
+			(*env)->DeleteLocalRef(env, jvalues);
+		if (err)
+			goto cleanup;
+		if (cand)
+			BBPunfix(cand->batCacheid);
+		cand = selected;
+	}
+
+	/* the deleted rows still hold their values, so they are left out once the predicates have narrowed the rows */
+	all = store_funcs.count_col(m->session->tr, tableColumns[0], 1);
+	if (!cand && !(cand = BATdense(0, 0, all))) {
+		err = createException(MAL, "embedded.scan", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	if ((err = getSortedDeletes(m->session->tr, tableData, all, "embedded.scan", &deleted, &ndeleted)) != MAL_SUCCEED ||
+		(err = removeDeletedRows(&cand, deleted, ndeleted, "embedded.scan")) != MAL_SUCCEED)
+		goto cleanup;
+
+	err = projectCandidates(env, monetDBTable, m->session->tr, tableData, tableColumns, bound, inserts, ncols, cand,
+							jprojection, nprojected, "embedded.scan", &result);
+
+cleanup:
+	endTableTransaction(m);
+	if (jprojection)
+		(*env)->ReleaseIntArrayElements(env, projection, jprojection, JNI_ABORT);
+	if (jcolumns)
+		(*env)->ReleaseIntArrayElements(env, predicateColumns, jcolumns, JNI_ABORT);
+	if (jkinds)
+		(*env)->ReleaseIntArrayElements(env, predicateKinds, jkinds, JNI_ABORT);
+	if (jflags)
+		(*env)->ReleaseByteArrayElements(env, predicateFlags, jflags, JNI_ABORT);
+	if (bound) {
+		for (i = 0; i < ncols; i++) {
+			if (bound[i])
+				BBPunfix(bound[i]->batCacheid);
+			if (inserts && inserts[i])
+				BBPunfix(inserts[i]->batCacheid);
+		}
+		GDKfree(bound);
+	}
+	if (inserts)
+		GDKfree(inserts);
+	if (cand)
+		BBPunfix(cand->batCacheid);
+	if (deleted)
+		GDKfree(deleted);
+	if (tableColumns)
+		GDKfree(tableColumns);
+	if (err) {
+		throwEmbeddedException(env, err);
+		return NULL;
+	}
+	return result;
+}
+
+/* Selects the rows of a column within a range, where a missing bound leaves the range open but still without nulls */
+static BAT* selectLookupRange(BAT *b, BAT *ins, ptr *values) {
+	if (values[0] || values[1])
+		return selectVisiblePredicate(b, ins, NULL, SCAN_RANGE, SCAN_LOW_INCLUSIVE | SCAN_HIGH_INCLUSIVE, values, 2);
+	return selectVisiblePredicate(b, ins, NULL, SCAN_IS_NOT_NULL, 0, values, 0);
+}
+
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_lookupRangeInternal
+	(JNIEnv *env, jobject monetDBTable, jint column, jstring low, jstring high, jintArray projection, jlongArray bounds,
+	 jobjectArray rowIds) {
+	sql_table *tableData;
+	sql_column **tableColumns = NULL;
+	BAT **bound = NULL, **inserts = NULL, *b, *ins, *cand = NULL;
+	int ncols = 0, nprojected = 0, i;
+	jint *jprojection = NULL;
+	jlong jbounds[2];
+	ptr values[2] = {NULL, NULL};
+	oid *deleted = NULL;
+	BUN all, ndeleted = 0;
+	mvc *m = NULL;
+	node *n;
+	jobject result = NULL;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err)
+		goto cleanup;
+	if (column < 0 || column >= ncols) {
+		err = createException(MAL, "embedded.lookupRange", "Column index %d out of bounds", (int) column + 1);
+		goto cleanup;
+	}
+	if (!(tableColumns = GDKzalloc(sizeof(sql_column*) * ncols)) || !(bound = GDKzalloc(sizeof(BAT*) * ncols)) ||
+		!(inserts = GDKzalloc(sizeof(BAT*) * ncols))) {
+		err = createException(MAL, "embedded.lookupRange", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	for (n = tableData->columns.set->h; n; n = n->next) {
+		sql_column *col = n->data;
+		tableColumns[col->colnr] = col;
+	}
+	if ((err = bindVisibleColumn(m->session->tr, tableData, tableColumns[column], "embedded.lookupRange",
+								 &bound[column], &inserts[column])) != MAL_SUCCEED)
+		goto cleanup;
+	b = bound[column];
+	ins = inserts[column];
+	if ((err = parseScanValue(env, low, b->ttype, &values[0])) != MAL_SUCCEED ||
+		(err = parseScanValue(env, high, b->ttype, &values[1])) != MAL_SUCCEED)
+		goto cleanup;
+
+	if (b->tsorted) {
+		/* the nulls sort first, so they are skipped by the lower bound */
+		BUN first = values[0] ? SORTfndfirst(b, values[0]) : SORTfndlast(b, ATOMnilptr(b->ttype));
+		BUN last = values[1] ? SORTfndlast(b, values[1]) : BATcount(b);
+
+		if (first > last)
+			first = last;
+		cand = BATdense(0, (oid) first, last - first);
+		if (cand && ins) {
+			/* the inserts are out of the stored order, so they are selected apart */
+			BAT *view = VIEWcreate((oid) BATcount(b), ins), *more = view ? selectLookupRange(view, NULL, values) : NULL;
+			if (view)
+				BBPunfix(view->batCacheid);
+			if (more) {
+				cand = concatCandidates(cand, more);
+			} else {
+				BBPunfix(cand->batCacheid);
+				cand = NULL;
+			}
+		}
+		if (!cand) {
+			err = createException(MAL, "embedded.lookupRange", MAL_MALLOC_FAIL);
+			goto cleanup;
+		}
+	} else if (!(cand = selectLookupRange(b, ins, values))) {
+		/* without binary search, GDK selects with the ordered index if the column has one */
+		err = createException(MAL, "embedded.lookupRange", "Cannot evaluate the range on column '%s'", tableColumns[column]->base.name);
+		goto cleanup;
+	}
+
+	/* only the matched rows are checked against the deletes, so the range is copied only when it crosses one */
+	all = store_funcs.count_col(m->session->tr, tableColumns[0], 1);
+	if ((err = getSortedDeletes(m->session->tr, tableData, all, "embedded.lookupRange", &deleted,
+								&ndeleted)) != MAL_SUCCEED ||
+		(err = removeDeletedRows(&cand, deleted, ndeleted, "embedded.lookupRange")) != MAL_SUCCEED)
+		goto cleanup;
+
+	/* a contiguous range of row ids is returned by its bounds only */
+	if (BATtdense(cand) || BATcount(cand) == 0) {
+		jbounds[0] = BATcount(cand) ? (jlong) cand->tseqbase : 0;
+		jbounds[1] = jbounds[0] + (jlong) BATcount(cand);
+	} else {
+		const oid *oids = (const oid *) Tloc(cand, 0);
+		jlongArray jrowIds;
+		jlong *elements;
+		BUN j, ncand = BATcount(cand);
+
+		if (!(jrowIds = (*env)->NewLongArray(env, (jsize) ncand)) ||
+			!(elements = (*env)->GetLongArrayElements(env, jrowIds, NULL))) {
+			err = createException(MAL, "embedded.lookupRange", MAL_MALLOC_FAIL);
+			goto cleanup;
+		}
+		for (j = 0; j < ncand; j++)
+			elements[j] = (jlong) oids[j];
+		(*env)->ReleaseLongArrayElements(env, jrowIds, elements, 0);
+		(*env)->SetObjectArrayElement(env, rowIds, 0, jrowIds);
+		(*env)->DeleteLocalRef(env, jrowIds);
+		jbounds[0] = (jlong) oids[0];
+		jbounds[1] = (jlong) oids[ncand - 1] + 1;
+	}
+	(*env)->SetLongArrayRegion(env, bounds, 0, 2, jbounds);
+
+	if (projection) {
+		nprojected = (int) (*env)->GetArrayLength(env, projection);
+		if (!(jprojection = (*env)->GetIntArrayElements(env, projection, NULL))) {
+			err = createException(MAL, "embedded.lookupRange", MAL_MALLOC_FAIL);
+			goto cleanup;
+		}
+		err = projectCandidates(env, monetDBTable, m->session->tr, tableData, tableColumns, bound, inserts, ncols, cand,
+								jprojection, nprojected, "embedded.lookupRange", &result);
+	}
+
+cleanup:
+	endTableTransaction(m);
+	if (jprojection)
+		(*env)->ReleaseIntArrayElements(env, projection, jprojection, JNI_ABORT);
+	for (i = 0; i < 2; i++) {
+		if (values[i])
+			GDKfree(values[i]);
+	}
+	if (bound) {
+		for (i = 0; i < ncols; i++) {
+			if (bound[i])
+				BBPunfix(bound[i]->batCacheid);
+			if (inserts && inserts[i])
+				BBPunfix(inserts[i]->batCacheid);
+		}
+		GDKfree(bound);
+	}
+	if (inserts)
+		GDKfree(inserts);
+	if (cand)
+		BBPunfix(cand->batCacheid);
+	if (deleted)
+		GDKfree(deleted);
+	if (tableColumns)
+		GDKfree(tableColumns);
+	if (err) {
+		throwEmbeddedException(env, err);
+		return NULL;
+	}
+	return result;
+}
+
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_lookupByKeyInternal
+	(JNIEnv *env, jobject monetDBTable, jint column, jobjectArray keys, jintArray projection, jobjectArray positions) {
+	sql_table *tableData;
+	sql_column **tableColumns = NULL;
+	BAT **bound = NULL, **inserts = NULL, *b, *ins, *rows = NULL, *matches = NULL;
+	int ncols = 0, nprojected = 0, nkeys, i;
+	jint *jprojection = NULL;
+	oid *deleted = NULL;
+	BUN all, ndeleted = 0, stored, hb, nrows;
+	BATiter bi, ii;
+	mvc *m = NULL;
+	node *n;
+	jlongArray jrowIds;
+	jintArray jkeyIndexes;
+	jobject result = NULL;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err)
+		goto cleanup;
+	if (column < 0 || column >= ncols) {
+		err = createException(MAL, "embedded.lookupByKey", "Column index %d out of bounds", (int) column + 1);
+		goto cleanup;
+	}
+	nkeys = (int) (*env)->GetArrayLength(env, keys);
+	if (!(tableColumns = GDKzalloc(sizeof(sql_column*) * ncols)) || !(bound = GDKzalloc(sizeof(BAT*) * ncols)) ||
+		!(inserts = GDKzalloc(sizeof(BAT*) * ncols)) ||
+		!(rows = COLnew(0, TYPE_oid, (BUN) nkeys, TRANSIENT)) || !(matches = COLnew(0, TYPE_int, (BUN) nkeys, TRANSIENT))) {
+		err = createException(MAL, "embedded.lookupByKey", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	for (n = tableData->columns.set->h; n; n = n->next) {
+		sql_column *col = n->data;
+		tableColumns[col->colnr] = col;
+	}
+	if ((err = bindVisibleColumn(m->session->tr, tableData, tableColumns[column], "embedded.lookupByKey",
+								 &bound[column], &inserts[column])) != MAL_SUCCEED)
+		goto cleanup;
+	b = bound[column];
+	ins = inserts[column];
+	all = store_funcs.count_col(m->session->tr, tableColumns[0], 1);
+	if ((err = getSortedDeletes(m->session->tr, tableData, all, "embedded.lookupByKey", &deleted,
+								&ndeleted)) != MAL_SUCCEED)
+		goto cleanup;
+	/* the hashes stay on the stored column and on the inserts, so the next lookups reuse them */
+	if (BAThash(b, 0) != GDK_SUCCEED || (ins && BAThash(ins, 0) != GDK_SUCCEED)) {
+		err = createException(MAL, "embedded.lookupByKey", "Cannot build the hash of column '%s'", tableColumns[column]->base.name);
+		goto cleanup;
+	}
+
+	stored = BATcount(b);
+	bi = bat_iterator(b);
+	ii = ins ? bat_iterator(ins) : bi;
+	for (i = 0; i < nkeys && !err; i++) {
+		jstring nextKey = (jstring) (*env)->GetObjectArrayElement(env, keys, i);
+		ptr value = NULL;
+		BUN start = BATcount(rows), j;
+
+		if ((err = parseScanValue(env, nextKey, b->ttype, &value)) == MAL_SUCCEED && value) {
+			HASHloop(bi, b->thash, hb, value) {
+				oid row = (oid) hb;
+				if (isDeletedRow(deleted, ndeleted, row))
+					continue;
+				if (BUNappend(rows, &row, false) != GDK_SUCCEED) {
+					err = createException(MAL, "embedded.lookupByKey", MAL_MALLOC_FAIL);
+					break;
+				}
+			}
+			/* the inserts are numbered after the stored rows */
+			if (ins && !err) {
+				HASHloop(ii, ins->thash, hb, value) {
+					oid row = (oid) (stored + hb);
+					if (isDeletedRow(deleted, ndeleted, row))
+						continue;
+					if (BUNappend(rows, &row, false) != GDK_SUCCEED) {
+						err = createException(MAL, "embedded.lookupByKey", MAL_MALLOC_FAIL);
+						break;
+					}
+				}
+			}
+			/* the hash chains are walked from the last row inserted */
+			qsort(Tloc(rows, start), BATcount(rows) - start, sizeof(oid), compareRowIds);
+			for (j = start; j < BATcount(rows) && !err; j++) {
+				if (BUNappend(matches, &i, false) != GDK_SUCCEED)
+					err = createException(MAL, "embedded.lookupByKey", MAL_MALLOC_FAIL);
+			}
+		}
+		if (value)
+			GDKfree(value);
+		if (nextKey)
+			(*env)->DeleteLocalRef(env, nextKey);
+	}
+	if (err)
+		goto cleanup;
+	rows->tsorted = rows->trevsorted = false;
+	rows->tkey = false;
+
+	nrows = BATcount(rows);
+	if (!(jrowIds = (*env)->NewLongArray(env, (jsize) nrows)) ||
+		!(jkeyIndexes = (*env)->NewIntArray(env, (jsize) nrows))) {
+		err = createException(MAL, "embedded.lookupByKey", MAL_MALLOC_FAIL);
+		goto cleanup;
+	}
+	if (nrows) {
+		const oid *oids = (const oid *) Tloc(rows, 0);
+		jlong *elements = (*env)->GetLongArrayElements(env, jrowIds, NULL);
+		if (!elements) {
+			err = createException(MAL, "embedded.lookupByKey", MAL_MALLOC_FAIL);
+			goto cleanup;
+		}
+		for (hb = 0; hb < nrows; hb++)
+			elements[hb] = (jlong) oids[hb];
+		(*env)->ReleaseLongArrayElements(env, jrowIds, elements, 0);
+		(*env)->SetIntArrayRegion(env, jkeyIndexes, 0, (jsize) nrows, (const jint *) Tloc(matches, 0));
+	}
+	(*env)->SetObjectArrayElement(env, positions, 0, jrowIds);
+	(*env)->SetObjectArrayElement(env, positions, 1, jkeyIndexes);
+	(*env)->DeleteLocalRef(env, jrowIds);
+	(*env)->DeleteLocalRef(env, jkeyIndexes);
+
+	if (projection) {
+		nprojected = (int) (*env)->GetArrayLength(env, projection);
+		if (!(jprojection = (*env)->GetIntArrayElements(env, projection, NULL))) {
+			err = createException(MAL, "embedded.lookupByKey", MAL_MALLOC_FAIL);
+			goto cleanup;
+		}
+		err = projectCandidates(env, monetDBTable, m->session->tr, tableData, tableColumns, bound, inserts, ncols, rows,
+								jprojection, nprojected, "embedded.lookupByKey", &result);
+	}
+
+cleanup:
+	endTableTransaction(m);
+	if (jprojection)
+		(*env)->ReleaseIntArrayElements(env, projection, jprojection, JNI_ABORT);
+	if (bound) {
+		for (i = 0; i < ncols; i++) {
+			if (bound[i])
+				BBPunfix(bound[i]->batCacheid);
+			if (inserts && inserts[i])
+				BBPunfix(inserts[i]->batCacheid);
+		}
+		GDKfree(bound);
+	}
+	if (inserts)
+		GDKfree(inserts);
+	if (rows)
+		BBPunfix(rows->batCacheid);
+	if (matches)
+		BBPunfix(matches->batCacheid);
+	if (deleted)
+		GDKfree(deleted);
+	if (tableColumns)
+		GDKfree(tableColumns);
+	if (err) {
+		throwEmbeddedException(env, err);
+		return NULL;
+	}
+	return result;
+}
+
+/* The index types, the same as in the MonetDBTableIndex class */
+#define INDEX_HASH      0
+#define INDEX_JOIN      1
+#define INDEX_ORDERED   2
+#define INDEX_IMPRINTS  3
+#define INDEX_OTHER     4
+
+static jint getIndexType(sql_idx *idx) {
+	switch (idx->type) {
+		case hash_idx:
+			return INDEX_HASH;
+		case join_idx:
+			return INDEX_JOIN;
+		case ordered_idx:
+			return INDEX_ORDERED;
+		case imprints_idx:
+			return INDEX_IMPRINTS;
+		default:
+			return INDEX_OTHER;
+	}
+}
+
+/* Tells if the GDK structure of an ordered or imprints index is built on the stored column */
+static jboolean isIndexBuilt(sql_trans *tr, sql_idx *idx) {
+	sql_kc *kc;
+	BAT *b;
+	jboolean res = JNI_FALSE;
+
+	if ((idx->type != ordered_idx && idx->type != imprints_idx) || !idx->columns || !idx->columns->h)
+		return JNI_FALSE;
+	kc = idx->columns->h->data;
+	if (!(b = store_funcs.bind_col(tr, kc->c, RDONLY)))
+		return JNI_FALSE;
+	if (idx->type == ordered_idx) {
+		res = BATcheckorderidx(b) ? JNI_TRUE : JNI_FALSE;
+	} else {
+		res = IMPSimprintsize(b) > 0 ? JNI_TRUE : JNI_FALSE;
+	}
+	BBPunfix(b->batCacheid);
+	return res;
+}
+
+JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getNumberOfIndexesInternal
+	(JNIEnv *env, jobject monetDBTable) {
+	sql_table *tableData;
+	int ncols;
+	mvc *m = NULL;
+	jint res = 0;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (!err && tableData->idxs.set)
+		res = (jint) list_length(tableData->idxs.set);
+	endTableTransaction(m);
+	if (err) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+		return 0;
+	}
+	return res;
+}
+
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getIndexesInternal
+	(JNIEnv *env, jobject monetDBTable, jobjectArray names, jintArray types, jbooleanArray built, jobjectArray columns) {
+	sql_table *tableData;
+	int ncols;
+	jint i = 0, length = (*env)->GetArrayLength(env, names);
+	mvc *m = NULL;
+	node *n, *k;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err) {
+		endTableTransaction(m);
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+		return;
+	}
+	for (n = tableData->idxs.set ? tableData->idxs.set->h : NULL; n && i < length; n = n->next, i++) {
+		sql_idx *idx = n->data;
+		jint type = getIndexType(idx);
+		jboolean isBuilt = isIndexBuilt(m->session->tr, idx);
+		jint ncolumns = idx->columns ? (jint) list_length(idx->columns) : 0, j = 0;
+		jstring name = (*env)->NewStringUTF(env, idx->base.name);
+		jobjectArray idxColumns = (*env)->NewObjectArray(env, ncolumns, getStringClassID(), NULL);
+
+		if (!name || !idxColumns) {
+			(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
+			break;
+		}
+		for (k = idx->columns ? idx->columns->h : NULL; k; k = k->next, j++) {
+			sql_kc *kc = k->data;
+			jstring next = (*env)->NewStringUTF(env, kc->c->base.name);
+			if (!next) {
+				(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), MAL_MALLOC_FAIL);
+				break;
+			}
+			(*env)->SetObjectArrayElement(env, idxColumns, j, next);
+			(*env)->DeleteLocalRef(env, next);
+		}
+		(*env)->SetObjectArrayElement(env, names, i, name);
+		(*env)->SetObjectArrayElement(env, columns, i, idxColumns);
+		(*env)->SetIntArrayRegion(env, types, i, 1, &type);
+		(*env)->SetBooleanArrayRegion(env, built, i, 1, &isBuilt);
+		(*env)->DeleteLocalRef(env, name);
+		(*env)->DeleteLocalRef(env, idxColumns);
+		if ((*env)->ExceptionCheck(env) == JNI_TRUE)
+			break;
+	}
+	endTableTransaction(m);
+}
+
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_buildIndexInternal
+	(JNIEnv *env, jobject monetDBTable, jint column, jint type) {
+	sql_table *tableData;
+	sql_column *col = NULL;
+	int ncols;
+	mvc *m = NULL;
+	node *n;
+	BAT *b = NULL;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err)
+		goto cleanup;
+	for (n = tableData->columns.set->h; n; n = n->next) {
+		sql_column *next = n->data;
+		if (next->colnr == column)
+			col = next;
+	}
+	if (!col) {
+		err = createException(MAL, "embedded.createIndex", "Column index %d out of bounds", (int) column + 1);
+		goto cleanup;
+	}
+	if (!(b = store_funcs.bind_col(m->session->tr, col, RDONLY))) {
+		err = createException(SQL, "embedded.createIndex", "Cannot access column '%s'", col->base.name);
+		goto cleanup;
+	}
+	if (type == INDEX_ORDERED) {
+		if (!BATcheckorderidx(b) && BATorderidx(b, 1) != GDK_SUCCEED)
+			err = createException(MAL, "embedded.createIndex", "Cannot build the ordered index of column '%s'", col->base.name);
+	} else if (type == INDEX_IMPRINTS) {
+		if (BATimprints(b) != GDK_SUCCEED)
+			err = createException(MAL, "embedded.createIndex", "Cannot build the imprints of column '%s'", col->base.name);
+	}
+
+cleanup:
+	if (b)
+		BBPunfix(b->batCacheid);
+	endTableTransaction(m);
+	if (err) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+	}
+}
+
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_destroyIndexInternal
+	(JNIEnv *env, jobject monetDBTable, jstring indexName) {
+	sql_table *tableData;
+	int ncols;
+	mvc *m = NULL;
+	node *n;
+	const char *name = NULL;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (!err && !(name = (*env)->GetStringUTFChars(env, indexName, NULL)))
+		err = createException(MAL, "embedded.dropIndex", MAL_MALLOC_FAIL);
+	for (n = (!err && tableData->idxs.set) ? tableData->idxs.set->h : NULL; n; n = n->next) {
+		sql_idx *idx = n->data;
+		sql_kc *kc;
+		BAT *b;
+
+		if (strcmp(idx->base.name, name) != 0 || (idx->type != ordered_idx && idx->type != imprints_idx) ||
+			!idx->columns || !idx->columns->h)
+			continue;
+		kc = idx->columns->h->data;
+		if ((b = store_funcs.bind_col(m->session->tr, kc->c, RDONLY))) {
+			if (idx->type == ordered_idx) {
+				OIDXdestroy(b);
+			} else {
+				IMPSdestroy(b);
+			}
+			BBPunfix(b->batCacheid);
+		}
+		break;
+	}
+	if (name)
+		(*env)->ReleaseStringUTFChars(env, indexName, name);
+	endTableTransaction(m);
+	if (err) {
+		(*env)->ThrowNew(env, getMonetDBEmbeddedExceptionClassID(), err);
+		freeException(err);
+	}
+}
+
+/* A row id to update and the position of its new value */
+typedef struct {
+	oid row;
+	oid position;
+} JRowUpdate;
+
+static int compareRowUpdates(const void *a, const void *b) {
+	const JRowUpdate *x = (const JRowUpdate *) a, *y = (const JRowUpdate *) b;
+	if (x->row != y->row)
+		return x->row < y->row ? -1 : 1;
+	return x->position < y->position ? -1 : x->position > y->position;
+}
+
+/* Sorts the row ids to update together with their new values, as the storage layer expects, keeping only the last
+ * value of a row id given more than once */
+static char* sortRowUpdates(BAT *tids, BAT **values) {
+	BUN n = BATcount(tids), j, k = 0;
+	oid *rows = (oid *) Tloc(tids, 0), *positions;
+	JRowUpdate *updates;
+	BAT *order, *sorted;
+
+	if (!(updates = GDKmalloc(sizeof(JRowUpdate) * (n + 1))))
+		return createException(MAL, "embedded.updateColumn", MAL_MALLOC_FAIL);
+	if (!(order = COLnew(0, TYPE_oid, n, TRANSIENT))) {
+		GDKfree(updates);
+		return createException(MAL, "embedded.updateColumn", MAL_MALLOC_FAIL);
+	}
+	for (j = 0; j < n; j++) {
+		updates[j].row = rows[j];
+		updates[j].position = (*values)->hseqbase + j;
+	}
+	qsort(updates, n, sizeof(JRowUpdate), compareRowUpdates);
+	positions = (oid *) Tloc(order, 0);
+	for (j = 0; j < n; j++) {
+		if (j + 1 < n && updates[j + 1].row == updates[j].row)
+			continue;
+		rows[k] = updates[j].row;
+		positions[k++] = updates[j].position;
+	}
+	GDKfree(updates);
+	BATsetcount(tids, k);
+	tids->tsorted = true;
+	tids->trevsorted = k <= 1;
+	tids->tkey = true;
+	BATsetcount(order, k);
+	order->tsorted = true;
+	order->trevsorted = k <= 1;
+	order->tkey = true;
+	order->tnonil = true;
+	order->tnil = false;
+	sorted = BATproject(order, *values);
+	BBPunfix(order->batCacheid);
+	if (!sorted)
+		return createException(MAL, "embedded.updateColumn", MAL_MALLOC_FAIL);
+	BBPunfix((*values)->batCacheid);
+	*values = sorted;
+	return MAL_SUCCEED;
+}
+
+/* Tells if a row id is stored in the table and was not deleted */
+static int isVisibleRow(jlong row, const oid *deleted, BUN ndeleted, BUN all) {
+	return row >= 0 && (BUN) row < all && !isDeletedRow(deleted, ndeleted, (oid) row);
+}
+
+/* Creates the BAT of the row ids to modify, checking each one against the sorted deletes */
+static char* createRowIdsBAT(JNIEnv *env, const char *call, jlongArray rowIds, const oid *deleted, BUN ndeleted,
+							 BUN all, BAT **res) {
+	jsize nrows = (*env)->GetArrayLength(env, rowIds), j;
+	jlong *jrows;
+	oid *tids;
+	char *err = MAL_SUCCEED;
+
+	if (!(*res = COLnew(0, TYPE_oid, (BUN) nrows, TRANSIENT)) ||
+		!(jrows = (*env)->GetLongArrayElements(env, rowIds, NULL))) {
+		if (*res) {
+			BBPunfix((*res)->batCacheid);
+			*res = NULL;
+		}
+		return createException(MAL, call, MAL_MALLOC_FAIL);
+	}
+	tids = (oid *) Tloc(*res, 0);
+	for (j = 0; j < nrows && !err; j++) {
+		if (!isVisibleRow(jrows[j], deleted, ndeleted, all))
+			err = createException(MAL, call, "The row id " LLFMT " is not in the table or was deleted", (lng) jrows[j]);
+		tids[j] = (oid) jrows[j];
+	}
+	(*env)->ReleaseLongArrayElements(env, rowIds, jrows, JNI_ABORT);
+	if (err) {
+		BBPunfix((*res)->batCacheid);
+		*res = NULL;
+		return err;
+	}
+	BATsetcount(*res, (BUN) nrows);
+	(*res)->tsorted = (*res)->trevsorted = false;
+	(*res)->tkey = false;
+	(*res)->tnonil = true;
+	(*res)->tnil = false;
+	return MAL_SUCCEED;
+}
+
+/* Marks the transaction to be rolled back instead of committed, once the storage layer may have applied a change
+ * partially. Only the failed call is rolled back in auto-commit mode, while a transaction started by the user is
+ * doomed as a failed statement does, since the change cannot be undone alone */
+static void abortTableTransaction(mvc *m) {
+	if (m)
+		m->session->status = -1;
+}
+
+JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_deleteRowsInternal
+	(JNIEnv *env, jobject monetDBTable, jlongArray rowIds) {
+	sql_table *tableData;
+	int ncols = 0;
+	BAT *tids = NULL;
+	oid *dels = NULL;
+	BUN all, ndels = 0, deleted = 0;
+	mvc *m = NULL;
+	node *n;
+	char *err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m);
+
+	if (err)
+		goto cleanup;
+	/* the rows of a key referenced by foreign keys cannot be deleted without checking the references */
+	for (n = tableData->keys.set ? tableData->keys.set->h : NULL; n; n = n->next) {
+		sql_key *k = n->data;
+		if ((k->type == pkey || k->type == ukey) && ((sql_ukey *) k)->keys && list_length(((sql_ukey *) k)->keys) > 0) {
+			err = createException(MAL, "embedded.deleteRows", "The table %s is referenced by foreign keys", tableData->base.name);
+			goto cleanup;
+		}
+	}
+	all = store_funcs.count_col(m->session->tr, tableData->columns.set->h->data, 1);
+	if ((err = getSortedDeletes(m->session->tr, tableData, all, "embedded.deleteRows", &dels, &ndels)) != MAL_SUCCEED ||
+		(err = createRowIdsBAT(env, "embedded.deleteRows", rowIds, dels, ndels, all, &tids)) != MAL_SUCCEED)
+		goto cleanup;
+	/* a row given more than once must be deleted only once */
+	if (BATcount(tids) > 0) {
+		oid *p = (oid *) Tloc(tids, 0);
+		BUN j;
+		qsort(p, BATcount(tids), sizeof(oid), compareRowIds);
+		for (j = 1; j < BATcount(tids); j++) {
+			if (p[j] != p[deleted])
+				p[++deleted] = p[j];
+		}
+		BATsetcount(tids, ++deleted);
+		tids->tsorted = true;
+		tids->tkey = true;
+		if (store_funcs.delete_tab(m->session->tr, tableData, tids, TYPE_bat) != LOG_OK) {
+			err = createException(MAL, "embedded.deleteRows", "Cannot delete the rows of %s", tableData->base.name);
+			abortTableTransaction(m);
+		}
+	}
+
+cleanup:
+	endTableTransaction(m);
+	if (tids)
+		BBPunfix(tids->batCacheid);
+	if (dels)
+		GDKfree(dels);
+	if (err) {
+		throwEmbeddedException(env, err);
+		return -1;
+	}
+	return (jint) deleted;
+}
+
+JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_updateColumnInternal
+	(JNIEnv *env, jobject monetDBTable, jint column, jlongArray rowIds, jobject values, jint roundingMode) {
+	JTableDescriptor *desc;
+	jlong connectionPointer;
+	sql_table *tableData;
+	sql_column *col = NULL;
+	int ncols = 0;
+	jsize nrows;
+	BAT *tids = NULL, *upd = NULL;
+	oid *deleted = NULL;
+	BUN all, ndeleted = 0;
+	mvc *m = NULL;
+	node *n, *o;
+	char *err;
+
+	/* the descriptor converts the Java values as an append does */
+	if ((err = getTableDescriptor(env, monetDBTable, &desc, &connectionPointer)) != MAL_SUCCEED ||
+		(err = loadTableTransaction(env, monetDBTable, &tableData, &ncols, &m)) != MAL_SUCCEED)
+		goto cleanup;
+	if (column < 0 || column >= ncols) {
+		err = createException(MAL, "embedded.updateColumn", "Column index %d out of bounds", (int) column + 1);
+		goto cleanup;
+	}
+	for (n = tableData->columns.set->h; n; n = n->next) {
+		sql_column *next = n->data;
+		if (next->colnr == column)
+			col = next;
+	}
+	/* the keys are kept by indexes updated with the SQL plans, so their columns are left to UPDATE statements */
+	for (n = tableData->keys.set ? tableData->keys.set->h : NULL; n; n = n->next) {
+		sql_key *k = n->data;
+		for (o = k->columns ? k->columns->h : NULL; o; o = o->next) {
+			if (((sql_kc *) o->data)->c == col) {
+				err = createException(MAL, "embedded.updateColumn", "The column %s is part of the key %s", col->base.name, k->base.name);
+				goto cleanup;
+			}
+		}
+	}
+	nrows = (*env)->GetArrayLength(env, rowIds);
+	if ((*env)->GetArrayLength(env, (jarray) values) != nrows) {
+		err = createException(MAL, "embedded.updateColumn", "The number of row ids and values is not consistent");
+		goto cleanup;
+	}
+	all = store_funcs.count_col(m->session->tr, col, 1);
+	if ((err = getSortedDeletes(m->session->tr, tableData, all, "embedded.updateColumn", &deleted,
+								&ndeleted)) != MAL_SUCCEED ||
+		(err = createRowIdsBAT(env, "embedded.updateColumn", rowIds, deleted, ndeleted, all, &tids)) != MAL_SUCCEED ||
+		(err = storeJavaColumn(env, desc, (int) column, values, nrows, NULL, roundingMode, &upd)) != MAL_SUCCEED)
+		goto cleanup;
+	if (!upd) /* the conversion has already thrown */
+		goto cleanup;
+	if (!col->null && BATcount_no_nil(upd) != BATcount(upd)) {
+		err = createException(MAL, "embedded.updateColumn", "The column %s cannot have null values", col->base.name);
+		goto cleanup;
+	}
+	if ((err = sortRowUpdates(tids, &upd)) != MAL_SUCCEED)
+		goto cleanup;
+	nrows = (jsize) BATcount(tids);
+	if (nrows > 0 && store_funcs.update_col(m->session->tr, col, tids, upd, TYPE_bat) != LOG_OK) {
+		err = createException(MAL, "embedded.updateColumn", "Cannot update the column %s", col->base.name);
+		abortTableTransaction(m);
+	}
+
+cleanup:
+	endTableTransaction(m);
+	if (tids)
+		BBPunfix(tids->batCacheid);
+	if (upd)
+		BBPunfix(upd->batCacheid);
+	if (deleted)
+		GDKfree(deleted);
+	if (err) {
+		throwEmbeddedException(env, err);
+		return -1;
+	} else if ((*env)->ExceptionCheck(env) == JNI_TRUE) {
+		return -1;
+	}
+	return (jint) nrows;
+}
@@ -103,6 +103,126 @@ JNIEXPORT jobjectArray JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_
 JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_appendColumnsInternal
   (JNIEnv *, jobject, jobjectArray, jintArray, jint);
 
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    freeTableDescriptorInternal
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_freeTableDescriptorInternal
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    getNumberOfRowsInternal
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getNumberOfRowsInternal
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    getTableStatisticsInternal
+ * Signature: ([J[J[J[B[Ljava/lang/String;[Ljava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getTableStatisticsInternal
+  (JNIEnv *, jobject, jlongArray, jlongArray, jlongArray, jbyteArray, jobjectArray, jobjectArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    openCursorInternal
+ * Signature: ([I[I[I)J
+ */
+JNIEXPORT jlong JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_openCursorInternal
+  (JNIEnv *, jobject, jintArray, jintArray, jintArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    fetchCursorBatchInternal
+ * Signature: (JII[Ljava/lang/Object;)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_fetchCursorBatchInternal
+  (JNIEnv *, jobject, jlong, jint, jint, jobjectArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    closeCursorInternal
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_closeCursorInternal
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    scanInternal
+ * Signature: ([I[I[I[B[Ljava/lang/Object;)Lnl/cwi/monetdb/embedded/resultset/QueryResultSet;
+ */
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_scanInternal
+  (JNIEnv *, jobject, jintArray, jintArray, jintArray, jbyteArray, jobjectArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    lookupRangeInternal
+ * Signature: (ILjava/lang/String;Ljava/lang/String;[I[J[[J)Lnl/cwi/monetdb/embedded/resultset/QueryResultSet;
+ */
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_lookupRangeInternal
+  (JNIEnv *, jobject, jint, jstring, jstring, jintArray, jlongArray, jobjectArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    lookupByKeyInternal
+ * Signature: (I[Ljava/lang/String;[I[Ljava/lang/Object;)Lnl/cwi/monetdb/embedded/resultset/QueryResultSet;
+ */
+JNIEXPORT jobject JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_lookupByKeyInternal
+  (JNIEnv *, jobject, jint, jobjectArray, jintArray, jobjectArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    getNumberOfIndexesInternal
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getNumberOfIndexesInternal
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    getIndexesInternal
+ * Signature: ([Ljava/lang/String;[I[Z[[Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_getIndexesInternal
+  (JNIEnv *, jobject, jobjectArray, jintArray, jbooleanArray, jobjectArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    buildIndexInternal
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_buildIndexInternal
+  (JNIEnv *, jobject, jint, jint);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    destroyIndexInternal
+ * Signature: (Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_destroyIndexInternal
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    deleteRowsInternal
+ * Signature: ([J)I
+ */
+JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_deleteRowsInternal
+  (JNIEnv *, jobject, jlongArray);
+
+/*
+ * Class:     nl_cwi_monetdb_embedded_tables_MonetDBTable
+ * Method:    updateColumnInternal
+ * Signature: (I[JLjava/lang/Object;I)I
+ */
+JNIEXPORT jint JNICALL Java_nl_cwi_monetdb_embedded_tables_MonetDBTable_updateColumnInternal
+  (JNIEnv *, jobject, jint, jlongArray, jobject, jint);
+
 #ifdef __cplusplus
 }
 #endif